@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <memory>
+#include <algorithm>
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_events.h>
@@ -17,16 +18,73 @@ class CompositeScreenObject : protected ScreenObject {
 
 protected:
     std::vector<std::unique_ptr<ScreenObject>> objs;
+    SDL_FRect bounds = {0, 0, 0, 0}; // cached union of the bounds of the polygon and the children
+
+    void helperOnChildGeometryChanged() override {
+        helperNotifyGeometryChanged();
+    }
+    void helperUpdateBounds() override {
+        bounds = polygon->getBoundingBox();
+        for (const auto& obj : objs) {
+            const SDL_FRect& b = obj->getBoundingBox();
+            float max_x = std::max(bounds.x + bounds.w, b.x + b.w);
+            float max_y = std::max(bounds.y + bounds.h, b.y + b.h);
+            bounds.x = std::min(bounds.x, b.x);
+            bounds.y = std::min(bounds.y, b.y);
+            bounds.w = max_x - bounds.x;
+            bounds.h = max_y - bounds.y;
+        }
+    }
 public:
     CompositeScreenObject(SDL_Window* w, SDL_Renderer* r)
         try: ScreenObject(w, r) {
-            
+            helperUpdateBounds();
+            draw_func = [this]() {
+                this->polygon->draw();
+                for (const auto& obj : this->objs) {
+                    obj->render();
+                }
+            };
         } catch (std::exception& e) {
             logAndThrow<Logger::SeeAbove>(
                 "CompositeScreenObject /* constructor */", e.what()
             );
     }
-    
+
+    // takes ownership of child, which is drawn on top of the previous children
+    ScreenObject* addChild(std::unique_ptr<ScreenObject> child) {
+        if (!child) {
+            logAndThrow<std::invalid_argument>("addChild", "child is null");
+        }
+        if (child->parent || child->damage_tracker) {
+            logAndThrow<std::logic_error>("addChild", "child is already part of a scene");
+        }
+        child->parent = this;
+        objs.push_back(std::move(child));
+        helperNotifyGeometryChanged();
+        return objs.back().get();
+    }
+
+    const SDL_FRect& getBoundingBox() const override { return bounds; }
+
+    void submit(RenderQueue& queue) const override {
+        if (!is_visible) {
+            return;
+        }
+        polygon->enqueue(queue, layer);
+        for (const auto& obj : objs) {
+            obj->submit(queue);
+        }
+    }
+
+    void clearDirty() override {
+        for (const auto& obj : objs) {
+            if (obj->isDirty()) {
+                obj->clearDirty();
+            }
+        }
+        ScreenObject::clearDirty();
+    }
 
 
 private:
@@ -0,0 +1,84 @@
+#include "DamageTracker.hpp"
+
+#include <algorithm>
+
+#include "ScreenObject.hpp"
+
+namespace Display {
+
+void DamageTracker::addDirty(ScreenObject* obj) {
+    if (obj == nullptr) {
+        logAndThrow<std::invalid_argument>("addDirty(ScreenObject* obj)", "obj is null");
+    }
+    dirty_objs.push_back(obj);
+}
+
+void DamageTracker::forget(const ScreenObject* obj) {
+    dirty_objs.erase(std::remove(dirty_objs.begin(), dirty_objs.end(), obj), dirty_objs.end());
+    if (obj->hasBeenDrawn()) {
+        addRect(obj->getDrawnBounds());
+    }
+}
+
+void DamageTracker::addRect(const ::SDL_FRect& rect) {
+    if (rect.w < 0 || rect.h < 0) {
+        return;
+    }
+    ::SDL_FRect merged = {
+        rect.x - padding, rect.y - padding,
+        rect.w + 2 * padding, rect.h + 2 * padding
+    };
+    // merging can make the result overlap rects it did not overlap before, so repeat until stable
+    bool is_merged = true;
+    while (is_merged) {
+        is_merged = false;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            if (helperIntersects(rects[i], merged)) {
+                merged = helperUnion(rects[i], merged);
+                rects[i] = rects.back();
+                rects.pop_back();
+                is_merged = true;
+                break;
+            }
+        }
+    }
+    rects.push_back(merged);
+
+    if (rects.size() > max_num_of_rects) {
+        ::SDL_FRect total = rects.front();
+        for (const ::SDL_FRect& r : rects) {
+            total = helperUnion(total, r);
+        }
+        rects.assign(1, total);
+    }
+}
+
+void DamageTracker::collect() {
+    for (ScreenObject* obj : dirty_objs) {
+        if (obj->hasBeenDrawn()) {
+            addRect(obj->getDrawnBounds()); // erase the old image
+        }
+        if (obj->getVisibility()) {
+            addRect(obj->getBoundingBox());
+        }
+        obj->clearDirty();
+    }
+    dirty_objs.clear();
+}
+
+// private
+
+bool DamageTracker::helperIntersects(const ::SDL_FRect& a, const ::SDL_FRect& b) noexcept {
+    return a.x <= b.x + b.w && b.x <= a.x + a.w
+        && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+::SDL_FRect DamageTracker::helperUnion(const ::SDL_FRect& a, const ::SDL_FRect& b) noexcept {
+    float min_x = std::min(a.x, b.x);
+    float min_y = std::min(a.y, b.y);
+    float max_x = std::max(a.x + a.w, b.x + b.w);
+    float max_y = std::max(a.y + a.h, b.y + b.h);
+    return ::SDL_FRect{min_x, min_y, max_x - min_x, max_y - min_y};
+}
+
+} // namespace Display
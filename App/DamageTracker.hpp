@@ -0,0 +1,65 @@
+#ifndef DAMAGE_TRACKER_HPP
+#define DAMAGE_TRACKER_HPP
+
+
+#include <SDL3/SDL.h>
+
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace Display {
+
+class ScreenObject; // forward declaration
+
+/*
+per-frame list of the regions of a Screen that have to be redrawn
+top-level ScreenObjects register themselves here when they become dirty,
+collect() turns them into the rects they were drawn at and will be drawn at
+note: it does not own the objects
+*/
+class DamageTracker {
+private:
+    std::vector<ScreenObject*> dirty_objs; // top-level objects marked dirty since the last collect()
+    std::vector<::SDL_FRect> rects; // disjoint damaged regions
+
+public:
+    // above this the rects are merged into their union, clipping many small rects costs more than overdraw
+    static constexpr size_t max_num_of_rects = 16;
+    // outlines are drawn on the edge of the bounding box and may cover one more pixel
+    static constexpr float padding = 1.0f;
+
+    DamageTracker() = default;
+
+    DamageTracker(const DamageTracker&) = delete; // disable copy constructor
+    DamageTracker& operator=(const DamageTracker&) = delete; // disable copy assignment
+
+    void addDirty(ScreenObject* obj);
+    // obj is going away: drop it from dirty_objs and damage where it was drawn
+    void forget(const ScreenObject* obj);
+    // add rect (padded), merging it with the rects it overlaps
+    void addRect(const ::SDL_FRect& rect);
+
+    // turn the dirty objects into damaged rects (old and new bounds) and clear their dirty flags
+    void collect();
+
+    bool hasDamage() const noexcept { return !rects.empty() || !dirty_objs.empty(); }
+    const std::vector<::SDL_FRect>& getRects() const noexcept { return rects; }
+    // forget the rects once they have been redrawn
+    void clear() noexcept { rects.clear(); }
+
+private:
+    static bool helperIntersects(const ::SDL_FRect& a, const ::SDL_FRect& b) noexcept;
+    static ::SDL_FRect helperUnion(const ::SDL_FRect& a, const ::SDL_FRect& b) noexcept;
+
+    template <typename ExceptionType>
+    [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+        Logger::logAndThrow<ExceptionType>("DamageTracker::" + where, what);
+    }
+};
+
+} // namespace Display
+
+#endif // DAMAGE_TRACKER_HPP
@@ -0,0 +1,173 @@
+#include "GlyphAtlas.hpp"
+#include "../Logger/Metrics.hpp"
+#include "../Logger/Trace.hpp"
+
+#include <algorithm>
+
+namespace Display {
+
+// # GlyphAtlas
+
+GlyphAtlas::GlyphAtlas(::SDL_Renderer* arg_renderer, ::TTF_Font* font)
+    : renderer(arg_renderer)
+{
+    const std::string where = "GlyphAtlas(::SDL_Renderer* arg_renderer, ::TTF_Font* font) /* constructor */";
+    if (!renderer || !font) {
+        Logger::logAndThrow<std::invalid_argument>("GlyphAtlas::" + where, "renderer or font is null");
+    }
+    line_height = static_cast<float>(::TTF_GetFontHeight(font));
+
+    // rasterize every glyph first to know the atlas height (shelf packing, one shelf per line_height)
+    std::array<::SDL_Surface*, last_char - first_char + 1> surfaces {};
+    int x = 0, y = 0;
+    const int shelf_height = static_cast<int>(line_height) + padding;
+    for (int c = first_char; c <= last_char; ++c) {
+        ::SDL_Surface* surface = ::TTF_RenderGlyph_Blended(font, static_cast<Uint32>(c), ::SDL_Color{255, 255, 255, 255});
+        if (!surface) {
+            for (::SDL_Surface* s : surfaces) {
+                ::SDL_DestroySurface(s);
+            }
+            logAndThrow_SDL_failure(where, "TTF_RenderGlyph_Blended");
+        }
+        if (x + surface->w > atlas_width) {
+            x = 0;
+            y += shelf_height;
+        }
+        glyphs[c - first_char] = Glyph {
+            ::SDL_FRect{static_cast<float>(x), static_cast<float>(y), static_cast<float>(surface->w), static_cast<float>(surface->h)},
+            static_cast<float>(surface->w)
+        };
+        surfaces[c - first_char] = surface;
+        x += surface->w + padding;
+    }
+    const int atlas_height = y + shelf_height;
+
+    ::SDL_Surface* atlas_surface = ::SDL_CreateSurface(atlas_width, atlas_height, SDL_PIXELFORMAT_RGBA32);
+    bool ok = (atlas_surface != nullptr);
+    if (ok) {
+        ::SDL_FillSurfaceRect(atlas_surface, nullptr, 0); // transparent
+    }
+    for (int c = first_char; ok && c <= last_char; ++c) {
+        ::SDL_Surface* surface = surfaces[c - first_char];
+        const ::SDL_FRect& r = glyphs[c - first_char].src_rect;
+        ::SDL_Rect dst = {static_cast<int>(r.x), static_cast<int>(r.y), static_cast<int>(r.w), static_cast<int>(r.h)};
+        ::SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE); // copy the alpha as is
+        ok = ::SDL_BlitSurface(surface, nullptr, atlas_surface, &dst);
+    }
+    for (::SDL_Surface* s : surfaces) {
+        ::SDL_DestroySurface(s);
+    }
+    if (!ok) {
+        ::SDL_DestroySurface(atlas_surface);
+        logAndThrow_SDL_failure(where, "SDL_CreateSurface/SDL_BlitSurface");
+    }
+
+    texture = ::SDL_CreateTextureFromSurface(renderer, atlas_surface); // the only upload
+    ::SDL_DestroySurface(atlas_surface);
+    if (!texture) {
+        logAndThrow_SDL_failure(where, "SDL_CreateTextureFromSurface");
+    }
+    ::SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    Logger::log(
+        "GlyphAtlas::" + where,
+        "atlas created: " + std::to_string(atlas_width) + "x" + std::to_string(atlas_height),
+        Logger::DEBUG
+    );
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    if (texture) {
+        ::SDL_DestroyTexture(texture);
+    }
+}
+
+
+// # TextBatch
+
+TextBatch::TextBatch(const GlyphAtlas* arg_atlas)
+    : atlas(arg_atlas)
+{
+    if (!atlas) {
+        logAndThrow<std::invalid_argument>("TextBatch(const GlyphAtlas* arg_atlas) /* constructor */", "atlas is null");
+    }
+}
+
+size_t TextBatch::addSlot(const ::SDL_FPoint& pos, const ::SDL_Color& color, size_t capacity) {
+    const size_t first_quad = vertices.size() / 4;
+    slots.push_back(Slot {
+        "", pos,
+        ::SDL_FColor{color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f},
+        first_quad, capacity
+    });
+    vertices.resize((first_quad + capacity) * 4, ::SDL_Vertex{{pos.x, pos.y}, slots.back().color, {0, 0}});
+    indices.reserve((first_quad + capacity) * 6);
+    for (size_t q = first_quad; q < first_quad + capacity; ++q) {
+        const int v = static_cast<int>(q * 4);
+        // 0-1
+        // |/|
+        // 2-3
+        for (int i : {v, v + 1, v + 2, v + 2, v + 1, v + 3}) {
+            indices.push_back(i);
+        }
+    }
+    return slots.size() - 1;
+}
+
+void TextBatch::setText(size_t slot_id, std::string_view text) {
+    if (slot_id >= slots.size()) {
+        logAndThrow<std::out_of_range>("setText(size_t slot_id, std::string_view text)", "invalid slot_id: " + std::to_string(slot_id));
+    }
+    Slot& slot = slots[slot_id];
+    if (text.size() > slot.capacity) {
+        text = text.substr(0, slot.capacity);
+    }
+    if (slot.text == text) {
+        return; // cached
+    }
+    slot.text.assign(text.data(), text.size());
+    helperLayoutSlot(slot);
+}
+
+void TextBatch::draw() const {
+    if (indices.empty()) {
+        return;
+    }
+    TRACE_SCOPE("TextBatch::draw");
+    if (! ::SDL_RenderGeometry(
+        atlas->getRenderer(), atlas->getTexture(),
+        vertices.data(), static_cast<int>(vertices.size()),
+        indices.data(), static_cast<int>(indices.size())
+    )) {
+        logAndThrow<std::runtime_error>("draw() const", std::string("SDL_RenderGeometry failed: ") + ::SDL_GetError());
+    }
+    static MetricCounter& glyphs_counter = Metrics::counter("text_batch_glyphs_drawn_total", "glyph quads drawn by TextBatch");
+    glyphs_counter.add(indices.size() / 6);
+}
+
+// private
+
+void TextBatch::helperLayoutSlot(Slot& slot) {
+    float tex_w = 0, tex_h = 0;
+    ::SDL_GetTextureSize(atlas->getTexture(), &tex_w, &tex_h);
+
+    float x = slot.pos.x;
+    const float y = slot.pos.y;
+    ::SDL_Vertex* quad = vertices.data() + slot.first_quad * 4;
+    for (char c : slot.text) {
+        const GlyphAtlas::Glyph& g = atlas->getGlyph(c);
+        const float u0 = g.src_rect.x / tex_w, u1 = (g.src_rect.x + g.src_rect.w) / tex_w;
+        const float v0 = g.src_rect.y / tex_h, v1 = (g.src_rect.y + g.src_rect.h) / tex_h;
+        quad[0] = ::SDL_Vertex{{x, y}, slot.color, {u0, v0}};
+        quad[1] = ::SDL_Vertex{{x + g.src_rect.w, y}, slot.color, {u1, v0}};
+        quad[2] = ::SDL_Vertex{{x, y + g.src_rect.h}, slot.color, {u0, v1}};
+        quad[3] = ::SDL_Vertex{{x + g.src_rect.w, y + g.src_rect.h}, slot.color, {u1, v1}};
+        x += g.advance;
+        quad += 4;
+    }
+    // collapse the unused quads
+    ::SDL_Vertex* const end = vertices.data() + (slot.first_quad + slot.capacity) * 4;
+    std::fill(quad, end, ::SDL_Vertex{{x, y}, slot.color, {0, 0}});
+}
+
+} // namespace Display
@@ -0,0 +1,110 @@
+#ifndef GLYPH_ATLAS_HPP
+#define GLYPH_ATLAS_HPP
+
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_render.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <vector>
+
+#include "../Logger/Logger.hpp"
+
+namespace Display {
+
+/*
+printable ASCII glyphs of one font, rasterized once (white) into a single texture
+the color is applied per vertex, so one atlas serves every text color
+*/
+class GlyphAtlas {
+public:
+    static constexpr char first_char = 32; // ' '
+    static constexpr char last_char = 126; // '~'
+    static constexpr int atlas_width = 512;
+    static constexpr int padding = 1; // between glyphs, avoids bleeding with linear filtering
+
+    struct Glyph {
+        ::SDL_FRect src_rect; // in pixels in the atlas
+        float advance;
+    };
+
+private:
+    ::SDL_Renderer* renderer; // non-owning
+    ::SDL_Texture* texture = nullptr; // owning
+    std::array<Glyph, last_char - first_char + 1> glyphs;
+    float line_height = 0;
+
+public:
+    // caution: font is only used in the constructor
+    explicit GlyphAtlas(::SDL_Renderer* arg_renderer, ::TTF_Font* font);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete; // disable copy constructor
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete; // disable copy assignment
+
+    ::SDL_Renderer* getRenderer() const noexcept { return renderer; }
+    ::SDL_Texture* getTexture() const noexcept { return texture; }
+    float getLineHeight() const noexcept { return line_height; }
+    // characters out of range are drawn as '?'
+    const Glyph& getGlyph(char c) const noexcept {
+        return (c < first_char || c > last_char) ? glyphs['?' - first_char] : glyphs[c - first_char];
+    }
+
+private:
+    template <typename ExceptionType = std::runtime_error>
+    [[noreturn]] void logAndThrow_SDL_failure(const std::string& where, const std::string& sdl_func_name) const {
+        Logger::logAndThrow<ExceptionType>("GlyphAtlas::" + where, sdl_func_name + " failed: " + ::SDL_GetError());
+    }
+};
+
+
+/*
+cached text quads of a GlyphAtlas, drawn with one SDL_RenderGeometry call
+each slot is a fixed run of quads, setText only re-lays out that slot and only if its text changed,
+so drawing unchanged text costs one call regardless of its length
+*/
+class TextBatch {
+private:
+    struct Slot {
+        std::string text;
+        ::SDL_FPoint pos;
+        ::SDL_FColor color;
+        size_t first_quad;
+        size_t capacity; // in characters
+    };
+
+    const GlyphAtlas* atlas; // non-owning
+    std::vector<Slot> slots;
+    std::vector<::SDL_Vertex> vertices; // 4 per quad, unused quads are degenerate
+    std::vector<int> indices; // 6 per quad, fixed
+
+public:
+    explicit TextBatch(const GlyphAtlas* arg_atlas);
+
+    TextBatch(const TextBatch&) = delete; // disable copy constructor
+    TextBatch& operator=(const TextBatch&) = delete; // disable copy assignment
+
+    // reserve a slot for texts of at most capacity characters, returns the slot id
+    size_t addSlot(const ::SDL_FPoint& pos, const ::SDL_Color& color, size_t capacity);
+    // no-op if text is the same as before, longer texts are cut to the capacity
+    void setText(size_t slot_id, std::string_view text);
+    const std::string& getText(size_t slot_id) const { return slots.at(slot_id).text; }
+
+    void draw() const;
+
+private:
+    void helperLayoutSlot(Slot& slot);
+
+    template <typename ExceptionType>
+    [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+        Logger::logAndThrow<ExceptionType>("TextBatch::" + where, what);
+    }
+};
+
+} // namespace Display
+
+#endif // GLYPH_ATLAS_HPP
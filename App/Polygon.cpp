@@ -4,6 +4,7 @@
 #include <SDL3/SDL_render.h>
 
 #include <vector>
+#include <algorithm>
 
 #include "../Math/ComplexNumber.hpp"
 
@@ -11,6 +12,122 @@ namespace Display {
 
 using Vector2d = Math::Vector2d;
 
+namespace { // Anonymous namespace for private functions
+
+::SDL_FColor toFColor(const ::SDL_Color& c) {
+    return ::SDL_FColor { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+}
+
+// twice the signed area of the polygon (shoelace formula)
+double signedDoubleArea(const std::vector<Vector2d>& v) {
+    double result = 0;
+    for (size_t i = 0, n = v.size(); i < n; ++i) {
+        const Vector2d& a = v[i];
+        const Vector2d& b = v[(i + 1) % n];
+        result += a.x() * b.y() - b.x() * a.y();
+    }
+    return result;
+}
+
+// z of (b - a) x (c - b)
+double turn(const Vector2d& a, const Vector2d& b, const Vector2d& c) {
+    return (b.x() - a.x()) * (c.y() - b.y()) - (b.y() - a.y()) * (c.x() - b.x());
+}
+
+// true if all turns are to the same side (collinear vertices are allowed)
+bool isConvex(const std::vector<Vector2d>& v) {
+    const size_t n = v.size();
+    int sign = 0;
+    for (size_t i = 0; i < n; ++i) {
+        double t = turn(v[i], v[(i + 1) % n], v[(i + 2) % n]);
+        int s = (t > 0) - (t < 0);
+        if (s == 0) {
+            continue;
+        }
+        if (sign == 0) {
+            sign = s;
+        } else if (s != sign) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// p is inside or on the edge of triangle abc (any winding)
+bool isInTriangle(const Vector2d& p, const Vector2d& a, const Vector2d& b, const Vector2d& c) {
+    double d1 = turn(a, b, p);
+    double d2 = turn(b, c, p);
+    double d3 = turn(c, a, p);
+    bool has_neg = (d1 < 0) || (d2 < 0) || (d3 < 0);
+    bool has_pos = (d1 > 0) || (d2 > 0) || (d3 > 0);
+    return !(has_neg && has_pos);
+}
+
+// for convex polygons: (0, i, i+1)
+void triangulateFan(size_t n, std::vector<int>& result) {
+    result.reserve((n - 2) * 3);
+    for (size_t i = 1; i + 1 < n; ++i) {
+        result.push_back(0);
+        result.push_back(static_cast<int>(i));
+        result.push_back(static_cast<int>(i + 1));
+    }
+}
+
+// for simple (non self-intersecting) polygons, O(n^2)
+// falls back to a fan for what remains if no ear can be found (e.g. self-intersecting input)
+void triangulateEarClipping(const std::vector<Vector2d>& v, std::vector<int>& result) {
+    const double orientation = signedDoubleArea(v);
+    if (orientation == 0) {
+        return; // degenerated, nothing to fill
+    }
+    std::vector<int> remaining(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        remaining[i] = static_cast<int>(i);
+    }
+    result.reserve((v.size() - 2) * 3);
+
+    size_t i = 0;
+    size_t num_of_fails = 0; // number of vertices checked since the last ear was clipped
+    while (remaining.size() > 3) {
+        const size_t n = remaining.size();
+        const int ia = remaining[(i + n - 1) % n];
+        const int ib = remaining[i % n];
+        const int ic = remaining[(i + 1) % n];
+        const Vector2d& a = v[ia];
+        const Vector2d& b = v[ib];
+        const Vector2d& c = v[ic];
+
+        bool is_ear = turn(a, b, c) * orientation > 0; // b is a convex corner
+        for (size_t k = 0; is_ear && k < n; ++k) {
+            const int ip = remaining[k];
+            if (ip != ia && ip != ib && ip != ic && isInTriangle(v[ip], a, b, c)) {
+                is_ear = false;
+            }
+        }
+
+        if (is_ear) {
+            result.push_back(ia);
+            result.push_back(ib);
+            result.push_back(ic);
+            remaining.erase(remaining.begin() + (i % n));
+            num_of_fails = 0;
+        } else if (++num_of_fails > n) {
+            break; // no ear left
+        } else {
+            ++i;
+        }
+        i %= remaining.size();
+    }
+    // last triangle, or fan over what is left when no ear could be found
+    for (size_t k = 1; k + 1 < remaining.size(); ++k) {
+        result.push_back(remaining[0]);
+        result.push_back(remaining[k]);
+        result.push_back(remaining[k + 1]);
+    }
+}
+
+} // Anonymous namespace end
+
 // static
 ::SDL_Window* Polygon::default_window = nullptr;
 ::SDL_Renderer* Polygon::default_renderer = nullptr;
@@ -80,7 +197,7 @@ Polygon::Polygon(const ::SDL_FPoint& arg_centre_pos, const std::vector<Vector2d>
     {
     try {
         helperThrowIfNullWindowOrRenderer();
-        helperUpdateVertexPositions();
+        helperTriangulate();
     } catch (const std::exception& e) {
         logAndThrow<Logger::SeeAbove>(
             "Polygon(const ::SDL_FPoint& arg_centre_pos, const size_t& arg_num_of_sides)",
@@ -114,7 +231,7 @@ Polygon::Polygon(::SDL_Window* arg_window, ::SDL_Renderer* arg_renderer, const :
     {
     try {
     helperThrowIfNullWindowOrRenderer();
-    helperUpdateVertexPositions();
+    helperTriangulate();
     } catch (const std::exception& e) {
         logAndThrow<Logger::SeeAbove>(
             "Polygon(::SDL_Window* arg_window, ::SDL_Renderer* arg_renderer, const ::SDL_FPoint& arg_centre_pos, const std::vector<Vector2d>& arg_vertices)",
@@ -133,12 +250,8 @@ Polygon::Polygon(::SDL_Window* arg_window, ::SDL_Renderer* arg_renderer, const :
 void Polygon::setCentrePos(const SDL_FPoint& new_centre_pos) {
     centre_pos = new_centre_pos;
     // Update the positions of the vertices based on the new centre position
-    for (size_t i = 0; i < num_of_sides; ++i) {
-        pos_of_vertices[i] = SDL_FPoint {
-            static_cast<float>(vertices[i].x()) + centre_pos.x, 
-            static_cast<float>(vertices[i].y()) + centre_pos.y
-        };
-    }
+    // (translation does not change the triangulation)
+    helperUpdateVertexPositions();
 }
 void Polygon::setVertices(const std::vector<Vector2d>& new_vertices) {
     if (new_vertices.size() < 3) {
@@ -146,15 +259,16 @@ void Polygon::setVertices(const std::vector<Vector2d>& new_vertices) {
     }
     vertices = new_vertices;
     num_of_sides = vertices.size();
-    pos_of_vertices.resize(num_of_sides);
-    helperUpdateVertexPositions();
+    transform = Math::Affine2d::identity();
+    helperTriangulate();
 }
 void Polygon::setVerticesData(const std::vector<Vector2d>& new_vertices) {
     if (new_vertices.size() != num_of_sides) {
         logAndThrow<std::logic_error>("setVerticesData", "Number of vertices must be the same as num_of_sides");
     }
     vertices = new_vertices;
-    helperUpdateVertexPositions();
+    transform = Math::Affine2d::identity();
+    helperTriangulate();
 }
 void Polygon::setNumOfSides(const size_t &new_num_of_sides, bool clear_data, const Vector2d &default_val_for_vertices) {
     if (new_num_of_sides < 3) {
@@ -164,58 +278,67 @@ void Polygon::setNumOfSides(const size_t &new_num_of_sides, bool clear_data, con
     helperInitVerticesFromNumOfSides(clear_data, default_val_for_vertices);
 }
 void Polygon::helperUpdateVertexPositions() {
+    static_assert(sizeof(::SDL_FPoint) == 2 * sizeof(float), "SDL_FPoint must be two packed floats");
+    const Math::Affine2d to_screen = Math::Affine2d::translation(centre_pos.x, centre_pos.y) * transform;
+    to_screen.applyToFloat2(vertices.data(), num_of_sides, &pos_of_vertices.data()->x);
     for (size_t i = 0; i < num_of_sides; ++i) {
-        pos_of_vertices[i] = SDL_FPoint {
-            static_cast<float>(vertices[i].x()) + centre_pos.x, 
-            static_cast<float>(vertices[i].y()) + centre_pos.y
-        };
+        fill_geometry[i].position = pos_of_vertices[i];
+        outline_points[i] = pos_of_vertices[i];
+    }
+    if (num_of_sides > 0) {
+        outline_points[num_of_sides] = pos_of_vertices[0]; // close the outline
+    }
+    helperUpdateBoundingBox();
+}
+void Polygon::helperUpdateBoundingBox() {
+    if (num_of_sides == 0) {
+        bounding_box = {centre_pos.x, centre_pos.y, 0, 0};
+        return;
+    }
+    float min_x = pos_of_vertices[0].x, max_x = pos_of_vertices[0].x;
+    float min_y = pos_of_vertices[0].y, max_y = pos_of_vertices[0].y;
+    for (size_t i = 1; i < num_of_sides; ++i) {
+        min_x = std::min(min_x, pos_of_vertices[i].x);
+        max_x = std::max(max_x, pos_of_vertices[i].x);
+        min_y = std::min(min_y, pos_of_vertices[i].y);
+        max_y = std::max(max_y, pos_of_vertices[i].y);
     }
+    bounding_box = {min_x, min_y, max_x - min_x, max_y - min_y};
 }
 
 // public edit functions
+// note: rotating and enlarging keep the triangulation valid, so only the positions are updated
 
 void Polygon::enlarge(Math::Fraction ratio) {
-    for (Vector2d &vertex : vertices) {
-        vertex *= ratio.get_in_double();
-    }
-    helperUpdateVertexPositions();
+    transformBy(Math::Affine2d::scaling(ratio.get_in_double()));
 }
 void Polygon::rotate(const Math::Angle& radian) {
     this->angle += radian;
-    // Rotate each vertex using complex number multiplication (Euler's formula)
-    Math::ComplexNumber rotator = Math::ComplexNumber::createFromPolar(1.0, radian);
-    for (Vector2d &vertex : vertices) {
-        vertex = (Math::ComplexNumber(vertex) * rotator).toVector2d();
-    }
-    helperUpdateVertexPositions();
+    transformBy(Math::Affine2d::rotation(radian));
 }
 void Polygon::rotate(const Math::ComplexNumber& complex) {
     this->angle += complex.getAngle();
-    for (Vector2d &vertex : vertices) {
-        vertex = (Math::ComplexNumber(vertex) * complex).toVector2d();
-    }
-    helperUpdateVertexPositions();
+    // multiplying by a complex number also scales by its magnitude
+    transformBy(Math::Affine2d::fromComplex(complex));
 }
 void Polygon::rotate(const Math::RotationMatrix<2>& rotate_mat) {
     this->angle += rotate_mat.getAngleConstReference();
-    for (Vector2d &vertex : vertices) {
-        vertex = rotate_mat * vertex.getBaseConstReference();
-    }
+    transformBy(Math::Affine2d::rotation(rotate_mat.getAngleConstReference()));
+}
+void Polygon::transformBy(const Math::Affine2d& affine) {
+    transform = transform.then(affine);
     helperUpdateVertexPositions();
 }
 
 // public draw functions
 
 void Polygon::draw(SDL_Window* arg_window, SDL_Renderer* arg_renderer) {
-    if (arg_renderer != nullptr && arg_window == nullptr && fill) {
-        logAndThrow<std::logic_error>("draw", "drawWithFill needs window");
-    }
     arg_renderer = arg_renderer == nullptr ? renderer : arg_renderer;
-    arg_window = arg_window == nullptr ? window : arg_window;
+    arg_window = arg_window == nullptr ? window : arg_window; // kept for the interface, filling no longer needs the window
     
     try {
         if (fill) {
-            helperDrawWithFill(arg_window, arg_renderer, outline_color, fill_color);
+            helperDrawWithFill(arg_renderer, outline_color, fill_color);
         } else {
             helperDrawOutline(arg_renderer, outline_color);
         }
@@ -230,7 +353,7 @@ void Polygon::draw(SDL_Window* arg_window, SDL_Renderer* arg_renderer) {
 void Polygon::draw() const {
     try {
         if (fill) {
-            helperDrawWithFill(window, renderer, outline_color, fill_color);
+            helperDrawWithFill(renderer, outline_color, fill_color);
         } else {
             helperDrawOutline(renderer, outline_color);
         }
@@ -244,7 +367,7 @@ void Polygon::draw() const {
 void Polygon::draw(bool arg_fill) const {
     try {
         if (arg_fill) {
-            helperDrawWithFill(window, renderer, outline_color, fill_color);
+            helperDrawWithFill(renderer, outline_color, fill_color);
         } else {
             helperDrawOutline(renderer, outline_color);
         }
@@ -256,6 +379,24 @@ void Polygon::draw(bool arg_fill) const {
     }
 }
 
+void Polygon::enqueue(RenderQueue& queue, int layer) const {
+    enqueue(queue, layer, fill);
+}
+void Polygon::enqueue(RenderQueue& queue, int layer, bool arg_fill) const {
+    if (arg_fill && !triangle_indices.empty()) {
+        helperUpdateFillGeometryColor(fill_color);
+        queue.pushFill(
+            layer, (fill_color.a == 255) ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND,
+            fill_geometry.data(), fill_geometry.size(),
+            triangle_indices.data(), triangle_indices.size()
+        );
+    }
+    queue.pushLines(
+        layer, (outline_color.a == 255) ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND, outline_color,
+        outline_points.data(), outline_points.size()
+    );
+}
+
 void Polygon::drawWithoutFill() const {
     try {
         helperDrawOutline(renderer, outline_color);
@@ -279,7 +420,7 @@ void Polygon::drawWithoutFill(const ::SDL_Color& arg_outline_color) const {
 
 void Polygon::drawWithFill() const {
     try {
-        helperDrawWithFill(window, renderer, outline_color, fill_color);
+        helperDrawWithFill(renderer, outline_color, fill_color);
     } catch (const std::exception& e) {
         logAndThrow<Logger::SeeAbove>(
             "drawWithFill() const",
@@ -289,7 +430,7 @@ void Polygon::drawWithFill() const {
 }
 void Polygon::drawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const {
     try {
-        helperDrawWithFill(window, renderer, arg_outline_color, arg_fill_color);
+        helperDrawWithFill(renderer, arg_outline_color, arg_fill_color);
     } catch (const std::exception& e) {
         logAndThrow<Logger::SeeAbove>(
             "drawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const",
@@ -299,6 +440,12 @@ void Polygon::drawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Col
 }
 
 bool Polygon::isInside(const int& pos_x, const int& pos_y) const noexcept {
+    // cheap reject with the bounding box first
+    if (pos_x < bounding_box.x || pos_x > bounding_box.x + bounding_box.w
+        || pos_y < bounding_box.y || pos_y > bounding_box.y + bounding_box.h
+    ) {
+        return false;
+    }
     // Check if the point is inside the polygon using the ray-casting algorithm
     int count = 0;
     for (size_t i = 0; i < num_of_sides; ++i) {
@@ -342,10 +489,46 @@ void Polygon::helperInitVerticesFromNumOfSides(bool clear_data, const Vector2d&
     } else {
         vertices.resize(num_of_sides, default_val_for_vertices);
     }
+    helperTriangulate();
+}
+
+void Polygon::helperTriangulate() {
     pos_of_vertices.resize(num_of_sides);
+    fill_geometry.resize(num_of_sides);
+    outline_points.resize(num_of_sides == 0 ? 0 : num_of_sides + 1);
+
+    triangle_indices.clear();
+    if (num_of_sides >= 3) {
+        if (isConvex(vertices)) {
+            triangulateFan(num_of_sides, triangle_indices);
+        } else {
+            triangulateEarClipping(vertices, triangle_indices);
+        }
+    }
+    // force the color to be rewritten on next draw
+    fill_geometry_color = {0, 0, 0, 0};
+    for (::SDL_Vertex& v : fill_geometry) {
+        v.color = toFColor(fill_geometry_color);
+        v.tex_coord = {0, 0};
+    }
     helperUpdateVertexPositions();
 }
 
+void Polygon::helperUpdateFillGeometryColor(const ::SDL_Color& arg_fill_color) const {
+    if (fill_geometry_color.r == arg_fill_color.r
+        && fill_geometry_color.g == arg_fill_color.g
+        && fill_geometry_color.b == arg_fill_color.b
+        && fill_geometry_color.a == arg_fill_color.a
+    ) {
+        return;
+    }
+    const ::SDL_FColor fcolor = toFColor(arg_fill_color);
+    for (::SDL_Vertex& v : fill_geometry) {
+        v.color = fcolor;
+    }
+    fill_geometry_color = arg_fill_color;
+}
+
 void Polygon::helperDrawOutline(SDL_Renderer* arg_renderer, const ::SDL_Color& arg_color) const {
     if (! ::SDL_SetRenderDrawColor(arg_renderer, arg_color.r, arg_color.g, arg_color.b, arg_color.a)) {
         logAndThrow_SDL_failure<std::runtime_error>(
@@ -354,7 +537,10 @@ void Polygon::helperDrawOutline(SDL_Renderer* arg_renderer, const ::SDL_Color& a
         );
     }
     
-    if (! ::SDL_RenderLines(arg_renderer, pos_of_vertices.data(), pos_of_vertices.size())) {
+    if (outline_points.empty()) {
+        return;
+    }
+    if (! ::SDL_RenderLines(arg_renderer, outline_points.data(), static_cast<int>(outline_points.size()))) {
         logAndThrow_SDL_failure<std::runtime_error>(
             "draw_outline(const ::SDL_Color& arg_color) const", 
             "SDL_RenderLines"
@@ -362,74 +548,29 @@ void Polygon::helperDrawOutline(SDL_Renderer* arg_renderer, const ::SDL_Color& a
     }
 }
 
-void Polygon::helperDrawWithFill(SDL_Window* arg_window, SDL_Renderer* arg_renderer, const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const {
-    if (! ::SDL_SetRenderDrawColor(arg_renderer, arg_fill_color.r, arg_fill_color.g, arg_fill_color.b, arg_fill_color.a)) {
-        logAndThrow_SDL_failure<std::runtime_error>(
-            "fill(const ::SDL_Color& arg_fill_color)", 
-            "SDL_SetRenderDrawColor"
-        );
-    }
-    // Create an off-screen buffer to draw the polygon
-    int windowWidth, windowHeight;
-    if (! ::SDL_GetWindowSize(arg_window, &windowWidth, &windowHeight)) {
-        logAndThrow_SDL_failure<std::runtime_error>(
-            "helperDrawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color)", 
-            "SDL_GetWindowSize"
-        );
-    }
-    
-    ::SDL_Texture* offscreenTexture = ::SDL_CreateTexture(arg_renderer, ::SDL_PIXELFORMAT_RGBA32, ::SDL_TEXTUREACCESS_TARGET, windowWidth, windowHeight);
-    if (!offscreenTexture) {
-        logAndThrow_SDL_failure<std::runtime_error>(
-            "helperDrawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color)", 
-            "SDL_CreateTexture"
-        );
-    }
-    
-    // Draw and fill the polygon on the off-screen buffer
-    if (! ::SDL_SetRenderTarget(arg_renderer, offscreenTexture)) {
-        logAndThrow_SDL_failure<std::runtime_error>(
-            "helperDrawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color)", 
-            "SDL_SetRenderTarget"
-        );
+void Polygon::helperDrawWithFill(SDL_Renderer* arg_renderer, const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const {
+    if (!triangle_indices.empty()) {
+        helperUpdateFillGeometryColor(arg_fill_color);
+        if (! ::SDL_RenderGeometry(
+            arg_renderer, nullptr, 
+            fill_geometry.data(), static_cast<int>(fill_geometry.size()), 
+            triangle_indices.data(), static_cast<int>(triangle_indices.size())
+        )) {
+            logAndThrow_SDL_failure<std::runtime_error>(
+                "helperDrawWithFill(SDL_Renderer* arg_renderer, const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const", 
+                "SDL_RenderGeometry"
+            );
+        }
     }
     
-    try { helperDrawOutline(renderer, arg_outline_color); }
+    try { helperDrawOutline(arg_renderer, arg_outline_color); }
     catch (const std::exception& e) { 
-        logAndThrow_SDL_failure<Logger::SeeAbove>(
-            "helperDrawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color)", 
-            e.what()
-        );
-    }
-    
-    try { SdlUtils::flood_fill_F(arg_renderer, centre_pos, arg_fill_color); }
-    catch (const std::exception& e) {
-        logAndThrow_SDL_failure<Logger::SeeAbove>(
-            "helperDrawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color)", 
+        logAndThrow<Logger::SeeAbove>(
+            "helperDrawWithFill(SDL_Renderer* arg_renderer, const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const", 
             e.what()
         );
     }
-    
-    
-    
-    
-    // Copy the filled polygon from the off-screen buffer to the window renderer
-    if (! ::SDL_SetRenderTarget(renderer, nullptr)) { // reset to default target
-        logAndThrow_SDL_failure<std::runtime_error>(
-            "helperDrawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color)", 
-            "SDL_SetRenderTarget"
-        );
-    }
-    if (! ::SDL_RenderTexture(renderer, offscreenTexture, NULL, NULL)) {
-        logAndThrow_SDL_failure<std::runtime_error>(
-            "helperDrawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color)", 
-            "SDL_RenderTexture"
-        );
-    }
-    
     // doNOT do ::SDL_RenderPresent(renderer);
-    // Handle events and cleanup
-    ::SDL_DestroyTexture(offscreenTexture);
 }
 
 
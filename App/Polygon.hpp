@@ -15,6 +15,7 @@
 #include "Logger.hpp"
 #include "Math/Math.hpp"
 #include "SdlUtils.hpp"
+#include "RenderQueue.hpp"
 
 namespace Display {
 
@@ -26,8 +27,19 @@ private:
     ::SDL_FPoint centre_pos = {0, 0}; // default centre position is (0, 0)
     Math::Angle angle { 0 };
     size_t num_of_sides = 0; // number of sides of the polygon
-    std::vector<Vector2d> vertices; // vertices of the polygon
-    std::vector<SDL_FPoint> pos_of_vertices; // positions of vertices of the polygon
+    std::vector<Vector2d> vertices; // vertices of the polygon, relative to the centre, before transform
+    Math::Affine2d transform; // rotations and scaling applied so far (about the centre)
+    std::vector<SDL_FPoint> pos_of_vertices; // positions of vertices of the polygon: centre + transform(vertex)
+
+    // cached fill/outline geometry
+    // triangle_indices is only rebuilt when the shape changes (helperTriangulate),
+    // the other two follow pos_of_vertices (helperUpdateVertexPositions)
+    std::vector<int> triangle_indices; // 3 indices into pos_of_vertices per triangle
+    mutable std::vector<::SDL_Vertex> fill_geometry; // pos_of_vertices with fill color baked in, for SDL_RenderGeometry
+    mutable ::SDL_Color fill_geometry_color = {0, 0, 0, 0}; // the color currently baked into fill_geometry
+    std::vector<::SDL_FPoint> outline_points; // pos_of_vertices closed with the first vertex, for SDL_RenderLines
+    ::SDL_FRect bounding_box = {0, 0, 0, 0}; // axis-aligned box of pos_of_vertices
+
     static ::SDL_Window* default_window;
     static ::SDL_Renderer* default_renderer;
 public:
@@ -72,10 +84,15 @@ public:
     const ::SDL_Window *getWindow() const noexcept { return window; }
     const ::SDL_Renderer *getRenderer() const noexcept { return renderer; }
     const ::SDL_FPoint &getCentrePos() const noexcept { return centre_pos; }
+    // untransformed, see getTransform
     const std::vector<Vector2d> &getVertices() const noexcept { return vertices; }
+    const Math::Affine2d &getTransform() const noexcept { return transform; }
     const std::vector<::SDL_FPoint> &getPosOfVertices() const noexcept { return pos_of_vertices; }
+    const std::vector<int> &getTriangleIndices() const noexcept { return triangle_indices; }
+    const ::SDL_FRect &getBoundingBox() const noexcept { return bounding_box; }
 
     void setCentrePos(const SDL_FPoint& new_centre_pos);
+    // the new vertices replace the transformed shape, so the transform is reset
     void setVertices(const std::vector<Vector2d>& new_vertices);
     void setVerticesData(const std::vector<Vector2d>& new_vertices);
     void setNumOfSides(const size_t &new_num_of_sides, bool clear_data = false, const Vector2d &default_val_for_vertices = Vector2d());
@@ -84,6 +101,8 @@ public:
     void rotate(const Math::Angle& radian);
     void rotate(const Math::ComplexNumber& complex);
     void rotate(const Math::RotationMatrix<2>& rotate_mat);
+    // apply any transform about the centre (rotate/enlarge are shortcuts for this)
+    void transformBy(const Math::Affine2d& affine);
 
     void draw(SDL_Window* arg_window, SDL_Renderer* arg_renderer);
     void draw() const { draw(fill); }
@@ -92,6 +111,10 @@ public:
     void drawWithoutFill(const ::SDL_Color& arg_outline_color) const;
     void drawWithFill() const;
     void drawWithFill(const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const;
+
+    // push the fill (if fill) and the outline to queue instead of drawing them now
+    void enqueue(RenderQueue& queue, int layer = 0) const;
+    void enqueue(RenderQueue& queue, int layer, bool arg_fill) const;
     
     // Check if the point is inside the polygon
     bool isInside(const int& pos_x, const int& pos_y) const noexcept;
@@ -133,16 +156,26 @@ private:
     void helperThrowIfNumOfSidesIsNotValid(const std::string& func_name) const;
 
     void helperInitVerticesFromNumOfSides(bool clear_data = false, const Vector2d& default_val_for_vertices = Vector2d());
-    // Update the positions of the vertices based on the current centre position
+    // Rebuild triangle_indices from vertices and resize the cached geometry,
+    // then update the positions of the vertices
+    // It must be called whenever the shape (not only the position) changes
+    void helperTriangulate();
+    // Update the positions of the vertices based on the current centre position and transform
+    // (one batch pass of translation(centre) * transform over vertices)
     // It should only be used after pos_of_vertices has the correct size
     void helperUpdateVertexPositions();
+    // Recompute bounding_box from pos_of_vertices
+    void helperUpdateBoundingBox();
+    // Rewrite the color of fill_geometry if it is not arg_fill_color
+    void helperUpdateFillGeometryColor(const ::SDL_Color& arg_fill_color) const;
 
-    // this function is used to draw the outline of the shape
+    // this function is used to draw the outline of the shape (one SDL_RenderLines call)
     // caution: it does not check the renderer
     void helperDrawOutline(SDL_Renderer* arg_renderer, const ::SDL_Color& arg_color) const;
     // this function is used to draw the polygon (including outline and fill)
+    // the fill is one SDL_RenderGeometry call on the cached triangles
     // caution: it does not check the renderer
-    void helperDrawWithFill(SDL_Window* arg_window, SDL_Renderer* renderer, const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const;
+    void helperDrawWithFill(SDL_Renderer* arg_renderer, const ::SDL_Color& arg_outline_color, const ::SDL_Color& arg_fill_color) const;
 };
 
 template <size_t NumOfSides>
@@ -0,0 +1,196 @@
+#include "RenderQueue.hpp"
+#include "../Logger/Metrics.hpp"
+#include "../Logger/Trace.hpp"
+
+#include <algorithm>
+
+namespace { // Anonymous namespace for private functions
+
+MetricCounter& commandsCounter() {
+    static MetricCounter& counter = Metrics::counter("render_queue_commands_total", "commands flushed by RenderQueue");
+    return counter;
+}
+
+MetricCounter& drawCallsCounter() {
+    static MetricCounter& counter = Metrics::counter("render_queue_draw_calls_total", "SDL draw calls made by RenderQueue");
+    return counter;
+}
+
+} // Anonymous namespace end
+
+namespace Display {
+
+void RenderQueue::pushFill(int layer, ::SDL_BlendMode blend_mode,
+    const ::SDL_Vertex* arg_vertices, size_t num_of_vertices,
+    const int* arg_indices, size_t num_of_indices
+) {
+    if (num_of_indices == 0) {
+        return;
+    }
+    const int offset = static_cast<int>(vertices.size());
+    vertices.insert(vertices.end(), arg_vertices, arg_vertices + num_of_vertices);
+
+    Command cmd;
+    cmd.sort_key = helperSortKey(layer);
+    cmd.kind = CommandKind::Fill;
+    cmd.blend_mode = blend_mode;
+    cmd.color = {0, 0, 0, 0};
+    cmd.first = static_cast<uint32_t>(indices.size());
+    cmd.count = static_cast<uint32_t>(num_of_indices);
+    cmd.custom_func = nullptr;
+    for (size_t i = 0; i < num_of_indices; ++i) {
+        indices.push_back(arg_indices[i] + offset);
+    }
+    commands.push_back(cmd);
+}
+
+void RenderQueue::pushLines(int layer, ::SDL_BlendMode blend_mode, const ::SDL_Color& color,
+    const ::SDL_FPoint* arg_points, size_t num_of_points
+) {
+    if (num_of_points < 2) {
+        return;
+    }
+    Command cmd;
+    cmd.sort_key = helperSortKey(layer);
+    cmd.kind = CommandKind::Lines;
+    cmd.blend_mode = blend_mode;
+    cmd.color = color;
+    cmd.first = static_cast<uint32_t>(points.size());
+    cmd.count = static_cast<uint32_t>(num_of_points);
+    cmd.custom_func = nullptr;
+    points.insert(points.end(), arg_points, arg_points + num_of_points);
+    commands.push_back(cmd);
+}
+
+void RenderQueue::pushCustom(int layer, const CustomDrawFuncT* func) {
+    if (func == nullptr || !*func) {
+        logAndThrow<std::invalid_argument>("pushCustom(int layer, const CustomDrawFuncT* func)", "func is empty");
+    }
+    Command cmd;
+    cmd.sort_key = helperSortKey(layer);
+    cmd.kind = CommandKind::Custom;
+    cmd.blend_mode = SDL_BLENDMODE_NONE;
+    cmd.color = {0, 0, 0, 0};
+    cmd.first = 0;
+    cmd.count = 0;
+    cmd.custom_func = func;
+    commands.push_back(cmd);
+}
+
+void RenderQueue::flush(::SDL_Renderer* renderer) {
+    if (commands.empty()) {
+        return;
+    }
+    if (!renderer) {
+        logAndThrow<std::invalid_argument>("flush(::SDL_Renderer* renderer)", "renderer is null");
+    }
+    TRACE_SCOPE("RenderQueue::flush");
+    commandsCounter().add(commands.size());
+    // stable: commands of one layer stay in submission order
+    std::stable_sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        return a.sort_key < b.sort_key;
+    });
+
+    bool has_blend_mode = false;
+    ::SDL_BlendMode current_blend_mode = SDL_BLENDMODE_NONE;
+    size_t begin = 0;
+    while (begin < commands.size()) {
+        const Command& first = commands[begin];
+        // commands of one run only differ in their payload
+        size_t end = begin + 1;
+        while (end < commands.size() && helperCanMerge(commands[end - 1], commands[end])) {
+            ++end;
+        }
+
+        if (first.kind == CommandKind::Custom) {
+            for (size_t i = begin; i < end; ++i) {
+                (*commands[i].custom_func)();
+            }
+            has_blend_mode = false; // the custom draws may have changed it
+        } else {
+            if (!has_blend_mode || current_blend_mode != first.blend_mode) {
+                if (! ::SDL_SetRenderDrawBlendMode(renderer, first.blend_mode)) {
+                    logAndThrow_SDL_failure("flush(::SDL_Renderer* renderer)", "SDL_SetRenderDrawBlendMode");
+                }
+                current_blend_mode = first.blend_mode;
+                has_blend_mode = true;
+            }
+            if (first.kind == CommandKind::Fill) {
+                helperSubmitFills(renderer, begin, end);
+            } else {
+                helperSubmitLines(renderer, begin, end);
+            }
+        }
+        begin = end;
+    }
+    clear();
+}
+
+void RenderQueue::clear() noexcept {
+    commands.clear();
+    vertices.clear();
+    indices.clear();
+    points.clear();
+}
+
+// private
+
+uint64_t RenderQueue::helperSortKey(int layer) noexcept {
+    // biased so that negative layers sort first
+    return static_cast<uint64_t>(static_cast<int64_t>(layer) - static_cast<int64_t>(INT32_MIN));
+}
+
+bool RenderQueue::helperCanMerge(const Command& a, const Command& b) noexcept {
+    if (a.sort_key != b.sort_key || a.kind != b.kind) {
+        return false;
+    }
+    switch (a.kind) {
+        case CommandKind::Fill:
+            return a.blend_mode == b.blend_mode; // all 32 bits, custom modes included
+        case CommandKind::Lines:
+            return a.blend_mode == b.blend_mode
+                && a.color.r == b.color.r && a.color.g == b.color.g
+                && a.color.b == b.color.b && a.color.a == b.color.a;
+        default:
+            return true; // Custom: called one by one anyway
+    }
+}
+
+void RenderQueue::helperSubmitFills(::SDL_Renderer* renderer, size_t begin, size_t end) {
+    const int* index_data = indices.data() + commands[begin].first;
+    size_t num_of_indices = commands[begin].count;
+    if (end - begin > 1) {
+        merged_indices.clear();
+        for (size_t i = begin; i < end; ++i) {
+            merged_indices.insert(merged_indices.end(),
+                indices.begin() + commands[i].first,
+                indices.begin() + commands[i].first + commands[i].count
+            );
+        }
+        index_data = merged_indices.data();
+        num_of_indices = merged_indices.size();
+    }
+    if (! ::SDL_RenderGeometry(
+        renderer, nullptr,
+        vertices.data(), static_cast<int>(vertices.size()),
+        index_data, static_cast<int>(num_of_indices)
+    )) {
+        logAndThrow_SDL_failure("helperSubmitFills", "SDL_RenderGeometry");
+    }
+    drawCallsCounter().add();
+}
+
+void RenderQueue::helperSubmitLines(::SDL_Renderer* renderer, size_t begin, size_t end) {
+    const ::SDL_Color& color = commands[begin].color;
+    if (! ::SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a)) {
+        logAndThrow_SDL_failure("helperSubmitLines", "SDL_SetRenderDrawColor");
+    }
+    for (size_t i = begin; i < end; ++i) {
+        if (! ::SDL_RenderLines(renderer, points.data() + commands[i].first, static_cast<int>(commands[i].count))) {
+            logAndThrow_SDL_failure("helperSubmitLines", "SDL_RenderLines");
+        }
+    }
+    drawCallsCounter().add(end - begin);
+}
+
+} // namespace Display
@@ -0,0 +1,101 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_render.h>
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <functional>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace Display {
+
+/*
+deferred draw commands of one frame
+objects push compact POD commands, flush() sorts them by layer (stable: inside one layer they are
+drawn in submission order) and merges neighbouring commands that can share SDL calls:
+  - consecutive fills of one blend mode -> one SDL_RenderGeometry (the color is baked into the vertices)
+  - consecutive outlines of one blend mode and color -> one SDL_SetRenderDrawColor, then one
+    SDL_RenderLines per outline
+so objects that alternate fill and outline cost more calls than runs of the same kind
+*/
+class RenderQueue {
+public:
+    using CustomDrawFuncT = std::function<void()>;
+
+    enum class CommandKind : uint8_t {
+        Fill = 0,
+        Lines = 1,
+        Custom = 2
+    };
+
+    struct Command { // POD
+        uint64_t sort_key; // the layer only, see helperSortKey
+        CommandKind kind;
+        ::SDL_BlendMode blend_mode;
+        ::SDL_Color color; // only used by Lines
+        uint32_t first; // Fill: into indices, Lines: into points
+        uint32_t count;
+        const CustomDrawFuncT* custom_func; // non-owning // only used by Custom
+    };
+
+private:
+    std::vector<Command> commands;
+    // pooled buffers, cleared every flush but their capacity is kept
+    std::vector<::SDL_Vertex> vertices;
+    std::vector<int> indices; // already offset into vertices
+    std::vector<::SDL_FPoint> points;
+    std::vector<int> merged_indices; // reused by flush
+
+public:
+    RenderQueue() = default;
+
+    RenderQueue(const RenderQueue&) = delete; // disable copy constructor
+    RenderQueue& operator=(const RenderQueue&) = delete; // disable copy assignment
+
+    size_t size() const noexcept { return commands.size(); }
+    bool empty() const noexcept { return commands.empty(); }
+
+    // triangles, the vertices carry their own color
+    void pushFill(int layer, ::SDL_BlendMode blend_mode,
+        const ::SDL_Vertex* arg_vertices, size_t num_of_vertices,
+        const int* arg_indices, size_t num_of_indices
+    );
+    // connected line segments (as SDL_RenderLines)
+    void pushLines(int layer, ::SDL_BlendMode blend_mode, const ::SDL_Color& color,
+        const ::SDL_FPoint* arg_points, size_t num_of_points
+    );
+    // escape hatch for things that cannot be described by the commands above
+    // func must stay alive until flush()
+    void pushCustom(int layer, const CustomDrawFuncT* func);
+
+    // sort, submit and clear the commands
+    void flush(::SDL_Renderer* renderer);
+    // drop the commands without drawing them
+    void clear() noexcept;
+
+private:
+    static uint64_t helperSortKey(int layer) noexcept;
+    // whether b can be drawn in the same SDL calls as a, right after it
+    static bool helperCanMerge(const Command& a, const Command& b) noexcept;
+    void helperSubmitFills(::SDL_Renderer* renderer, size_t begin, size_t end);
+    void helperSubmitLines(::SDL_Renderer* renderer, size_t begin, size_t end);
+
+    template <typename ExceptionType>
+    [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+        Logger::logAndThrow<ExceptionType>("RenderQueue::" + where, what);
+    }
+    template <typename ExceptionType = std::runtime_error>
+    [[noreturn]] void logAndThrow_SDL_failure(const std::string& where, const std::string& sdl_func_name) const {
+        logAndThrow<ExceptionType>(where, sdl_func_name + " failed: " + ::SDL_GetError());
+    }
+};
+
+} // namespace Display
+
+#endif // RENDER_QUEUE_HPP
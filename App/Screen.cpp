@@ -1,3 +1,91 @@
 #include "Screen.hpp"
 
+#include <cmath>
+
 using namespace Display;
+
+Screen::~Screen() {
+    objs.clear(); // before damage_tracker and spatial_index
+    if (scene_cache) {
+        ::SDL_DestroyTexture(scene_cache);
+    }
+}
+
+void Screen::renderScene(::SDL_Renderer* renderer) {
+    if (!renderer) {
+        log_and_throw<std::invalid_argument>("renderScene", "renderer is null");
+    }
+    helperEnsureSceneCache(renderer);
+
+    damage_tracker.collect();
+    if (damage_tracker.hasDamage()) {
+        ::SDL_Texture* old_target = ::SDL_GetRenderTarget(renderer);
+        if (!::SDL_SetRenderTarget(renderer, scene_cache)) {
+            log_and_throw<std::runtime_error>("renderScene", std::string("SDL_SetRenderTarget failed: ") + ::SDL_GetError());
+        }
+        for (const ::SDL_FRect& rect : damage_tracker.getRects()) {
+            helperRedrawRegion(renderer, rect);
+        }
+        ::SDL_SetRenderClipRect(renderer, nullptr);
+        ::SDL_SetRenderTarget(renderer, old_target);
+        damage_tracker.clear();
+    }
+
+    if (!::SDL_RenderTexture(renderer, scene_cache, nullptr, nullptr)) {
+        log_and_throw<std::runtime_error>("renderScene", std::string("SDL_RenderTexture failed: ") + ::SDL_GetError());
+    }
+}
+
+void Screen::invalidate() {
+    if (!scene_cache) {
+        return; // everything is drawn when the cache is created
+    }
+    damage_tracker.addRect({0, 0, static_cast<float>(scene_cache->w), static_cast<float>(scene_cache->h)});
+}
+
+// private
+
+void Screen::helperEnsureSceneCache(::SDL_Renderer* renderer) {
+    int w = 0, h = 0;
+    if (!::SDL_GetCurrentRenderOutputSize(renderer, &w, &h)) {
+        log_and_throw<std::runtime_error>("helperEnsureSceneCache", std::string("SDL_GetCurrentRenderOutputSize failed: ") + ::SDL_GetError());
+    }
+    if (scene_cache && scene_cache->w == w && scene_cache->h == h) {
+        return;
+    }
+    if (scene_cache) {
+        ::SDL_DestroyTexture(scene_cache);
+    }
+    scene_cache = ::SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!scene_cache) {
+        log_and_throw<std::runtime_error>("helperEnsureSceneCache", std::string("SDL_CreateTexture failed: ") + ::SDL_GetError());
+    }
+    log("helperEnsureSceneCache", "scene cache (re)created: " + std::to_string(w) + "x" + std::to_string(h), Logger::DEBUG);
+    invalidate();
+}
+
+void Screen::helperRedrawRegion(::SDL_Renderer* renderer, const ::SDL_FRect& rect) {
+    // clip to whole pixels covering rect
+    const ::SDL_Rect clip = {
+        static_cast<int>(std::floor(rect.x)),
+        static_cast<int>(std::floor(rect.y)),
+        static_cast<int>(std::ceil(rect.x + rect.w) - std::floor(rect.x)),
+        static_cast<int>(std::ceil(rect.y + rect.h) - std::floor(rect.y))
+    };
+    ::SDL_SetRenderClipRect(renderer, &clip);
+
+    // SDL_RenderClear ignores the clip rect
+    const ::SDL_FRect clip_f = {
+        static_cast<float>(clip.x), static_cast<float>(clip.y),
+        static_cast<float>(clip.w), static_cast<float>(clip.h)
+    };
+    ::SDL_SetRenderDrawColor(renderer, background_color.r, background_color.g, background_color.b, background_color.a);
+    ::SDL_RenderFillRect(renderer, &clip_f);
+
+    damaged_objs.clear();
+    spatial_index.queryRect(clip_f, damaged_objs); // in drawing order
+    for (ScreenObject* obj : damaged_objs) {
+        obj->submit(render_queue);
+    }
+    render_queue.flush(renderer);
+}
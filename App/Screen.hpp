@@ -9,19 +9,79 @@
 
 #include "Logger.hpp"
 #include "ScreenObject.hpp"
+#include "SpatialIndex.hpp"
+#include "DamageTracker.hpp"
+#include "RenderQueue.hpp"
 
 namespace Display {
 
 class Screen {
 private:
-    std::vector<ScreenObject> objs;
+    SpatialIndex spatial_index; // must outlive objs (declared before objs)
+    DamageTracker damage_tracker; // must outlive objs (declared before objs)
+    std::vector<std::unique_ptr<ScreenObject>> objs; // later ones are drawn on top
+
+    // retained image of the scene, only the damaged regions are redrawn into it
+    ::SDL_Texture* scene_cache = nullptr; // owning
+    std::vector<ScreenObject*> damaged_objs; // reused by renderScene
+    RenderQueue render_queue; // reused by renderScene
+
+    // (re)create scene_cache if it is missing or the output size changed, damaging the whole screen
+    void helperEnsureSceneCache(::SDL_Renderer* renderer);
+    // redraw the objects intersecting rect into the current target, clipped to rect
+    void helperRedrawRegion(::SDL_Renderer* renderer, const ::SDL_FRect& rect);
+
+    void log(const std::string& where, const std::string& message, Logger::LogLevel level = Logger::INFO) const {
+        Logger::log("Screen::" + where, message, level);
+    }
     // Helper function to log and throw exceptions
     template <typename ExceptionType>
     [[noreturn]] void log_and_throw(const std::string& where, const std::string& message) {
         Logger::log_and_throw<ExceptionType>("Screen::"+where, message);
     }
 public:
-    virtual ~Screen() = default;
+    ::SDL_Color background_color = {0, 0, 0, 255};
+
+    Screen() = default;
+    Screen(const Screen&) = delete; // disable copy constructor
+    Screen& operator=(const Screen&) = delete; // disable copy assignment
+    virtual ~Screen();
+
+    // takes ownership of obj and registers it for hit-testing
+    ScreenObject* addObject(std::unique_ptr<ScreenObject> obj) {
+        if (!obj) {
+            log_and_throw<std::invalid_argument>("addObject", "obj is null");
+        }
+        obj->setSpatialIndex(&spatial_index);
+        obj->setDamageTracker(&damage_tracker);
+        objs.push_back(std::move(obj));
+        return objs.back().get();
+    }
+    void removeObject(const ScreenObject* obj) {
+        for (auto it = objs.begin(); it != objs.end(); ++it) {
+            if (it->get() == obj) {
+                objs.erase(it); // the destructor unregisters it and damages where it was drawn
+                return;
+            }
+        }
+    }
+    const std::vector<std::unique_ptr<ScreenObject>>& getObjects() const noexcept { return objs; }
+
+    // the topmost visible object at (x, y), nullptr if none
+    ScreenObject* findObjectAt(float x, float y, bool clickable_only = false) const {
+        return spatial_index.findTopmostAt(x, y, clickable_only);
+    }
+    // the topmost clickable object under the mouse for SDL_EVENT_MOUSE_BUTTON_DOWN / SDL_EVENT_MOUSE_MOTION,
+    // nullptr for other events
+    ScreenObject* findObjectAtMouse(const SDL_Event& event) const {
+        if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
+            return findObjectAt(event.button.x, event.button.y, true);
+        }
+        if (event.type == SDL_EVENT_MOUSE_MOTION) {
+            return findObjectAt(event.motion.x, event.motion.y);
+        }
+        return nullptr;
+    }
 
     // Initializes the screen with optional actions
     // This function can be overridden by derived classes to provide specific initialization logic.
@@ -36,6 +96,13 @@ public:
         }
     }
 
+    // draw the scene retained-mode:
+    // nothing changed -> only the cached image is copied to the current target,
+    // otherwise only the objects intersecting the damaged regions are redrawn into the cache first
+    void renderScene(::SDL_Renderer* renderer);
+    // damage the whole screen, e.g. after background_color changed
+    void invalidate();
+
     // Runs the main loop of the screen
     virtual void run() = 0;
     virtual void render() = 0;
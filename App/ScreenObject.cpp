@@ -1,7 +1,18 @@
 #include "ScreenObject.hpp"
+#include "SpatialIndex.hpp"
+#include "DamageTracker.hpp"
 
 namespace Display {
 
+ScreenObject::~ScreenObject() {
+    if (spatial_index) {
+        spatial_index->remove(this);
+    }
+    if (damage_tracker) {
+        damage_tracker->forget(this);
+    }
+}
+
 void ScreenObject::setBasics(
     const Polygon& p, 
     bool visibility, 
@@ -14,11 +25,10 @@ void ScreenObject::setBasics(
     is_clickable = clickability;
 
     event_handler_func_ptr = nullptr;
-    ScreenObject::DrawFuncPtrT tmp = [this]()->void { 
-        this->polygon->draw();
-    };
+    draw_func = nullptr; // draw the polygon
 
     is_changeable = changeability;
+    helperNotifyGeometryChanged();
 }
 void ScreenObject::setAll(
     const Polygon& p, 
@@ -34,50 +44,114 @@ void ScreenObject::setAll(
     is_visible = visibility;
     is_clickable = clickability;
     is_changeable = changeability;
+    helperNotifyGeometryChanged();
 }
 
 void ScreenObject::setCentrePos(const SDL_FPoint& new_centre_pos) {
     helperThrowIfNonChangeable("setCentrePos");
     polygon->setCentrePos(new_centre_pos);
+    helperNotifyGeometryChanged();
 }
 void ScreenObject::setPolygonNumOfSides(const size_t &new_num_of_sides) {
     helperThrowIfNonChangeable("setPolygonNumOfSides");
     polygon->setNumOfSides(new_num_of_sides);
+    helperNotifyGeometryChanged();
 }
 void ScreenObject::setPolygonVertices(const std::vector<Vector2d> &vertices) {
     helperThrowIfNonChangeable("setPolygonVertices");
     polygon->setVertices(vertices);
+    helperNotifyGeometryChanged();
 }
 void ScreenObject::setPolygon(const Polygon& new_polygon) {
     helperThrowIfNonChangeable("setPolygon");
     polygon = std::make_unique<Polygon>(new_polygon);
     helperCheckIsPolygonNotNull();
     helperCheckPolygonWindowAndRenderer();
+    helperNotifyGeometryChanged();
 }
 void ScreenObject::setPolygon(Polygon* new_polygon) {
     helperThrowIfNonChangeable("setPolygon");
     polygon.reset(new_polygon);
     helperCheckIsPolygonNotNull();
     helperCheckPolygonWindowAndRenderer();
+    helperNotifyGeometryChanged();
 }
 
 void ScreenObject::setOutlineColor(const SDL_Color& new_outline_color) { 
     helperThrowIfNonChangeable("setOutlineColor");
     polygon->outline_color = new_outline_color;
+    markDirty();
 }
 void ScreenObject::setFillColor(const SDL_Color& new_fill_color) { 
     helperThrowIfNonChangeable("setOutlineColor");
     polygon->fill_color = new_fill_color; 
+    markDirty();
 }
 void ScreenObject::setVisibility(bool visible) { 
     helperThrowIfNonChangeable("setOutlineColor");
-    is_visible = visible; 
+    if (is_visible != visible) {
+        is_visible = visible;
+        markDirty();
+    }
 }
 void ScreenObject::setClickability(bool clickable) { 
     helperThrowIfNonChangeable("setOutlineColor");
     is_clickable = clickable; 
 }
 
+void ScreenObject::setLayer(int new_layer) {
+    helperThrowIfNonChangeable("setLayer");
+    if (layer != new_layer) {
+        layer = new_layer;
+        markDirty();
+    }
+}
+
+void ScreenObject::setSpatialIndex(SpatialIndex* arg_spatial_index) {
+    if (spatial_index == arg_spatial_index) {
+        return;
+    }
+    if (spatial_index) {
+        spatial_index->remove(this);
+    }
+    spatial_index = arg_spatial_index;
+    if (spatial_index) {
+        spatial_index->insert(this);
+    }
+}
+
+void ScreenObject::setDamageTracker(DamageTracker* arg_damage_tracker) {
+    if (damage_tracker == arg_damage_tracker) {
+        return;
+    }
+    if (parent) {
+        logAndThrow<std::logic_error>("setDamageTracker", "only top-level objects can have a damage tracker");
+    }
+    if (damage_tracker) {
+        damage_tracker->forget(this);
+    }
+    damage_tracker = arg_damage_tracker;
+    is_dirty = false;
+    markDirty(); // (re)draw it in the new tracker
+}
+
+void ScreenObject::markDirty() {
+    if (is_dirty) {
+        return; // already registered
+    }
+    is_dirty = true;
+    if (parent) {
+        parent->markDirty();
+    } else if (damage_tracker) {
+        damage_tracker->addDirty(this);
+    }
+}
+void ScreenObject::clearDirty() {
+    is_dirty = false;
+    has_been_drawn = is_visible;
+    drawn_bounds = getBoundingBox();
+}
+
 bool ScreenObject::isInside(int x, int y) const { 
     return polygon->isInside(x, y);
  }
@@ -149,6 +223,17 @@ void ScreenObject::helperCheckPolygonWindowAndRenderer() const {
     }
 }
 
+void ScreenObject::helperNotifyGeometryChanged() {
+    helperUpdateBounds();
+    if (spatial_index) {
+        spatial_index->update(this);
+    }
+    markDirty();
+    if (parent) {
+        parent->helperOnChildGeometryChanged();
+    }
+}
+
 void ScreenObject::helperThrowIfNonChangeable(const std::string& func_name) const {
     if (!is_changeable) {
         logAndThrow<std::logic_error>(
@@ -8,12 +8,18 @@
 #include <functional>
 #include <optional>
 #include "Polygon.hpp"
+#include "RenderQueue.hpp"
 
 namespace Display {
 
+class SpatialIndex; // forward declaration
+class DamageTracker; // forward declaration
 
 
 class ScreenObject {
+    friend class CompositeScreenObject; // sets parent of its children
+    friend class SpatialIndex; // clear() unregisters the objects
+
     using DrawFuncPtrT = std::function<void()>;
     typedef void (*EventHandlerFuncPtrT)();
 
@@ -26,7 +32,16 @@ class ScreenObject {
         bool is_visible = true;
         bool is_clickable = false;
         EventHandlerFuncPtrT event_handler_func_ptr = nullptr;
-        DrawFuncPtrT draw_func = nullptr; // the draw function
+        DrawFuncPtrT draw_func = nullptr; // custom draw function, nullptr -> draw the polygon
+        int layer = 0; // higher layers are drawn on top (see RenderQueue)
+        SpatialIndex* spatial_index = nullptr; // non-owning // the index this is registered in
+
+        // retained-mode state
+        ScreenObject* parent = nullptr; // non-owning // the composite this is a child of
+        DamageTracker* damage_tracker = nullptr; // non-owning // only top-level objects have one
+        bool is_dirty = false; // changed since it was last drawn
+        bool has_been_drawn = false; // drawn_bounds is valid
+        SDL_FRect drawn_bounds = {0, 0, 0, 0}; // where this was last drawn
         
         mutable bool is_changeable = true;
 
@@ -40,6 +55,14 @@ class ScreenObject {
         // throw
         void helperThrowIfNonChangeable(const std::string& func_name) const;
 
+        // re-bin this in spatial_index (if any) after the polygon moved or changed shape
+        // also marks this dirty and tells the parent
+        void helperNotifyGeometryChanged();
+        // called on the parent when the geometry of a child changed
+        virtual void helperOnChildGeometryChanged() {}
+        // recompute cached bounds before getBoundingBox is used (the polygon caches its own)
+        virtual void helperUpdateBounds() {}
+
         // private setters
 
         // void privateSetCentrePos(const SDL_FPoint& new_centre_pos);
@@ -66,7 +89,6 @@ class ScreenObject {
             try {
                 helperCheckWindowAndRenderer();
                 polygon = {std::make_unique<Polygon>(arg_window, arg_renderer)};
-                draw_func = [this](){ this->polygon->draw(); }; 
             } catch (std::exception& e) {
                 logAndThrow<Logger::SeeAbove>(
                     "ScreenObject constructor", 
@@ -75,6 +97,13 @@ class ScreenObject {
             }
         }
 
+        // the index holds a pointer to this
+        ScreenObject(const ScreenObject&) = delete; // disable copy constructor
+        ScreenObject& operator=(const ScreenObject&) = delete; // disable copy assignment
+
+        // removes this from spatial_index and damage_tracker (if any)
+        virtual ~ScreenObject();
+
         void setBasics(
             const Polygon& p, 
             bool visibility, 
@@ -103,10 +132,13 @@ class ScreenObject {
         const SDL_Renderer* getRenderer() const { return renderer; }
         const Polygon* getPolygon() const { return polygon.get(); }
         const SDL_FPoint& getCentrePos() const { return polygon->getCentrePos(); }
+        // world-space bounds of everything this draws
+        virtual const SDL_FRect& getBoundingBox() const { return polygon->getBoundingBox(); }
         const SDL_Color& getOutlineColor() const { return polygon->outline_color; }
         const SDL_Color& getFillColor() const { return polygon->fill_color; }
 
         bool getIsChangeable() const { return is_changeable; }
+        int getLayer() const { return layer; }
 
         // setters
         void setCentrePos(const SDL_FPoint& new_centre_pos);
@@ -119,15 +151,48 @@ class ScreenObject {
         void setFillColor(const SDL_Color& new_fill_color);
         void setVisibility(bool visible);
         void setClickability(bool clickable);
+        void setLayer(int new_layer);
 
         void setIsChangeable(bool new_is_changeable) { is_changeable = new_is_changeable; }
+        // register this in arg_spatial_index (nullptr to unregister)
+        // the index is notified whenever the geometry changes
+        void setSpatialIndex(SpatialIndex* arg_spatial_index);
+        const SpatialIndex* getSpatialIndex() const { return spatial_index; }
+        // register this in arg_damage_tracker (nullptr to unregister), this is marked dirty so it gets drawn
+        void setDamageTracker(DamageTracker* arg_damage_tracker);
+
+        // dirty tracking
+        // the flag propagates up to the top-level object, which registers in its damage_tracker
+        void markDirty();
+        bool isDirty() const noexcept { return is_dirty; }
+        // record the current bounds as drawn and clear the flag (of the whole subtree)
+        virtual void clearDirty();
+        bool hasBeenDrawn() const noexcept { return has_been_drawn; }
+        const SDL_FRect& getDrawnBounds() const noexcept { return drawn_bounds; }
+        const ScreenObject* getParent() const noexcept { return parent; }
         
         bool isInside(int x, int y) const;
         bool isFocusedByMouse(const SDL_Event& event) const;
         bool isClickedByMouse(const SDL_Event& event) const;
 
         void draw() const {
-            draw_func();
+            if (draw_func) {
+                draw_func();
+            } else {
+                polygon->draw();
+            }
+        }
+        // push the draw commands of this to queue (nothing if invisible)
+        // objects without a custom draw_func become plain fill/outline commands
+        virtual void submit(RenderQueue& queue) const {
+            if (!is_visible) {
+                return;
+            }
+            if (draw_func) {
+                queue.pushCustom(layer, &draw_func);
+            } else {
+                polygon->enqueue(queue, layer);
+            }
         }
         
         
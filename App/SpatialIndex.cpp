@@ -0,0 +1,169 @@
+#include "SpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ScreenObject.hpp"
+
+namespace Display {
+
+SpatialIndex::SpatialIndex(float arg_cell_size)
+    : cell_size(arg_cell_size)
+{
+    if (!(cell_size > 0) || !std::isfinite(cell_size)) {
+        logAndThrow<std::invalid_argument>(
+            "SpatialIndex(float arg_cell_size) /* constructor */",
+            "cell_size must be a positive finite value"
+        );
+    }
+}
+
+void SpatialIndex::insert(ScreenObject* obj) {
+    if (obj == nullptr) {
+        logAndThrow<std::invalid_argument>("insert(ScreenObject* obj)", "obj is null");
+    }
+    if (contains(obj)) {
+        logAndThrow<std::logic_error>("insert(ScreenObject* obj)", "obj has already been inserted");
+    }
+    CellRange range = helperGetCellRange(obj->getBoundingBox());
+    entries[obj] = Entry{obj, range, next_order++};
+    helperAddToCells(obj, range);
+}
+
+void SpatialIndex::update(ScreenObject* obj) {
+    auto it = entries.find(obj);
+    if (it == entries.end()) {
+        logAndThrow<std::logic_error>("update(ScreenObject* obj)", "obj has not been inserted");
+    }
+    CellRange new_range = helperGetCellRange(obj->getBoundingBox());
+    const CellRange& old_range = it->second.range;
+    if (new_range.min_col == old_range.min_col && new_range.min_row == old_range.min_row
+        && new_range.max_col == old_range.max_col && new_range.max_row == old_range.max_row
+    ) {
+        return; // still in the same cells
+    }
+    helperRemoveFromCells(obj, old_range);
+    helperAddToCells(obj, new_range);
+    it->second.range = new_range;
+}
+
+void SpatialIndex::remove(const ScreenObject* obj) {
+    auto it = entries.find(obj);
+    if (it == entries.end()) {
+        return;
+    }
+    helperRemoveFromCells(obj, it->second.range);
+    entries.erase(it);
+}
+
+void SpatialIndex::clear() noexcept {
+    // otherwise their next geometry change would update() an index they are no longer in
+    for (auto& [key, entry] : entries) {
+        if (entry.obj->spatial_index == this) {
+            entry.obj->spatial_index = nullptr;
+        }
+    }
+    cells.clear();
+    entries.clear();
+    next_order = 0;
+}
+
+const std::vector<ScreenObject*>& SpatialIndex::getCandidates(float x, float y) const {
+    auto it = cells.find(helperCellKey(
+        static_cast<int>(std::floor(x / cell_size)),
+        static_cast<int>(std::floor(y / cell_size))
+    ));
+    return (it == cells.end()) ? s_empty_cell : it->second;
+}
+
+ScreenObject* SpatialIndex::findTopmostAt(float x, float y, bool clickable_only) const {
+    ScreenObject* result = nullptr;
+    uint64_t result_order = 0;
+    for (ScreenObject* obj : getCandidates(x, y)) {
+        if (!obj->getVisibility() || (clickable_only && !obj->getClickability())) {
+            continue;
+        }
+        uint64_t order = entries.at(obj).order;
+        if (result != nullptr && order < result_order) {
+            continue; // cannot be on top of the current result
+        }
+        // exact test (Polygon::isInside rejects with the bounding box first)
+        if (obj->isInside(static_cast<int>(x), static_cast<int>(y))) {
+            result = obj;
+            result_order = order;
+        }
+    }
+    return result;
+}
+
+void SpatialIndex::queryRect(const ::SDL_FRect& rect, std::vector<ScreenObject*>& result) const {
+    CellRange range = helperGetCellRange(rect);
+    const size_t old_size = result.size();
+    for (int row = range.min_row; row <= range.max_row; ++row) {
+        for (int col = range.min_col; col <= range.max_col; ++col) {
+            auto it = cells.find(helperCellKey(col, row));
+            if (it == cells.end()) {
+                continue;
+            }
+            for (ScreenObject* obj : it->second) {
+                const ::SDL_FRect& box = obj->getBoundingBox();
+                if (box.x <= rect.x + rect.w && rect.x <= box.x + box.w
+                    && box.y <= rect.y + rect.h && rect.y <= box.y + box.h
+                ) {
+                    result.push_back(obj);
+                }
+            }
+        }
+    }
+    // objects spanning several cells are found more than once
+    std::sort(result.begin() + old_size, result.end(), [this](const ScreenObject* a, const ScreenObject* b) {
+        return entries.at(a).order < entries.at(b).order;
+    });
+    result.erase(std::unique(result.begin() + old_size, result.end()), result.end());
+}
+
+// private
+
+SpatialIndex::CellRange SpatialIndex::helperGetCellRange(const ::SDL_FRect& box) const noexcept {
+    return CellRange {
+        static_cast<int>(std::floor(box.x / cell_size)),
+        static_cast<int>(std::floor(box.y / cell_size)),
+        static_cast<int>(std::floor((box.x + box.w) / cell_size)),
+        static_cast<int>(std::floor((box.y + box.h) / cell_size))
+    };
+}
+
+uint64_t SpatialIndex::helperCellKey(int col, int row) noexcept {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(col)) << 32) | static_cast<uint32_t>(row);
+}
+
+void SpatialIndex::helperAddToCells(ScreenObject* obj, const CellRange& range) {
+    for (int row = range.min_row; row <= range.max_row; ++row) {
+        for (int col = range.min_col; col <= range.max_col; ++col) {
+            cells[helperCellKey(col, row)].push_back(obj);
+        }
+    }
+}
+
+void SpatialIndex::helperRemoveFromCells(const ScreenObject* obj, const CellRange& range) {
+    for (int row = range.min_row; row <= range.max_row; ++row) {
+        for (int col = range.min_col; col <= range.max_col; ++col) {
+            auto it = cells.find(helperCellKey(col, row));
+            if (it == cells.end()) {
+                continue;
+            }
+            std::vector<ScreenObject*>& cell = it->second;
+            auto jt = std::find(cell.begin(), cell.end(), obj);
+            if (jt != cell.end()) {
+                // order inside a cell does not matter (entries keep the insertion order)
+                *jt = cell.back();
+                cell.pop_back();
+            }
+            if (cell.empty()) {
+                cells.erase(it);
+            }
+        }
+    }
+}
+
+} // namespace Display
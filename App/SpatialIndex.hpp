@@ -0,0 +1,85 @@
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <unordered_map>
+
+#include "Logger.hpp"
+
+namespace Display {
+
+class ScreenObject; // forward declaration
+
+/*
+uniform grid over the bounding boxes of ScreenObjects
+each object is binned into every cell its bounding box touches,
+so a point query only looks at the objects of one cell
+and runs the exact (ray-casting) test on those candidates only
+note: it does not own the objects
+*/
+class SpatialIndex {
+private:
+    struct CellRange {
+        int min_col, min_row, max_col, max_row;
+    };
+    struct Entry {
+        ScreenObject* obj;
+        CellRange range;
+        uint64_t order; // insertion order, later ones are drawn on top
+    };
+
+    float cell_size;
+    uint64_t next_order = 0;
+    std::unordered_map<uint64_t, std::vector<ScreenObject*>> cells;
+    std::unordered_map<const ScreenObject*, Entry> entries;
+
+    static inline const std::vector<ScreenObject*> s_empty_cell {};
+
+public:
+    static constexpr float default_cell_size = 64.0f;
+
+    explicit SpatialIndex(float arg_cell_size = default_cell_size);
+
+    SpatialIndex(const SpatialIndex&) = delete; // disable copy constructor
+    SpatialIndex& operator=(const SpatialIndex&) = delete; // disable copy assignment
+
+    float getCellSize() const noexcept { return cell_size; }
+    size_t size() const noexcept { return entries.size(); }
+    bool contains(const ScreenObject* obj) const { return entries.find(obj) != entries.end(); }
+
+    void insert(ScreenObject* obj);
+    // re-bin obj after its geometry changed
+    // only touches the grid if the covered cells changed
+    void update(ScreenObject* obj);
+    void remove(const ScreenObject* obj);
+    // removes every object, their getSpatialIndex() becomes nullptr
+    void clear() noexcept;
+
+    // objects whose cell covers (x, y), the bounding boxes are not checked
+    const std::vector<ScreenObject*>& getCandidates(float x, float y) const;
+    // the topmost visible object which (x, y) is really inside (nullptr if none)
+    ScreenObject* findTopmostAt(float x, float y, bool clickable_only = false) const;
+    // all objects whose bounding box intersects rect (each object at most once)
+    void queryRect(const ::SDL_FRect& rect, std::vector<ScreenObject*>& result) const;
+
+private:
+    CellRange helperGetCellRange(const ::SDL_FRect& box) const noexcept;
+    static uint64_t helperCellKey(int col, int row) noexcept;
+    void helperAddToCells(ScreenObject* obj, const CellRange& range);
+    void helperRemoveFromCells(const ScreenObject* obj, const CellRange& range);
+
+    template <typename ExceptionType>
+    [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+        Logger::logAndThrow<ExceptionType>("SpatialIndex::" + where, what);
+    }
+};
+
+} // namespace Display
+
+#endif // SPATIAL_INDEX_HPP
@@ -0,0 +1,84 @@
+#ifndef BINARY_LOG_FORMAT_HPP
+#define BINARY_LOG_FORMAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*
+layout of the .binlog files written by Logger in LogFormat::Binary, read back by Tools/snake-logdump
+  file   = MAGIC, record*
+  record = RecordHeader (HEADER_SIZE bytes, little endian), payload (payload_size bytes)
+a SiteDefinition record maps site_id to its `where` text and comes before the first Entry
+using that id in the same file, an Entry record carries the raw `what` bytes
+*/
+namespace binary_log_ns {
+
+    constexpr std::string_view MAGIC = std::string_view("SNKLOG1\n", 8);
+
+    enum class RecordKind : uint8_t {
+        SiteDefinition = 1,
+        Entry = 2
+    };
+
+    enum RecordFlags : uint8_t {
+        FLAG_NONE = 0,
+        FLAG_HAS_TIMESTAMP = 1 // Logger::log(..., add_timestamp = true)
+    };
+
+    struct RecordHeader {
+        RecordKind kind = RecordKind::Entry;
+        uint8_t level = 0; // Logger::LogLevel
+        uint8_t flags = FLAG_NONE;
+        uint32_t site_id = 0;
+        int64_t unix_time_ns = 0; // std::chrono::system_clock
+        uint32_t payload_size = 0;
+    };
+
+    // kind(1) level(1) flags(1) reserved(1) site_id(4) unix_time_ns(8) payload_size(4)
+    constexpr size_t HEADER_SIZE = 20;
+
+    namespace detail {
+        template <typename T>
+        inline void storeLittleEndian(unsigned char* out, T value) noexcept {
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                out[i] = static_cast<unsigned char>(static_cast<uint64_t>(value) >> (8 * i));
+            }
+        }
+        template <typename T>
+        inline T loadLittleEndian(const unsigned char* in) noexcept {
+            uint64_t value = 0;
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                value |= static_cast<uint64_t>(in[i]) << (8 * i);
+            }
+            return static_cast<T>(value);
+        }
+    } // namespace detail
+
+    inline std::array<unsigned char, HEADER_SIZE> encodeHeader(const RecordHeader& header) noexcept {
+        std::array<unsigned char, HEADER_SIZE> out {};
+        out[0] = static_cast<unsigned char>(header.kind);
+        out[1] = header.level;
+        out[2] = header.flags;
+        out[3] = 0;
+        detail::storeLittleEndian(out.data() + 4, header.site_id);
+        detail::storeLittleEndian(out.data() + 8, header.unix_time_ns);
+        detail::storeLittleEndian(out.data() + 16, header.payload_size);
+        return out;
+    }
+
+    inline RecordHeader decodeHeader(const unsigned char* in) noexcept {
+        RecordHeader header;
+        header.kind = static_cast<RecordKind>(in[0]);
+        header.level = in[1];
+        header.flags = in[2];
+        header.site_id = detail::loadLittleEndian<uint32_t>(in + 4);
+        header.unix_time_ns = detail::loadLittleEndian<int64_t>(in + 8);
+        header.payload_size = detail::loadLittleEndian<uint32_t>(in + 16);
+        return header;
+    }
+
+} // namespace binary_log_ns
+
+#endif // BINARY_LOG_FORMAT_HPP
@@ -0,0 +1,203 @@
+#include "DeferredLog.hpp"
+#include "Logger.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace { // Anonymous namespace for private functions
+
+using deferred_log_ns::QUEUE_CAPACITY;
+using deferred_log_ns::Slot;
+using deferred_log_ns::Ticket;
+
+static_assert((QUEUE_CAPACITY & (QUEUE_CAPACITY - 1)) == 0, "QUEUE_CAPACITY must be a power of 2");
+
+constexpr std::chrono::milliseconds WAKE_INTERVAL(5);
+
+// bounded multi-producer queue (a slot's sequence tells whose turn it is) and its single writer thread
+class Writer {
+public:
+    Writer() : slots(new Slot[QUEUE_CAPACITY]) {
+        // the log sinks are function statics too: constructing them first makes them outlive this,
+        // so the destructor can still write out what is left in the queue
+        Logger::flush();
+        for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        thread = std::thread([this]() { helperRun(); });
+        writer_id = thread.get_id();
+    }
+
+    ~Writer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake_cv.notify_one();
+        thread.join();
+    }
+
+    Ticket tryClaim() noexcept {
+        size_t position = enqueue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position & (QUEUE_CAPACITY - 1)];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - position);
+            if (diff == 0) {
+                if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    return Ticket{&slot, position};
+                }
+            } else if (diff < 0) {
+                return Ticket{}; // full
+            } else {
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(const Ticket& ticket) noexcept {
+        ticket.slot->sequence.store(ticket.position + 1, std::memory_order_release);
+        if (ticket.position - dequeue_position.load(std::memory_order_relaxed) >= QUEUE_CAPACITY / 2) {
+            helperWake();
+        }
+    }
+
+    void drain() {
+        if (std::this_thread::get_id() == writer_id) {
+            return;
+        }
+        const size_t target = enqueue_position.load(std::memory_order_acquire);
+        helperWake();
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&]() { return dequeue_position.load(std::memory_order_acquire) >= target; });
+    }
+
+private:
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> enqueue_position {0};
+    alignas(64) std::atomic<size_t> dequeue_position {0};
+
+    std::mutex mutex;
+    std::condition_variable wake_cv;
+    std::condition_variable done_cv;
+    bool wake_requested = false;
+    bool stopping = false;
+
+    std::thread thread;
+    std::thread::id writer_id;
+
+    void helperWake() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            wake_requested = true;
+        }
+        wake_cv.notify_one();
+    }
+
+    // formats and logs the oldest published entry, false if there is none
+    bool helperWriteOne(std::string& what) {
+        const size_t position = dequeue_position.load(std::memory_order_relaxed);
+        Slot& slot = slots[position & (QUEUE_CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+        const char* where = slot.where;
+        const Logger::LogLevel lev = static_cast<Logger::LogLevel>(slot.level);
+        const bool add_timestamp = slot.add_timestamp;
+        const FlightRecorder::Origin origin = slot.origin;
+        what.clear();
+        try {
+            slot.format(what, slot.fmt, slot.args);
+        } catch (const std::exception& e) {
+            what.append("<logf formatting failed: ").append(e.what()).append(">");
+        }
+        slot.sequence.store(position + QUEUE_CAPACITY, std::memory_order_release);
+        dequeue_position.store(position + 1, std::memory_order_release);
+
+        try {
+            Logger::log(where, what, lev, add_timestamp, origin);
+        } catch (const std::exception&) {
+            // nobody to report to on this thread, the entry is lost
+        }
+        return true;
+    }
+
+    void helperRun() {
+        std::string what;
+        what.reserve(256);
+        while (true) {
+            bool wrote = false;
+            while (helperWriteOne(what)) {
+                wrote = true;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            if (wrote) {
+                done_cv.notify_all();
+            }
+            if (stopping) {
+                lock.unlock();
+                while (helperWriteOne(what)) {}
+                return;
+            }
+            wake_cv.wait_for(lock, WAKE_INTERVAL, [&]() { return wake_requested || stopping; });
+            wake_requested = false;
+        }
+    }
+};
+
+std::atomic<bool> s_writer_destroyed {false};
+
+// set once the first logf has started the writer
+std::atomic<Writer*> s_writer {nullptr};
+
+Writer* getWriter() {
+    Writer* writer = s_writer.load(std::memory_order_acquire);
+    if (writer != nullptr || s_writer_destroyed.load(std::memory_order_relaxed)) {
+        return writer;
+    }
+    struct WriterHolder {
+        Writer writer;
+        ~WriterHolder() {
+            s_writer.store(nullptr, std::memory_order_release);
+            s_writer_destroyed.store(true, std::memory_order_relaxed);
+        }
+    };
+    static WriterHolder holder;
+    s_writer.store(&holder.writer, std::memory_order_release);
+    return &holder.writer;
+}
+
+} // Anonymous namespace end
+
+
+namespace deferred_log_ns {
+
+    Ticket DeferredLog::tryClaim() noexcept {
+        Writer* writer = nullptr;
+        try {
+            writer = getWriter();
+        } catch (const std::exception&) {
+            // no thread could be started, the caller logs directly
+        }
+        return (writer == nullptr) ? Ticket{} : writer->tryClaim();
+    }
+
+    void DeferredLog::publish(const Ticket& ticket) noexcept {
+        Writer* writer = s_writer.load(std::memory_order_acquire);
+        if (writer != nullptr) {
+            writer->publish(ticket);
+        }
+    }
+
+    void DeferredLog::drain() {
+        Writer* writer = s_writer.load(std::memory_order_acquire);
+        if (writer != nullptr) {
+            writer->drain();
+        }
+    }
+
+} // namespace deferred_log_ns
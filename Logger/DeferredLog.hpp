@@ -0,0 +1,168 @@
+#ifndef DEFERRED_LOG_HPP
+#define DEFERRED_LOG_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "FlightRecorder.hpp"
+
+/*
+queue behind Logger::logf
+  - the caller copies its (trivially copyable) arguments into a fixed slot of a bounded queue,
+    nothing is formatted or allocated on its thread
+  - one writer thread, started by the first logf, replaces the "{}" of fmt with the arguments
+    and hands the text to Logger::log (indent, timestamp, FlightRecorder, file),
+    the FlightRecorder entry keeps the time and thread of the logf call
+  - where and fmt are kept as pointers, so they have to be string literals
+  - the writer wakes every few ms or when the queue is half full, so logf entries can land in the
+    file after Logger::log entries made a little later; Logger::flush() and the dump on ERROR
+    write the queue out first
+*/
+namespace deferred_log_ns {
+
+    constexpr size_t ARGS_CAPACITY = 96; // bytes of arguments one slot can hold
+    constexpr size_t ARGS_ALIGNMENT = 16;
+    constexpr size_t QUEUE_CAPACITY = 4096; // slots, power of 2
+
+    // rebuilds the message from fmt and the argument bytes Logger::logf wrote into a slot
+    using FormatFn = void (*)(std::string& out, const char* fmt, const unsigned char* args);
+
+    struct Slot {
+        std::atomic<size_t> sequence {0};
+        const char* where = nullptr;
+        const char* fmt = nullptr;
+        FormatFn format = nullptr;
+        int level = 0;
+        bool add_timestamp = true;
+        FlightRecorder::Origin origin; // of the logf call, for the FlightRecorder entry made by the writer
+        alignas(ARGS_ALIGNMENT) unsigned char args[ARGS_CAPACITY];
+    };
+
+    // a claimed slot, filled by the caller then published
+    struct Ticket {
+        Slot* slot = nullptr;
+        size_t position = 0;
+    };
+
+    class DeferredLog {
+    public:
+        // slot for one entry, slot == nullptr if the queue is full or there is no writer thread
+        static Ticket tryClaim() noexcept;
+        // hands a filled slot to the writer thread
+        static void publish(const Ticket& ticket) noexcept;
+        // returns once every entry published before the call has been written
+        // no-op if the writer never started or if called from the writer
+        static void drain();
+    };
+
+    namespace detail {
+
+        inline constexpr size_t alignUp(size_t offset, size_t alignment) noexcept {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        template <typename... Args>
+        inline constexpr size_t packedSize() noexcept {
+            size_t offset = 0;
+            ((offset = alignUp(offset, alignof(Args)) + sizeof(Args)), ...);
+            return offset;
+        }
+
+        template <typename T, typename = void>
+        struct HasToString : std::false_type {};
+        template <typename T>
+        struct HasToString<T, std::void_t<decltype(std::declval<const T&>().to_string())>> : std::true_type {};
+
+        template <typename T>
+        inline constexpr bool isLoggableArg() noexcept {
+            return std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_array_v<T>
+                && (std::is_arithmetic_v<T> || std::is_enum_v<T> || HasToString<T>::value);
+        }
+
+        template <typename T>
+        inline void appendArg(std::string& out, const T& value) {
+            if constexpr (std::is_same_v<T, char>) {
+                out.push_back(value);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                out.append(std::to_string(value));
+            } else if constexpr (std::is_enum_v<T>) {
+                out.append(std::to_string(static_cast<std::underlying_type_t<T>>(value)));
+            } else {
+                out.append(value.to_string());
+            }
+        }
+
+        template <typename T>
+        inline void writeArg(unsigned char* args, size_t& offset, const T& value) noexcept {
+            offset = alignUp(offset, alignof(T));
+            std::memcpy(args + offset, &value, sizeof(T));
+            offset += sizeof(T);
+        }
+
+        template <typename T>
+        inline const T& readArg(const unsigned char* args, size_t& offset) noexcept {
+            offset = alignUp(offset, alignof(T));
+            const T* value = std::launder(reinterpret_cast<const T*>(args + offset));
+            offset += sizeof(T);
+            return *value;
+        }
+
+        // copies fmt up to the next "{}" into out, returns the rest after it (nullptr if none)
+        inline const char* appendUntilPlaceholder(std::string& out, const char* fmt) {
+            if (fmt == nullptr) {
+                return nullptr;
+            }
+            const char* placeholder = std::strstr(fmt, "{}");
+            if (placeholder == nullptr) {
+                out.append(fmt);
+                return nullptr;
+            }
+            out.append(fmt, static_cast<size_t>(placeholder - fmt));
+            return placeholder + 2;
+        }
+
+        // placeholders past the last argument stay as they are, arguments past the last placeholder are dropped
+        template <typename... Args>
+        void formatPacked(std::string& out, const char* fmt, const unsigned char* args) {
+            size_t offset = 0;
+            const char* rest = fmt;
+            bool has_placeholder = true;
+            auto appendNext = [&](const auto& value) {
+                if (!has_placeholder) {
+                    return;
+                }
+                rest = appendUntilPlaceholder(out, rest);
+                if (rest == nullptr) {
+                    has_placeholder = false;
+                    return;
+                }
+                appendArg(out, value);
+            };
+            (appendNext(readArg<Args>(args, offset)), ...);
+            if (has_placeholder && rest != nullptr) {
+                out.append(rest);
+            }
+        }
+
+        // Decorator::decorate(std::string message) wraps the formatted message (e.g. Game's prefix)
+        template <typename Decorator, typename... Args>
+        void formatDecorated(std::string& out, const char* fmt, const unsigned char* args) {
+            size_t offset = 0;
+            const Decorator& decorator = readArg<Decorator>(args, offset);
+            std::string message;
+            formatPacked<Args...>(message, fmt, args + alignUp(sizeof(Decorator), ARGS_ALIGNMENT));
+            out.append(decorator.decorate(std::move(message)));
+        }
+
+    } // namespace detail
+
+} // namespace deferred_log_ns
+
+#endif // DEFERRED_LOG_HPP
@@ -0,0 +1,366 @@
+#include "FlightRecorder.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace { // Anonymous namespace for private functions
+
+struct Slot {
+    std::atomic<uint64_t> sequence {0}; // 2n + 2 once entry n is complete, odd while it is written
+    int64_t unix_time_ns = 0;
+    uint16_t thread_number = 0;
+    uint16_t where_size = 0;
+    uint16_t what_size = 0;
+    uint8_t level = 0;
+    bool add_timestamp = false;
+    char text[FlightRecorder::TEXT_CAPACITY]; // where, then what
+};
+
+// written by its owner thread only, read by dumps (seqlock: a slot being rewritten is skipped)
+struct Ring {
+    std::array<Slot, FlightRecorder::ENTRIES_PER_THREAD> slots;
+    std::atomic<uint64_t> next {0}; // number of entries ever recorded
+    std::atomic<bool> is_owned {true}; // false once the owner thread exits, another thread may take it
+    uint64_t dumped_until = 0; // entries before this were in a dump
+};
+
+struct SlotCopy {
+    int64_t unix_time_ns;
+    uint16_t thread_number;
+    uint16_t where_size;
+    uint16_t what_size;
+    uint8_t level;
+    bool add_timestamp;
+    char text[FlightRecorder::TEXT_CAPACITY];
+};
+
+// fixed table so the signal handler can walk it without locks, rings are never freed
+std::array<std::atomic<Ring*>, FlightRecorder::MAX_THREADS> g_rings {};
+std::atomic<size_t> g_next_ring_index {0};
+std::atomic<uint16_t> g_next_thread_number {0};
+
+std::mutex g_dump_mutex;
+std::atomic_flag g_is_crash_dumped = ATOMIC_FLAG_INIT;
+char g_crash_path[512] = "logs/crash.log";
+
+struct RingOwner {
+    Ring* ring = nullptr;
+    bool has_tried = false;
+    uint16_t thread_number = 0;
+    ~RingOwner() {
+        if (ring) {
+            ring->is_owned.store(false, std::memory_order_release);
+        }
+    }
+};
+
+Ring* localRing(uint16_t& thread_number) noexcept {
+    thread_local RingOwner owner;
+    thread_number = owner.thread_number;
+    if (owner.ring || owner.has_tried) {
+        return owner.ring;
+    }
+    owner.has_tried = true;
+    owner.thread_number = thread_number = g_next_thread_number.fetch_add(1, std::memory_order_relaxed);
+    // take the ring of a thread that has exited
+    for (std::atomic<Ring*>& entry : g_rings) {
+        Ring* ring = entry.load(std::memory_order_acquire);
+        bool expected = false;
+        if (ring && ring->is_owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return owner.ring = ring;
+        }
+    }
+    const size_t index = g_next_ring_index.fetch_add(1, std::memory_order_relaxed);
+    if (index >= FlightRecorder::MAX_THREADS) {
+        return nullptr;
+    }
+    Ring* ring = new (std::nothrow) Ring();
+    if (ring) {
+        g_rings[index].store(ring, std::memory_order_release);
+    }
+    return owner.ring = ring;
+}
+
+bool readSlot(const Ring& ring, uint64_t n, SlotCopy& out) noexcept {
+    const Slot& slot = ring.slots[n % FlightRecorder::ENTRIES_PER_THREAD];
+    const uint64_t expected = 2 * n + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+        return false; // overwritten by a newer entry, or being written
+    }
+    out.unix_time_ns = slot.unix_time_ns;
+    out.thread_number = slot.thread_number;
+    // the sizes may be torn by a concurrent rewrite (caught by the recheck below), keep the copy in bounds anyway
+    out.where_size = static_cast<uint16_t>(std::min<size_t>(slot.where_size, FlightRecorder::TEXT_CAPACITY));
+    out.what_size = static_cast<uint16_t>(std::min<size_t>(slot.what_size, FlightRecorder::TEXT_CAPACITY - out.where_size));
+    out.level = slot.level;
+    out.add_timestamp = slot.add_timestamp;
+    std::memcpy(out.text, slot.text, static_cast<size_t>(out.where_size) + out.what_size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == expected;
+}
+
+// [first, end) of the entries of ring that are still in it and not dumped yet
+void undumpedRange(const Ring& ring, uint64_t& first, uint64_t& end) noexcept {
+    end = ring.next.load(std::memory_order_acquire);
+    first = (end > FlightRecorder::ENTRIES_PER_THREAD) ? end - FlightRecorder::ENTRIES_PER_THREAD : 0;
+    first = std::max(first, ring.dumped_until);
+}
+
+std::tm toLocalTime(int64_t unix_time_ns) {
+    const std::time_t seconds = static_cast<std::time_t>(unix_time_ns / 1000000000);
+    std::tm local_time;
+#ifdef _MSC_VER
+    localtime_s(&local_time, &seconds);
+#else
+    localtime_r(&seconds, &local_time);
+#endif
+    return local_time;
+}
+
+// async-signal-safe output for dumpForCrash
+
+void writeAll(int fd, const char* data, size_t size) noexcept {
+    while (size > 0) {
+#ifdef _WIN32
+        const int written = _write(fd, data, static_cast<unsigned int>(size));
+#else
+        const ssize_t written = ::write(fd, data, size);
+#endif
+        if (written <= 0) {
+            return;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void writeText(int fd, const char* text) noexcept {
+    writeAll(fd, text, std::strlen(text));
+}
+
+void writeNumber(int fd, uint64_t value) noexcept {
+    char digits[24];
+    size_t i = sizeof(digits);
+    do {
+        digits[--i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    writeAll(fd, digits + i, sizeof(digits) - i);
+}
+
+const char* levelName(uint8_t level) noexcept {
+    static const char* const NAMES[] = {"[debug]", "[INFO]", "[WARNING_LOW]", "[WARNING_MID]", "[*WARNING_HIGH]", "[***ERROR***]"};
+    return level < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[level] : "[UNKNOWN]";
+}
+
+void handleFatalSignal(int signal_number) {
+    const char* name = "fatal signal";
+    switch (signal_number) {
+        case SIGSEGV: name = "SIGSEGV"; break;
+        case SIGABRT: name = "SIGABRT"; break;
+        case SIGFPE: name = "SIGFPE"; break;
+        case SIGILL: name = "SIGILL"; break;
+#ifdef SIGBUS
+        case SIGBUS: name = "SIGBUS"; break;
+#endif
+        default: break;
+    }
+    FlightRecorder::dumpForCrash(name);
+    std::signal(signal_number, SIG_DFL);
+    std::raise(signal_number);
+}
+
+void handleTerminate() {
+    // not a signal handler, the reason may allocate
+    std::string reason = "std::terminate";
+    if (std::exception_ptr exception = std::current_exception()) {
+        try {
+            std::rethrow_exception(exception);
+        } catch (const std::exception& e) {
+            reason.append(", uncaught exception: ").append(e.what());
+        } catch (...) {
+            reason.append(", uncaught exception of unknown type");
+        }
+    }
+    FlightRecorder::dumpForCrash(reason.c_str());
+    std::signal(SIGABRT, SIG_DFL); // already dumped
+    std::abort();
+}
+
+} // Anonymous namespace end
+
+
+FlightRecorder::Origin FlightRecorder::currentOrigin() noexcept {
+    Origin origin;
+    localRing(origin.thread_number);
+    origin.unix_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    return origin;
+}
+
+void FlightRecorder::record(std::string_view where, std::string_view what, int level, bool add_timestamp) noexcept {
+    record(where, what, level, add_timestamp, currentOrigin());
+}
+
+void FlightRecorder::record(
+    std::string_view where, std::string_view what, int level, bool add_timestamp, const Origin& origin
+) noexcept {
+    uint16_t thread_number; // of the recording thread, its ring takes the entry
+    Ring* ring = localRing(thread_number);
+    if (!ring) {
+        return;
+    }
+    const uint64_t n = ring->next.load(std::memory_order_relaxed);
+    Slot& slot = ring->slots[n % ENTRIES_PER_THREAD];
+    slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t where_size = std::min(where.size(), TEXT_CAPACITY);
+    const size_t what_size = std::min(what.size(), TEXT_CAPACITY - where_size);
+    slot.unix_time_ns = origin.unix_time_ns;
+    slot.thread_number = origin.thread_number;
+    slot.where_size = static_cast<uint16_t>(where_size);
+    slot.what_size = static_cast<uint16_t>(what_size);
+    slot.level = static_cast<uint8_t>(level);
+    slot.add_timestamp = add_timestamp;
+    std::memcpy(slot.text, where.data(), where_size);
+    std::memcpy(slot.text + where_size, what.data(), what_size);
+
+    slot.sequence.store(2 * n + 2, std::memory_order_release);
+    ring->next.store(n + 1, std::memory_order_release);
+}
+
+std::string FlightRecorder::collectText(std::string_view reason) {
+    std::lock_guard<std::mutex> lock(g_dump_mutex);
+    std::vector<SlotCopy> entries;
+    for (std::atomic<Ring*>& entry : g_rings) {
+        Ring* ring = entry.load(std::memory_order_acquire);
+        if (!ring) {
+            continue;
+        }
+        uint64_t first, end;
+        undumpedRange(*ring, first, end);
+        SlotCopy copy;
+        for (uint64_t n = first; n < end; ++n) {
+            if (readSlot(*ring, n, copy)) {
+                entries.push_back(copy);
+            }
+        }
+        ring->dumped_until = end;
+    }
+    if (entries.empty()) {
+        return "";
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const SlotCopy& a, const SlotCopy& b) {
+        return a.unix_time_ns < b.unix_time_ns;
+    });
+
+    std::string text;
+    text.reserve(entries.size() * 128);
+    text.append("---- flight recorder: ").append(reason)
+        .append(", ").append(std::to_string(entries.size())).append(" entries ----");
+    for (const SlotCopy& copy : entries) {
+        const std::string where = "<thread " + std::to_string(copy.thread_number) + "> "
+            + std::string(copy.text, copy.where_size);
+        text.append("\n").append(Logger::formatTextEntry(
+            toLocalTime(copy.unix_time_ns),
+            where,
+            std::string_view(copy.text + copy.where_size, copy.what_size),
+            static_cast<Logger::LogLevel>(copy.level),
+            copy.add_timestamp
+        ));
+    }
+    text.append("\n---- flight recorder end ----");
+    return text;
+}
+
+void FlightRecorder::installCrashHandlers() {
+    try {
+        const std::filesystem::path path = std::filesystem::absolute("logs/crash.log");
+        std::filesystem::create_directories(path.parent_path());
+        const std::string path_str = path.string();
+        if (path_str.size() < sizeof(g_crash_path)) {
+            std::memcpy(g_crash_path, path_str.c_str(), path_str.size() + 1);
+        }
+    } catch (const std::exception&) {
+        // keep the relative path
+    }
+    std::set_terminate(handleTerminate);
+    std::signal(SIGSEGV, handleFatalSignal);
+    std::signal(SIGABRT, handleFatalSignal);
+    std::signal(SIGFPE, handleFatalSignal);
+    std::signal(SIGILL, handleFatalSignal);
+#ifdef SIGBUS
+    std::signal(SIGBUS, handleFatalSignal);
+#endif
+}
+
+void FlightRecorder::dumpForCrash(const char* reason) noexcept {
+    if (g_is_crash_dumped.test_and_set()) {
+        return; // e.g. SIGABRT from the abort of handleTerminate
+    }
+#ifdef _WIN32
+    const int fd = _open(g_crash_path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, 0644);
+#else
+    const int fd = ::open(g_crash_path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+    if (fd < 0) {
+        return;
+    }
+    writeText(fd, "---- flight recorder: ");
+    writeText(fd, reason);
+    writeText(fd, " ----\n");
+    SlotCopy copy;
+    for (std::atomic<Ring*>& entry : g_rings) {
+        Ring* ring = entry.load(std::memory_order_acquire);
+        if (!ring) {
+            continue;
+        }
+        uint64_t first, end;
+        undumpedRange(*ring, first, end);
+        for (uint64_t n = first; n < end; ++n) {
+            if (!readSlot(*ring, n, copy)) {
+                continue;
+            }
+            // time as unix ns: localtime is not async-signal-safe
+            writeText(fd, "[");
+            writeNumber(fd, static_cast<uint64_t>(copy.unix_time_ns));
+            writeText(fd, "] ");
+            writeText(fd, levelName(copy.level));
+            writeText(fd, " <thread ");
+            writeNumber(fd, copy.thread_number);
+            writeText(fd, "> ");
+            writeAll(fd, copy.text, copy.where_size);
+            writeText(fd, "\n    ");
+            writeAll(fd, copy.text + copy.where_size, copy.what_size);
+            writeText(fd, "\n");
+        }
+        ring->dumped_until = end;
+    }
+    writeText(fd, "---- flight recorder end ----\n");
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
@@ -0,0 +1,49 @@
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+the last entries of every level, per thread, in memory only
+  - each thread writes its own fixed ring (no lock, no allocation after the first entry, no I/O)
+  - Logger dumps the rings (all threads, by time) into the log when an ERROR is logged
+  - installCrashHandlers(): std::terminate (e.g. an exception leaving main) and fatal signals
+    dump them to logs/crash.log first
+a dump only has the entries recorded since the previous dump
+*/
+class FlightRecorder {
+public:
+    static constexpr size_t ENTRIES_PER_THREAD = 256;
+    static constexpr size_t TEXT_CAPACITY = 224; // where + what of one entry, longer ones are cut
+    static constexpr size_t MAX_THREADS = 64; // threads past this (while all others live) are not recorded
+
+    // when and on which thread an entry was made
+    struct Origin {
+        int64_t unix_time_ns = 0;
+        uint16_t thread_number = 0;
+    };
+    // now, on the calling thread
+    static Origin currentOrigin() noexcept;
+
+    // called by Logger::log for every entry, before the level threshold
+    static void record(std::string_view where, std::string_view what, int level, bool add_timestamp) noexcept;
+    // for an entry recorded by another thread than the one that made it (logf's writer thread)
+    static void record(
+        std::string_view where, std::string_view what, int level, bool add_timestamp, const Origin& origin
+    ) noexcept;
+
+    // entries recorded since the last dump, oldest first, formatted as Logger::formatTextEntry
+    // empty if there are none
+    static std::string collectText(std::string_view reason);
+
+    // std::set_terminate and SIGSEGV/SIGABRT/SIGFPE/SIGILL(/SIGBUS) handlers, call once at the start of main
+    static void installCrashHandlers();
+
+    // the dump of the crash handlers, only async-signal-safe calls
+    static void dumpForCrash(const char* reason) noexcept;
+};
+
+#endif // FLIGHT_RECORDER_HPP
@@ -0,0 +1,150 @@
+#include "LogRateLimiter.hpp"
+
+#include <algorithm>
+
+namespace { // Anonymous namespace for private functions
+
+constexpr int WARNING_LOW_LEVEL = 2;
+constexpr int WARNING_HIGH_LEVEL = 4;
+constexpr int ERROR_LEVEL = 5;
+
+// warnings repeated every frame or per element should not slow the game down further
+constexpr LogLimit DEFAULT_WARNING_LIMIT {10, 20, 1};
+
+bool isValidLevel(int level) {
+    return level >= 0 && level < LogRateLimiter::NUM_OF_LEVELS;
+}
+
+} // Anonymous namespace end
+
+
+LogRateLimiter::LogRateLimiter() {
+    for (int level = WARNING_LOW_LEVEL; level <= WARNING_HIGH_LEVEL; ++level) {
+        rules[level].push_back(Rule{"", DEFAULT_WARNING_LIMIT});
+    }
+    helperUpdateHasLimits();
+}
+
+void LogRateLimiter::setLimit(std::string_view where_prefix, int level, const LogLimit& limit) {
+    if (!isValidLevel(level) || level == ERROR_LEVEL) {
+        return; // ERROR always gets through
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Rule>& level_rules = rules[level];
+    auto found = std::find_if(level_rules.begin(), level_rules.end(),
+        [&](const Rule& rule) { return rule.where_prefix == where_prefix; });
+    if (found != level_rules.end()) {
+        found->limit = limit;
+    } else {
+        level_rules.push_back(Rule{std::string(where_prefix), limit});
+    }
+    ++rules_version;
+    helperUpdateHasLimits();
+}
+
+void LogRateLimiter::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::vector<Rule>& level_rules : rules) {
+        level_rules.clear();
+    }
+    ++rules_version;
+    helperUpdateHasLimits();
+}
+
+bool LogRateLimiter::allow(std::string_view where, int level, Clock::time_point now) {
+    if (!hasLimits(level) || level == ERROR_LEVEL) {
+        return true; // no lock and no lookup for the levels without rules (INFO, DEBUG by default)
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size_t site_index;
+    auto found = site_indices.find(where);
+    if (found != site_indices.end()) {
+        site_index = found->second;
+    } else {
+        if (sites.size() >= MAX_SITES) {
+            return true;
+        }
+        site_index = sites.size();
+        site_texts.emplace_back(where);
+        site_indices.emplace(site_texts.back(), site_index);
+        sites.emplace_back();
+    }
+
+    SiteLevel& state = sites[site_index].levels[level];
+    if (state.rules_version != rules_version) {
+        state.rules_version = rules_version;
+        state.limit = helperResolve(where, level);
+        state.tokens = state.limit.burst;
+        state.last_refill = now;
+    }
+    if (state.limit.isUnlimited()) {
+        return true;
+    }
+
+    const uint64_t nth = state.seen++;
+    bool is_allowed = (state.limit.sample_one_in <= 1 || nth % state.limit.sample_one_in == 0);
+    if (is_allowed && state.limit.per_second > 0) {
+        const double elapsed_s = std::chrono::duration<double>(now - state.last_refill).count();
+        state.tokens = std::min(state.limit.burst, state.tokens + elapsed_s * state.limit.per_second);
+        state.last_refill = now;
+        if (state.tokens >= 1) {
+            state.tokens -= 1;
+        } else {
+            is_allowed = false;
+        }
+    }
+    if (!is_allowed) {
+        ++state.suppressed;
+        has_suppressed.store(true, std::memory_order_relaxed);
+    }
+    return is_allowed;
+}
+
+std::vector<LogRateLimiter::Suppressed> LogRateLimiter::takeSuppressed(
+    Clock::time_point now, Clock::duration interval, bool force
+) {
+    std::vector<Suppressed> result;
+    if (!hasSuppressed()) {
+        return result;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!has_suppressed.load(std::memory_order_relaxed) || (!force && now - last_hand_out < interval)) {
+        return result;
+    }
+    for (size_t i = 0; i < sites.size(); ++i) {
+        for (int level = 0; level < NUM_OF_LEVELS; ++level) {
+            SiteLevel& state = sites[i].levels[level];
+            if (state.suppressed > 0) {
+                result.push_back(Suppressed{site_texts[i], level, state.suppressed});
+                state.suppressed = 0;
+            }
+        }
+    }
+    has_suppressed.store(false, std::memory_order_relaxed);
+    last_hand_out = now;
+    return result;
+}
+
+// private
+
+LogLimit LogRateLimiter::helperResolve(std::string_view where, int level) const {
+    const Rule* best = nullptr;
+    for (const Rule& rule : rules[level]) {
+        const bool matches = where.substr(0, rule.where_prefix.size()) == rule.where_prefix;
+        if (matches && (best == nullptr || rule.where_prefix.size() > best->where_prefix.size())) {
+            best = &rule;
+        }
+    }
+    return (best == nullptr) ? LogLimit{} : best->limit;
+}
+
+void LogRateLimiter::helperUpdateHasLimits() {
+    for (int level = 0; level < NUM_OF_LEVELS; ++level) {
+        bool any = false;
+        for (const Rule& rule : rules[level]) {
+            any = any || !rule.limit.isUnlimited();
+        }
+        level_has_limits[level].store(any, std::memory_order_relaxed);
+    }
+}
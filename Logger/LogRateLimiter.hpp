@@ -0,0 +1,98 @@
+#ifndef LOG_RATE_LIMITER_HPP
+#define LOG_RATE_LIMITER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../Utils/utils.hpp"
+
+// how many entries of one call site (`where`) at one level get into the log
+struct LogLimit {
+    double per_second = 0; // token bucket refill, 0: no bucket
+    double burst = 1; // bucket size, the entries that pass at once after a quiet time
+    uint32_t sample_one_in = 1; // only the 1st, (N+1)th, ... entry of the site gets to the bucket
+
+    bool isUnlimited() const noexcept { return per_second <= 0 && sample_one_in <= 1; }
+};
+
+/*
+per call site limits of Logger, checked after the level threshold
+  - rules are per level, each with a `where` prefix ("" for the whole level), the longest
+    matching prefix wins
+  - a call site is a `where` text, its state (bucket, counters) is kept per level
+  - suppressed entries are counted per site and level, takeSuppressed() hands the counts out
+    once per interval so that Logger can write one summary entry for them
+thread-safe (one mutex), a level without rules returns before taking it
+*/
+class LogRateLimiter {
+public:
+    using Clock = Utils::Time::Clock;
+
+    static constexpr int NUM_OF_LEVELS = 6; // Logger::LogLevel DEBUG..ERROR
+    static constexpr size_t MAX_SITES = 4096; // sites past this are not limited
+
+    struct Suppressed {
+        std::string where;
+        int level;
+        uint64_t count;
+    };
+
+    LogRateLimiter();
+
+    void setLimit(std::string_view where_prefix, int level, const LogLimit& limit);
+    void clear();
+
+    bool hasLimits(int level) const noexcept {
+        return level >= 0 && level < NUM_OF_LEVELS && level_has_limits[level].load(std::memory_order_relaxed);
+    }
+    // whether takeSuppressed() has anything to hand out (once its interval has passed)
+    bool hasSuppressed() const noexcept { return has_suppressed.load(std::memory_order_relaxed); }
+
+    // whether the entry goes into the log, counts it as suppressed otherwise
+    bool allow(std::string_view where, int level, Clock::time_point now);
+
+    // counts suppressed since the last hand-out, empty before `interval` has passed (unless force)
+    std::vector<Suppressed> takeSuppressed(Clock::time_point now, Clock::duration interval, bool force = false);
+
+private:
+    struct Rule {
+        std::string where_prefix;
+        LogLimit limit;
+    };
+    struct SiteLevel {
+        uint64_t rules_version = 0; // limit below is resolved for this version of the rules
+        LogLimit limit;
+        double tokens = 0;
+        Clock::time_point last_refill;
+        uint64_t seen = 0;
+        uint64_t suppressed = 0;
+    };
+    struct Site {
+        std::array<SiteLevel, NUM_OF_LEVELS> levels;
+    };
+
+    std::mutex mutex;
+    std::array<std::atomic<bool>, NUM_OF_LEVELS> level_has_limits {};
+    std::array<std::vector<Rule>, NUM_OF_LEVELS> rules;
+    uint64_t rules_version = 1;
+
+    std::deque<std::string> site_texts; // stable storage for the keys of site_indices
+    std::unordered_map<std::string_view, size_t> site_indices;
+    std::vector<Site> sites;
+    std::atomic<bool> has_suppressed {false};
+    Clock::time_point last_hand_out = Clock::now();
+
+    LogLimit helperResolve(std::string_view where, int level) const;
+    void helperUpdateHasLimits();
+};
+
+#endif // LOG_RATE_LIMITER_HPP
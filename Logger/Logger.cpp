@@ -1,8 +1,15 @@
 #include "Logger.hpp"
+#include "BinaryLogFormat.hpp"
+#include "FlightRecorder.hpp"
+#include "Metrics.hpp"
+#include "RotatingFileSink.hpp"
+#include "Trace.hpp"
 #include "../Utils/StringUtils.hpp"
+#include "../Utils/utils.hpp"
+#include <array>
+#include <chrono>
+#include <deque>
 #include <iostream>
-#include <filesystem>
-#include <fstream>
 #include <ctime>
 #include <string>
 #include <unordered_map>
@@ -10,6 +17,79 @@
 #include <typeindex>
 #include <mutex>
 #include <cassert>
+#include <vector>
+
+namespace { // Anonymous namespace for private functions
+
+// logs/<date>.log, guarded by Logger::s_logtofile_mutex
+RotatingFileSink& textLogSink() {
+    static RotatingFileSink sink("logs", ".log");
+    return sink;
+}
+
+// file and call site table of LogFormat::Binary, guarded by binaryLogMutex()
+struct BinaryLogState {
+    RotatingFileSink sink {"logs", ".binlog", true};
+    uint64_t sink_generation = 0; // the file the site definitions below were written to
+
+    std::deque<std::string> site_texts; // stable storage for the keys of site_ids
+    std::unordered_map<std::string_view, uint32_t> site_ids;
+    std::vector<bool> is_site_in_file; // SiteDefinition already written to the current file
+};
+
+BinaryLogState& binaryLogState() {
+    static BinaryLogState state;
+    return state;
+}
+
+std::mutex& binaryLogMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+LogRateLimiter& rateLimiter() {
+    static LogRateLimiter limiter;
+    return limiter;
+}
+
+struct LoggerMetrics {
+    std::array<MetricCounter*, LogRateLimiter::NUM_OF_LEVELS> entries_written;
+    MetricCounter* entries_dropped;
+    MetricCounter* text_bytes_written;
+    MetricCounter* binary_bytes_written;
+    MetricHistogram* flush_duration_us;
+};
+
+LoggerMetrics& loggerMetrics() {
+    static LoggerMetrics metrics = []() {
+        static const char* const LEVEL_LABELS[LogRateLimiter::NUM_OF_LEVELS] = {
+            "level=\"DEBUG\"", "level=\"INFO\"", "level=\"WARNING_LOW\"",
+            "level=\"WARNING_MID\"", "level=\"WARNING_HIGH\"", "level=\"ERROR\""
+        };
+        LoggerMetrics result {};
+        for (int level = 0; level < LogRateLimiter::NUM_OF_LEVELS; ++level) {
+            result.entries_written[level] = &Metrics::counter(
+                "log_entries_written_total", "log entries past the threshold and the rate limits", LEVEL_LABELS[level]);
+        }
+        result.entries_dropped = &Metrics::counter("log_entries_dropped_total", "log entries left out by the rate limits");
+        result.text_bytes_written = &Metrics::counter("log_bytes_written_total", "bytes given to the log files", "format=\"text\"");
+        result.binary_bytes_written = &Metrics::counter("log_bytes_written_total", "bytes given to the log files", "format=\"binary\"");
+        result.flush_duration_us = &Metrics::histogram(
+            "log_flush_duration_us", "time of Logger::flush, in microseconds", {10, 100, 1000, 10000, 100000});
+        return result;
+    }();
+    return metrics;
+}
+
+void writeBinaryRecord(RotatingFileSink& sink, const binary_log_ns::RecordHeader& header, std::string_view payload) {
+    const std::array<unsigned char, binary_log_ns::HEADER_SIZE> bytes = binary_log_ns::encodeHeader(header);
+    sink.write(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+    sink.write(payload);
+}
+
+static_assert(Logger::ERROR + 1 == LogRateLimiter::NUM_OF_LEVELS, "LogRateLimiter::NUM_OF_LEVELS is out of date");
+
+} // Anonymous namespace end
 
 
 std::unordered_map<std::type_index, std::string> Logger::s_typeid_to_str_map = Logger::initTypeidToStrMap();
@@ -37,36 +117,29 @@ std::unordered_map<std::type_index, std::string> Logger::initTypeidToStrMap() {
 }
 
 
-void Logger::helperLogToFile(std::string_view file_name, std::string_view message) {
-
+void Logger::helperLogToFile(std::string_view message, bool flush_now) {
     std::lock_guard<std::mutex> lock(s_logtofile_mutex);
-    static int num_of_same_name_files = 1;
-    namespace fs = std::filesystem;
-    fs::path log_path;
-    log_path.concat("logs/").concat(file_name).concat(".log");
-    
-    try {
-        if (fs::exists(log_path) && fs::file_size(log_path) > s_logfile_max_size) {
-            log_path.replace_filename(log_path.stem().string() + "_" + std::to_string(++num_of_same_name_files));
-        }
-        fs::create_directories(log_path.parent_path());
-        std::ofstream log_file(log_path, std::ios_base::app);
-        if (log_file.is_open()) {
-            log_file << message << std::endl;
-        } else {
-            std::cerr << "Unable to open log file: " << log_path << std::endl;
-        }
-        log_file.flush();
-    } catch (const std::exception& e) {
-        std::cerr << "Failed to log to file: " << e.what() << std::endl;
-        throw e;
+    RotatingFileSink& sink = textLogSink();
+    sink.setMaxBytes(static_cast<uint64_t>(s_logfile_max_size));
+    if (!sink.writeLine(message)) {
+        return; // the sink has reported it
+    }
+    loggerMetrics().text_bytes_written->add(message.size() + 1);
+    if (flush_now) {
+        sink.flush();
+    } else {
+        sink.flushIfDue();
     }
 }
 
 std::string Logger::logLevelToString(LogLevel lev, bool add_sqbrackets) {
     if (add_sqbrackets) {
-        return "[" + logLevelToString(lev, false) + "]";
+        return "[" + std::string(helperLogLevelName(lev)) + "]";
     }
+    return std::string(helperLogLevelName(lev));
+}
+
+std::string_view Logger::helperLogLevelName(LogLevel lev) noexcept {
     switch (lev) {
         case INFO: return "INFO";
         case WARNING_LOW: return "WARNING_LOW";
@@ -80,7 +153,13 @@ std::string Logger::logLevelToString(LogLevel lev, bool add_sqbrackets) {
 
 std::tm Logger::helperGetTime() {
     const int YEAR_OFFSET = 1900;
+    // converted once a second per thread, not for every entry
+    thread_local std::time_t cached_second = -1;
+    thread_local std::tm cached_local_time {};
     std::time_t now = std::time(nullptr);
+    if (now == cached_second) {
+        return cached_local_time;
+    }
     std::tm local_time;
     #ifdef _MSC_VER
         localtime_s(&local_time, &now);
@@ -89,95 +168,217 @@ std::tm Logger::helperGetTime() {
     #endif
     local_time.tm_year += YEAR_OFFSET;
     local_time.tm_mon += 1;
+    cached_second = now;
+    cached_local_time = local_time;
     return local_time;
 }
 
-std::string Logger::helperGenFileName(const std::tm& t) {
-    std::string s;
-    s.reserve(10);
-    s.append(std::to_string(t.tm_year))
-        .append("/").append(std::to_string(t.tm_mon))
-        .append("-").append(std::to_string(t.tm_mday));
-    return s;
-}
-
-std::string Logger::helperGenTimestamp(const std::tm& t) {
-    std::string s;
-    s.reserve(10);
-    s.append("[")
-        .append(std::to_string(t.tm_hour))
-        .append(":").append(std::to_string(t.tm_min))
-        .append(":").append(std::to_string(t.tm_sec))
-        .append("]");
-    return s;
-}
-
-void Logger::logDos(std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp) {
+void Logger::logDos(
+    std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp,
+    const FlightRecorder::Origin* origin
+) {
 
     assert(!where.empty() && "where (std::string_view) cannot be empty/null");
     assert(!what.empty() && "what (std::string_view) cannot be empty/null");
     
+    // every level goes to the in-memory recorder, the threshold is for the log file only
+    if (origin != nullptr) {
+        FlightRecorder::record(where, what, lev, add_timestamp, *origin);
+    } else {
+        FlightRecorder::record(where, what, lev, add_timestamp);
+    }
+
     if (lev < log_level_threshold) {
         return;
     }
 
-    std::tm local_time = helperGetTime();
-    std::string log_entry;
-    log_entry.reserve(256);
-    log_entry
-        .append((add_timestamp) ? helperGenTimestamp(local_time) : "[]")
-        .append(" ")
-        .append(logLevelToString(lev, true))
-        .append("{\n") 
-        .append(string_utils_ns::add_indent(where, s_num_of_indent_spaces))
-        .append("\n")
-        .append(string_utils_ns::add_indent(what, s_num_of_indent_spaces))
-        .append("\n}");
+    // levels without rules (INFO, DEBUG by default) skip the limiter's mutex
+    LogRateLimiter& limiter = rateLimiter();
+    if (limiter.hasLimits(lev) && !limiter.allow(where, lev, Utils::Time::now())) {
+        loggerMetrics().entries_dropped->add();
+        return;
+    }
+    if (limiter.hasSuppressed()) {
+        helperLogSuppressed(limiter.takeSuppressed(
+            Utils::Time::now(), std::chrono::duration_cast<Utils::Time::Clock::duration>(
+                std::chrono::duration<double>(s_rate_limit_summary_interval_s))
+        ));
+    }
 
-    
-    if (s_delay_log) {
-        std::lock_guard<std::mutex> lock(s_logtobuffer_mutex);
-        s_havent_logged_logs << "\n" << log_entry;
-        if (lev == ERROR) {
-            logHaventLogged();
+    helperWriteEntry(where, what, lev, add_timestamp);
+}
+
+void Logger::helperWriteEntry(std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp) {
+    TRACE_SCOPE("Logger::write");
+    loggerMetrics().entries_written[lev]->add();
+    if (s_log_format == LogFormat::Binary) {
+        helperLogBinary(where, what, lev, add_timestamp);
+    } else {
+        // reused per thread: no allocation once it has grown to the longest entry
+        thread_local string_utils_ns::StringWriter entry;
+        entry.clear();
+        formatTextEntry(entry, helperGetTime(), where, what, lev, add_timestamp);
+        helperLogToFile(entry.view(), lev >= WARNING_HIGH);
+    }
+
+    if (lev == ERROR) {
+        helperDumpFlightRecorder("ERROR logged");
+    }
+}
+
+// no formatting and no indenting: the call site is interned once per file,
+// an entry is a fixed header and the raw bytes of `what`, the stream stays open and buffered
+void Logger::helperLogBinary(std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp) {
+    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+    std::lock_guard<std::mutex> lock(binaryLogMutex());
+    BinaryLogState& state = binaryLogState();
+    state.sink.setMaxBytes(static_cast<uint64_t>(s_logfile_max_size));
+
+    // room for the magic, a site definition and the entry, so they land in the same file
+    const size_t max_record_size = binary_log_ns::MAGIC.size() + 2 * binary_log_ns::HEADER_SIZE + where.size() + what.size();
+    if (!state.sink.prepare(max_record_size)) {
+        return; // the sink has reported it
+    }
+    const uint64_t bytes_before = state.sink.getBytesInFile();
+    if (state.sink.getGeneration() != state.sink_generation) { // another file
+        state.sink_generation = state.sink.getGeneration();
+        state.is_site_in_file.assign(state.is_site_in_file.size(), false);
+        if (state.sink.getBytesInFile() == 0) {
+            state.sink.write(binary_log_ns::MAGIC);
         }
+    }
+
+    uint32_t site_id;
+    auto found = state.site_ids.find(where);
+    if (found != state.site_ids.end()) {
+        site_id = found->second;
+    } else {
+        site_id = static_cast<uint32_t>(state.site_texts.size());
+        state.site_texts.emplace_back(where);
+        state.site_ids.emplace(state.site_texts.back(), site_id);
+        state.is_site_in_file.push_back(false);
+    }
+    if (!state.is_site_in_file[site_id]) {
+        binary_log_ns::RecordHeader definition;
+        definition.kind = binary_log_ns::RecordKind::SiteDefinition;
+        definition.site_id = site_id;
+        definition.payload_size = static_cast<uint32_t>(where.size());
+        writeBinaryRecord(state.sink, definition, where);
+        state.is_site_in_file[site_id] = true;
+    }
+
+    binary_log_ns::RecordHeader entry;
+    entry.kind = binary_log_ns::RecordKind::Entry;
+    entry.level = static_cast<uint8_t>(lev);
+    entry.flags = add_timestamp ? binary_log_ns::FLAG_HAS_TIMESTAMP : binary_log_ns::FLAG_NONE;
+    entry.site_id = site_id;
+    entry.unix_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    entry.payload_size = static_cast<uint32_t>(what.size());
+    writeBinaryRecord(state.sink, entry, what);
+    loggerMetrics().binary_bytes_written->add(state.sink.getBytesInFile() - bytes_before);
+
+    if (lev >= WARNING_HIGH) {
+        state.sink.flush(); // what comes before a crash should be on disk
     } else {
-        
-        helperLogToFile(helperGenFileName(local_time), log_entry);
-        
+        state.sink.flushIfDue();
     }
-    return;
 }
 
 // public
 
+std::string Logger::formatTextEntry(
+    const std::tm& local_time, std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp
+) {
+    string_utils_ns::StringWriter entry;
+    formatTextEntry(entry, local_time, where, what, lev, add_timestamp);
+    return entry.str();
+}
+
+void Logger::formatTextEntry(
+    string_utils_ns::StringWriter& out,
+    const std::tm& local_time, std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp
+) {
+    if (add_timestamp) {
+        out << '[' << local_time.tm_hour << ':' << local_time.tm_min << ':' << local_time.tm_sec << ']';
+    } else {
+        out << "[]";
+    }
+    out << " [" << helperLogLevelName(lev) << "]{\n";
+    out.setIndent(s_num_of_indent_spaces);
+    out << where << '\n' << what;
+    out.setIndent(0);
+    out << "\n}";
+}
+
 void Logger::log(std::string_view where, std::string_view what, Logger::LogLevel lev, bool add_timestamp) {
     logDos(where, what, lev, add_timestamp);
 }
+void Logger::log(
+    std::string_view where, std::string_view what, Logger::LogLevel lev, bool add_timestamp,
+    const FlightRecorder::Origin& origin
+) {
+    logDos(where, what, lev, add_timestamp, &origin);
+}
 // void Logger::log(const std::stringstream& where, const std::stringstream& what, const LogLevel& lev, bool add_timestamp) {
 //     const std::string where_str = where.str();  // Extend lifetime
 //     const std::string what_str = what.str();
 //     logDos(where_str, what_str, lev, add_timestamp);
 // }
 
-void Logger::logHaventLogged() {
-    if (s_havent_logged_logs.str() != "") {
-        std::string havent_logged_string = s_havent_logged_logs.str(); // extend lifetime
-        helperLogToFile(
-            helperGenFileName(helperGetTime()), 
-            std::string_view(havent_logged_string)
-        );
-        s_havent_logged_logs.str("");
+void Logger::helperDumpFlightRecorder(std::string_view reason) {
+    // logf entries made before this are recorded only once the writer thread gets to them
+    deferred_log_ns::DeferredLog::drain();
+    const std::string dump = FlightRecorder::collectText(reason);
+    if (!dump.empty()) {
+        helperLogToFile(dump, true);
     }
 }
 
-void Logger::setDelayLog(bool new_delay_log) {
-    if (new_delay_log == true) {
-        s_delay_log = true;
-        logHaventLogged();
-    } else {
-        s_delay_log = false;
+void Logger::helperLogSuppressed(const std::vector<LogRateLimiter::Suppressed>& suppressed) {
+    if (suppressed.empty()) {
+        return;
+    }
+    string_utils_ns::StringWriter what;
+    what << "entries left out by the rate limits since the last summary:";
+    for (const LogRateLimiter::Suppressed& site : suppressed) {
+        what << "\n  [" << helperLogLevelName(static_cast<LogLevel>(site.level)) << "] "
+            << site.where << ": " << site.count;
+    }
+    FlightRecorder::record("Logger::rate_limit", what.view(), WARNING_LOW, true);
+    helperWriteEntry("Logger::rate_limit", what.view(), WARNING_LOW, true);
+}
+
+void Logger::setLogLimit(LogLevel lev, const LogLimit& limit) {
+    setLogLimit("", lev, limit);
+}
+
+void Logger::setLogLimit(std::string_view where_prefix, LogLevel lev, const LogLimit& limit) {
+    rateLimiter().setLimit(where_prefix, lev, limit);
+}
+
+void Logger::clearLogLimits() {
+    rateLimiter().clear();
+}
+
+void Logger::setLogFormat(LogFormat new_log_format) {
+    flush();
+    s_log_format = new_log_format;
+}
+
+void Logger::flush() {
+    TRACE_SCOPE("Logger::flush");
+    Utils::Time::ScopedTimer timer([](Utils::Time::Clock::duration d) {
+        loggerMetrics().flush_duration_us->observe(static_cast<double>(Utils::Time::to_micros(d)));
+    });
+    deferred_log_ns::DeferredLog::drain();
+    helperLogSuppressed(rateLimiter().takeSuppressed(Utils::Time::now(), {}, true));
+    {
+        std::lock_guard<std::mutex> lock(s_logtofile_mutex);
+        textLogSink().flush();
     }
+    std::lock_guard<std::mutex> lock(binaryLogMutex());
+    binaryLogState().sink.flush();
 }
 
 void Logger::start_run(const std::string& message) {
@@ -1,7 +1,9 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <ctime>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
@@ -9,6 +11,12 @@
 #include <typeindex>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
+
+#include "../Utils/StringUtils.hpp"
+#include "DeferredLog.hpp"
+#include "FlightRecorder.hpp"
+#include "LogRateLimiter.hpp"
 
 
 
@@ -22,6 +30,14 @@ public:
         WARNING_HIGH,
         ERROR
     };
+
+    // Text: one indented block per entry in logs/<date>.log
+    // Binary: logs/<date>.binlog, `where` interned to an id, entries are a fixed header + raw `what`
+    //         (see BinaryLogFormat.hpp), Tools/snake-logdump turns it back into the text
+    enum class LogFormat {
+        Text,
+        Binary
+    };
     
     class SeeAbove : public std::exception {
         std::string msg_;
@@ -37,9 +53,6 @@ public:
 
 private:
     static inline std::mutex s_logtofile_mutex;
-    static inline std::mutex s_logtobuffer_mutex;
-
-    static inline std::stringstream s_havent_logged_logs;
 
     // Map from type_info to string for type names 
     static std::unordered_map<std::type_index, std::string> s_typeid_to_str_map;
@@ -47,25 +60,43 @@ private:
 private:
     static std::unordered_map<std::type_index, std::string> initTypeidToStrMap();
 
-    // Private helper: log to file
-    // thread safty held by using lock_guard
-    static void helperLogToFile(std::string_view file_name, std::string_view message);
+    // Private helper: log to file (logs/<date>.log, rotated by date and s_logfile_max_size)
+    // thread safty held by using lock_guard, the file stays open and is flushed once a second or if flush_now
+    static void helperLogToFile(std::string_view message, bool flush_now);
     // Private helper: log level to string
     // Log levels are ordered from least severe (DEBUG) to most severe (ERROR).
     static std::string logLevelToString(LogLevel lev, bool add_sqbrackets = true);
+    static std::string_view helperLogLevelName(LogLevel lev) noexcept;
     
-    static void logDos(std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp);
+    // origin: of an entry made on another thread, nullptr for the calling thread and now
+    static void logDos(
+        std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp,
+        const FlightRecorder::Origin* origin = nullptr
+    );
+    // an entry past the threshold and the rate limits: binary or text file, FlightRecorder dump on ERROR
+    static void helperWriteEntry(std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp);
+    // one entry listing the entries the rate limits left out, nothing if there are none
+    static void helperLogSuppressed(const std::vector<LogRateLimiter::Suppressed>& suppressed);
+    static void helperLogBinary(std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp);
+    // writes the logf queue out, then the FlightRecorder entries since the last dump into the text log
+    static void helperDumpFlightRecorder(std::string_view reason);
+
+    // queues the entry for the writer thread of logf, or formats and logs it here
+    // (WARNING_HIGH and above, no writer thread)
+    template <typename PackFn>
+    static void helperLogDeferred(
+        const char* where, LogLevel lev, const char* fmt, deferred_log_ns::FormatFn format, const PackFn& pack
+    );
 
     static std::tm helperGetTime();
-    static std::string helperGenFileName(const std::tm& t);
-    static std::string helperGenTimestamp(const std::tm& t);
 
 public:
 
     static inline LogLevel log_level_threshold = LogLevel::INFO;
-    static inline bool s_delay_log = false;
     static inline size_t s_num_of_indent_spaces = 4;
     static inline double s_logfile_max_size = 5e6;
+    static inline LogFormat s_log_format = LogFormat::Text;
+    static inline double s_rate_limit_summary_interval_s = 10;
 
 public:
     // static void log(const std::string& where, const std::string& what, const LogLevel& lev, bool add_timestamp = true);
@@ -73,6 +104,25 @@ public:
     // static void log(const std::stringstream& where, const std::stringstream& what, const LogLevel& lev, bool add_timestamp = true);
     
     static void log(std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp = true);
+    // an entry made earlier on another thread (logf's writer thread), the FlightRecorder keeps its origin
+    static void log(
+        std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp,
+        const FlightRecorder::Origin& origin
+    );
+
+    // log without building the message here: args are copied into a queue slot and a writer thread
+    // puts them into the "{}" of fmt (see DeferredLog.hpp), e.g.
+    //   Logger::logf("Game::run()", Logger::DEBUG, "frame took {}us", duration);
+    // args: numbers, enums and trivially copyable types with to_string(), no pointers or strings (use log)
+    // where and fmt must be string literals, WARNING_HIGH and above are written before returning
+    template <typename... Args>
+    static void logf(const char* where, LogLevel lev, const char* fmt, const Args&... args);
+
+    // logf with decorator.decorate(std::string message) applied to the formatted message on the writer thread
+    template <typename Decorator, typename... Args>
+    static void logfDecorated(
+        const char* where, LogLevel lev, const Decorator& decorator, const char* fmt, const Args&... args
+    );
 
     static void start_run(const std::string& message = "");
 
@@ -85,8 +135,27 @@ public:
     // template <typename ExceptionType = std::runtime_error>
     // [[noreturn]] static void logAndThrow(const std::stringstream& where, const std::stringstream& what);
 
-    static void logHaventLogged();
-    static void setDelayLog(bool new_delay_log);
+    // per call site limits after the level threshold: token bucket and 1-in-N sampling (see LogRateLimiter.hpp)
+    // warnings default to 10 per second (burst 20) per `where`, ERROR is never limited
+    // the entries left out are counted in one "Logger::rate_limit" entry every s_rate_limit_summary_interval_s
+    static void setLogLimit(LogLevel lev, const LogLimit& limit);
+    // for the `where`s starting with where_prefix, the longest matching prefix wins
+    static void setLogLimit(std::string_view where_prefix, LogLevel lev, const LogLimit& limit);
+    static void clearLogLimits();
+
+    static void setLogFormat(LogFormat new_log_format);
+    // writes out the logf queue, the rate limit summary and what the log files have buffered
+    static void flush();
+
+    // one entry as the text log has it, snake-logdump rebuilds binary entries with it
+    static std::string formatTextEntry(
+        const std::tm& local_time, std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp
+    );
+    // the same, appended to out
+    static void formatTextEntry(
+        string_utils_ns::StringWriter& out,
+        const std::tm& local_time, std::string_view where, std::string_view what, LogLevel lev, bool add_timestamp
+    );
 
     template <typename ExceptionT>
     static void addTypeStringBond(const std::string& correspond_str);
@@ -52,5 +52,89 @@ std::string Logger::getCorrespondStrOfType() {
 }
 
 
+template <typename PackFn>
+void Logger::helperLogDeferred(
+    const char* where, LogLevel lev, const char* fmt, deferred_log_ns::FormatFn format, const PackFn& pack
+) {
+    if (lev < WARNING_HIGH) {
+        deferred_log_ns::Ticket ticket = deferred_log_ns::DeferredLog::tryClaim();
+        if (ticket.slot == nullptr) { // full: wait for the writer rather than overtake the queue
+            deferred_log_ns::DeferredLog::drain();
+            ticket = deferred_log_ns::DeferredLog::tryClaim();
+        }
+        if (ticket.slot != nullptr) {
+            deferred_log_ns::Slot& slot = *ticket.slot;
+            slot.where = where;
+            slot.fmt = fmt;
+            slot.format = format;
+            slot.level = lev;
+            slot.add_timestamp = true;
+            slot.origin = FlightRecorder::currentOrigin();
+            pack(slot.args);
+            deferred_log_ns::DeferredLog::publish(ticket);
+            return;
+        }
+    } else {
+        deferred_log_ns::DeferredLog::drain(); // the queued entries come first
+    }
+    alignas(deferred_log_ns::ARGS_ALIGNMENT) unsigned char args[deferred_log_ns::ARGS_CAPACITY];
+    pack(args);
+    std::string what;
+    format(what, fmt, args);
+    logDos(where, what, lev, true);
+}
+
+template <typename... Args>
+void Logger::logf(const char* where, LogLevel lev, const char* fmt, const Args&... args) {
+    static_assert(
+        (deferred_log_ns::detail::isLoggableArg<Args>() && ...),
+        "logf args must be trivially copyable numbers, enums or types with to_string(), use log for the others"
+    );
+    static_assert(
+        deferred_log_ns::detail::packedSize<Args...>() <= deferred_log_ns::ARGS_CAPACITY,
+        "logf args do not fit in deferred_log_ns::ARGS_CAPACITY"
+    );
+    static_assert(((alignof(Args) <= deferred_log_ns::ARGS_ALIGNMENT) && ...), "logf arg is over-aligned");
+
+    helperLogDeferred(
+        where, lev, fmt, &deferred_log_ns::detail::formatPacked<Args...>,
+        [&](unsigned char* slot_args) {
+            size_t offset = 0;
+            (deferred_log_ns::detail::writeArg(slot_args, offset, args), ...);
+        }
+    );
+}
+
+template <typename Decorator, typename... Args>
+void Logger::logfDecorated(
+    const char* where, LogLevel lev, const Decorator& decorator, const char* fmt, const Args&... args
+) {
+    static_assert(std::is_trivially_copyable_v<Decorator>, "logfDecorated decorator must be trivially copyable");
+    static_assert(
+        (deferred_log_ns::detail::isLoggableArg<Args>() && ...),
+        "logf args must be trivially copyable numbers, enums or types with to_string(), use log for the others"
+    );
+    constexpr size_t args_offset = deferred_log_ns::detail::alignUp(sizeof(Decorator), deferred_log_ns::ARGS_ALIGNMENT);
+    static_assert(
+        args_offset + deferred_log_ns::detail::packedSize<Args...>() <= deferred_log_ns::ARGS_CAPACITY,
+        "logf decorator and args do not fit in deferred_log_ns::ARGS_CAPACITY"
+    );
+    static_assert(
+        alignof(Decorator) <= deferred_log_ns::ARGS_ALIGNMENT
+            && ((alignof(Args) <= deferred_log_ns::ARGS_ALIGNMENT) && ...),
+        "logf arg is over-aligned"
+    );
+
+    helperLogDeferred(
+        where, lev, fmt, &deferred_log_ns::detail::formatDecorated<Decorator, Args...>,
+        [&](unsigned char* slot_args) {
+            size_t offset = 0;
+            deferred_log_ns::detail::writeArg(slot_args, offset, decorator);
+            offset = args_offset;
+            (deferred_log_ns::detail::writeArg(slot_args, offset, args), ...);
+        }
+    );
+}
+
 
 #endif // LOGGER_INL
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "Metrics.hpp"
+#include "Logger.hpp"
+#include "../Utils/utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace { // Anonymous namespace for private functions
+
+constexpr size_t COUNTERS_PER_CACHE_LINE = 64 / sizeof(std::atomic<uint64_t>);
+
+struct Entry {
+    std::string name;
+    std::string help;
+    std::string labels;
+    Metrics::Kind kind;
+    // one of them is set, by kind
+    std::unique_ptr<MetricCounter> counter;
+    std::unique_ptr<MetricGauge> gauge;
+    std::unique_ptr<MetricHistogram> histogram;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::deque<Entry> entries;
+    std::map<std::string, size_t> indices; // name + '{' + labels
+    std::map<std::string, Metrics::Kind> kinds; // of each name
+};
+
+// never destroyed: the destructors of other statics (e.g. the logf writer) may still count
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+using Clock = Utils::Time::Clock;
+
+std::atomic<int64_t>& nextDumpAt() { // Clock ticks
+    static std::atomic<int64_t> next_dump_at {0};
+    return next_dump_at;
+}
+
+const char* kindToString(Metrics::Kind kind) {
+    switch (kind) {
+        case Metrics::Kind::Counter: return "counter";
+        case Metrics::Kind::Gauge: return "gauge";
+        case Metrics::Kind::Histogram: return "histogram";
+        default: return "untyped";
+    }
+}
+
+std::string formatNumber(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return (value > 0) ? "+Inf" : "-Inf";
+    }
+    if (value == std::floor(value) && std::fabs(value) < 9007199254740992.0) { // 2^53
+        return std::to_string(static_cast<int64_t>(value));
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+// name{labels,extra_label} value
+void appendSample(std::string& out, const std::string& name, const std::string& labels, std::string_view extra_label, const std::string& value) {
+    out.append(name);
+    if (!labels.empty() || !extra_label.empty()) {
+        out.append("{").append(labels);
+        if (!labels.empty() && !extra_label.empty()) {
+            out.append(",");
+        }
+        out.append(extra_label).append("}");
+    }
+    out.append(" ").append(value).append("\n");
+}
+
+} // Anonymous namespace end
+
+
+size_t metrics_detail::threadShard() noexcept {
+    static std::atomic<size_t> next_shard {0};
+    thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+// # MetricCounter
+
+uint64_t MetricCounter::value() const noexcept {
+    uint64_t total = 0;
+    for (const metrics_detail::PaddedCounter& shard : shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// # MetricGauge
+
+void MetricGauge::add(double delta) noexcept {
+    uint64_t old_bits = bits.load(std::memory_order_relaxed);
+    while (!bits.compare_exchange_weak(
+        old_bits, metrics_detail::doubleToBits(metrics_detail::bitsToDouble(old_bits) + delta),
+        std::memory_order_relaxed
+    )) {}
+}
+
+// # MetricHistogram
+
+MetricHistogram::MetricHistogram(std::vector<double> arg_upper_bounds)
+    : upper_bounds(std::move(arg_upper_bounds))
+{
+    std::sort(upper_bounds.begin(), upper_bounds.end());
+    const size_t num_of_buckets = upper_bounds.size() + 1;
+    shard_stride = (num_of_buckets + COUNTERS_PER_CACHE_LINE - 1) / COUNTERS_PER_CACHE_LINE * COUNTERS_PER_CACHE_LINE;
+    counts.reset(new std::atomic<uint64_t>[shard_stride * METRIC_SHARDS]);
+    for (size_t i = 0; i < shard_stride * METRIC_SHARDS; ++i) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double value) noexcept {
+    const size_t bucket = static_cast<size_t>(
+        std::lower_bound(upper_bounds.begin(), upper_bounds.end(), value) - upper_bounds.begin()
+    );
+    const size_t shard = metrics_detail::threadShard();
+    counts[shard * shard_stride + bucket].fetch_add(1, std::memory_order_relaxed);
+
+    std::atomic<uint64_t>& sum_bits = sums[shard].value;
+    uint64_t old_bits = sum_bits.load(std::memory_order_relaxed);
+    while (!sum_bits.compare_exchange_weak(
+        old_bits, metrics_detail::doubleToBits(metrics_detail::bitsToDouble(old_bits) + value),
+        std::memory_order_relaxed
+    )) {}
+}
+
+MetricHistogram::Snapshot MetricHistogram::snapshot() const {
+    Snapshot result;
+    result.upper_bounds = upper_bounds;
+    result.cumulative_counts.assign(upper_bounds.size() + 1, 0);
+    for (size_t shard = 0; shard < METRIC_SHARDS; ++shard) {
+        for (size_t bucket = 0; bucket <= upper_bounds.size(); ++bucket) {
+            result.cumulative_counts[bucket] += counts[shard * shard_stride + bucket].load(std::memory_order_relaxed);
+        }
+        result.sum += metrics_detail::bitsToDouble(sums[shard].value.load(std::memory_order_relaxed));
+    }
+    for (size_t bucket = 1; bucket < result.cumulative_counts.size(); ++bucket) {
+        result.cumulative_counts[bucket] += result.cumulative_counts[bucket - 1];
+    }
+    return result;
+}
+
+// # Metrics
+
+template <typename ExceptionType>
+[[noreturn]] void Metrics::logAndThrow(std::string_view where, std::string_view what) {
+    Logger::logAndThrow<ExceptionType>("Metrics::" + std::string(where), what);
+}
+
+template <typename MetricT, typename MakeFn>
+MetricT& Metrics::helperRegister(std::string_view name, std::string_view help, std::string_view labels, Kind kind, MakeFn make) {
+    Registry& reg = registry();
+    std::unique_lock<std::mutex> lock(reg.mutex);
+
+    auto kind_found = reg.kinds.find(std::string(name));
+    if (kind_found != reg.kinds.end() && kind_found->second != kind) {
+        lock.unlock();
+        logAndThrow<std::logic_error>(
+            "helperRegister",
+            std::string(name) + " is already a " + kindToString(kind_found->second) + ", not a " + kindToString(kind)
+        );
+    }
+    const std::string key = std::string(name) + "{" + std::string(labels);
+    auto found = reg.indices.find(key);
+    if (found == reg.indices.end()) {
+        Entry entry {std::string(name), std::string(help), std::string(labels), kind, nullptr, nullptr, nullptr};
+        make(entry);
+        reg.entries.push_back(std::move(entry));
+        found = reg.indices.emplace(key, reg.entries.size() - 1).first;
+        reg.kinds.emplace(std::string(name), kind);
+    }
+    Entry& entry = reg.entries[found->second];
+    if constexpr (std::is_same_v<MetricT, MetricCounter>) {
+        return *entry.counter;
+    } else if constexpr (std::is_same_v<MetricT, MetricGauge>) {
+        return *entry.gauge;
+    } else {
+        return *entry.histogram;
+    }
+}
+
+MetricCounter& Metrics::counter(std::string_view name, std::string_view help, std::string_view labels) {
+    return helperRegister<MetricCounter>(name, help, labels, Kind::Counter, [](Entry& entry) {
+        entry.counter = std::make_unique<MetricCounter>();
+    });
+}
+
+MetricGauge& Metrics::gauge(std::string_view name, std::string_view help, std::string_view labels) {
+    return helperRegister<MetricGauge>(name, help, labels, Kind::Gauge, [](Entry& entry) {
+        entry.gauge = std::make_unique<MetricGauge>();
+    });
+}
+
+MetricHistogram& Metrics::histogram(
+    std::string_view name, std::string_view help, std::vector<double> upper_bounds, std::string_view labels
+) {
+    return helperRegister<MetricHistogram>(name, help, labels, Kind::Histogram, [&](Entry& entry) {
+        entry.histogram = std::make_unique<MetricHistogram>(std::move(upper_bounds));
+    });
+}
+
+std::vector<Metrics::Snapshot> Metrics::snapshot() {
+    std::vector<Snapshot> result;
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        result.reserve(reg.entries.size());
+        for (const Entry& entry : reg.entries) {
+            Snapshot snapshot;
+            snapshot.name = entry.name;
+            snapshot.help = entry.help;
+            snapshot.labels = entry.labels;
+            snapshot.kind = entry.kind;
+            switch (entry.kind) {
+                case Kind::Counter: snapshot.value = static_cast<double>(entry.counter->value()); break;
+                case Kind::Gauge: snapshot.value = entry.gauge->value(); break;
+                case Kind::Histogram: snapshot.histogram = entry.histogram->snapshot(); break;
+            }
+            result.push_back(std::move(snapshot));
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const Snapshot& a, const Snapshot& b) {
+        return a.name < b.name;
+    });
+    return result;
+}
+
+std::string Metrics::toPrometheusText(const std::vector<Snapshot>& snapshots) {
+    std::string out;
+    out.reserve(snapshots.size() * 96);
+    const std::string* previous_name = nullptr;
+    for (const Snapshot& snapshot : snapshots) {
+        if (previous_name == nullptr || *previous_name != snapshot.name) {
+            if (!snapshot.help.empty()) {
+                out.append("# HELP ").append(snapshot.name).append(" ").append(snapshot.help).append("\n");
+            }
+            out.append("# TYPE ").append(snapshot.name).append(" ").append(kindToString(snapshot.kind)).append("\n");
+            previous_name = &snapshot.name;
+        }
+        if (snapshot.kind != Kind::Histogram) {
+            appendSample(out, snapshot.name, snapshot.labels, "", formatNumber(snapshot.value));
+            continue;
+        }
+        const MetricHistogram::Snapshot& histogram = snapshot.histogram;
+        for (size_t i = 0; i < histogram.cumulative_counts.size(); ++i) {
+            const std::string le = (i < histogram.upper_bounds.size()) ? formatNumber(histogram.upper_bounds[i]) : "+Inf";
+            appendSample(out, snapshot.name + "_bucket", snapshot.labels, "le=\"" + le + "\"",
+                std::to_string(histogram.cumulative_counts[i]));
+        }
+        appendSample(out, snapshot.name + "_sum", snapshot.labels, "", formatNumber(histogram.sum));
+        appendSample(out, snapshot.name + "_count", snapshot.labels, "", std::to_string(histogram.cumulative_counts.back()));
+    }
+    return out;
+}
+
+bool Metrics::dumpToFile(const std::string& path) {
+    namespace fs = std::filesystem;
+    const std::string text = toPrometheusText(snapshot());
+    const std::string tmp_path = path + ".tmp";
+    try {
+        const fs::path fs_path(path);
+        if (fs_path.has_parent_path()) {
+            fs::create_directories(fs_path.parent_path());
+        }
+        {
+            std::ofstream file(tmp_path, std::ios_base::trunc | std::ios_base::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+            file.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (!file) {
+                return false;
+            }
+        }
+        // readers see the old or the new dump, never half of one
+        fs::rename(tmp_path, fs_path);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+void Metrics::dumpIfDue() {
+    const int64_t now = Utils::Time::now().time_since_epoch().count();
+    std::atomic<int64_t>& next_dump_at = nextDumpAt();
+    int64_t due = next_dump_at.load(std::memory_order_relaxed);
+    if (now < due) {
+        return;
+    }
+    const int64_t next = now + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(s_dump_interval_s)).count();
+    if (!next_dump_at.compare_exchange_strong(due, next, std::memory_order_relaxed)) {
+        return; // another thread dumps
+    }
+    if (due == 0) {
+        return; // the first call only starts the interval
+    }
+    if (!dumpToFile(s_dump_path)) {
+        Logger::log("Metrics::dumpIfDue()", "could not write " + s_dump_path, Logger::WARNING_LOW);
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+in-process metrics next to Logger: counters, gauges and histograms by name (+ labels)
+  - Metrics::counter/gauge/histogram register a metric (locked, the same object comes back for
+    the same name and labels), keep the reference, e.g. in a function static
+  - updates take no lock: counters and histograms add to one of METRIC_SHARDS cache line sized
+    atomics picked per thread, a gauge is one atomic
+  - Metrics::snapshot() sums the shards, toPrometheusText() formats a snapshot,
+    dumpIfDue() writes it to s_dump_path every s_dump_interval_s
+*/
+
+constexpr size_t METRIC_SHARDS = 16;
+
+namespace metrics_detail {
+
+    struct alignas(64) PaddedCounter {
+        std::atomic<uint64_t> value {0};
+    };
+
+    // the shard of the calling thread, threads take them round robin
+    size_t threadShard() noexcept;
+
+    inline uint64_t doubleToBits(double value) noexcept {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    inline double bitsToDouble(uint64_t bits) noexcept {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+} // namespace metrics_detail
+
+
+class MetricCounter {
+public:
+    void add(uint64_t n = 1) noexcept {
+        shards[metrics_detail::threadShard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t value() const noexcept;
+
+private:
+    std::array<metrics_detail::PaddedCounter, METRIC_SHARDS> shards;
+};
+
+
+class MetricGauge {
+public:
+    void set(double new_value) noexcept {
+        bits.store(metrics_detail::doubleToBits(new_value), std::memory_order_relaxed);
+    }
+    void add(double delta) noexcept;
+    double value() const noexcept {
+        return metrics_detail::bitsToDouble(bits.load(std::memory_order_relaxed));
+    }
+
+private:
+    std::atomic<uint64_t> bits {0}; // of a double, 0.0 is all zero bits
+};
+
+
+// counts of values <= each upper bound (and above the last one), plus their sum
+class MetricHistogram {
+public:
+    struct Snapshot {
+        std::vector<double> upper_bounds;
+        std::vector<uint64_t> cumulative_counts; // one per upper bound, then the total count (+Inf)
+        double sum = 0;
+    };
+
+    // upper_bounds sorted ascending
+    explicit MetricHistogram(std::vector<double> arg_upper_bounds);
+
+    void observe(double value) noexcept;
+    Snapshot snapshot() const;
+
+private:
+    std::vector<double> upper_bounds;
+    size_t shard_stride; // counters per shard, a multiple of a cache line
+    std::unique_ptr<std::atomic<uint64_t>[]> counts; // [shard * shard_stride + bucket]
+    std::array<metrics_detail::PaddedCounter, METRIC_SHARDS> sums; // bits of a double per shard
+};
+
+
+class Metrics {
+public:
+    enum class Kind {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Snapshot {
+        std::string name;
+        std::string help;
+        std::string labels; // Prometheus label list without braces, e.g. level="INFO"
+        Kind kind = Kind::Counter;
+        double value = 0; // Counter and Gauge
+        MetricHistogram::Snapshot histogram; // Histogram
+    };
+
+    static inline double s_dump_interval_s = 10;
+    static inline std::string s_dump_path = "logs/metrics.prom";
+
+    // a name already registered with another kind throws std::logic_error
+    static MetricCounter& counter(std::string_view name, std::string_view help, std::string_view labels = "");
+    static MetricGauge& gauge(std::string_view name, std::string_view help, std::string_view labels = "");
+    // upper_bounds only count the first time a name and labels are registered
+    static MetricHistogram& histogram(
+        std::string_view name, std::string_view help, std::vector<double> upper_bounds, std::string_view labels = ""
+    );
+
+    // every metric, in order of name (then registration)
+    static std::vector<Snapshot> snapshot();
+    // # HELP, # TYPE and the samples of each name, histograms as _bucket{le=...}, _sum and _count
+    static std::string toPrometheusText(const std::vector<Snapshot>& snapshots);
+
+    // replaces path with the text of a fresh snapshot, false if it could not be written
+    static bool dumpToFile(const std::string& path);
+    // dumpToFile(s_dump_path) once s_dump_interval_s has passed since the last dump
+    // cheap to call every frame: one clock read and an atomic load otherwise
+    static void dumpIfDue();
+
+private:
+    template <typename MetricT, typename MakeFn>
+    static MetricT& helperRegister(std::string_view name, std::string_view help, std::string_view labels, Kind kind, MakeFn make);
+
+    template <typename ExceptionType>
+    [[noreturn]] static void logAndThrow(std::string_view where, std::string_view what);
+};
+
+#endif // METRICS_HPP
@@ -0,0 +1,135 @@
+#include "RotatingFileSink.hpp"
+
+#include <filesystem>
+#include <iostream>
+
+namespace { // Anonymous namespace for private functions
+
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+std::tm toLocalTime(std::time_t time) {
+    std::tm local_time;
+#ifdef _MSC_VER
+    localtime_s(&local_time, &time);
+#else
+    localtime_r(&time, &local_time);
+#endif
+    return local_time;
+}
+
+} // Anonymous namespace end
+
+
+RotatingFileSink::RotatingFileSink(std::string arg_directory, std::string arg_extension, bool arg_is_binary)
+    : directory(std::move(arg_directory)), extension(std::move(arg_extension)), is_binary(arg_is_binary), buffer(BUFFER_SIZE)
+{}
+
+RotatingFileSink::~RotatingFileSink() {
+    flush();
+}
+
+bool RotatingFileSink::prepare(size_t incoming_size) {
+    const std::time_t now = std::time(nullptr);
+    if (!file.is_open()) {
+        if (now < retry_open_at) {
+            return false;
+        }
+        helperOpenDate(now);
+    } else if (now >= date_end) {
+        helperOpenDate(now);
+    } else if (bytes_in_file > 0 && bytes_in_file + incoming_size > max_bytes) {
+        helperOpenPart(part + 1);
+    }
+    if (!file.is_open()) {
+        retry_open_at = now + 1;
+        return false;
+    }
+    return true;
+}
+
+void RotatingFileSink::write(std::string_view bytes) {
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    bytes_in_file += bytes.size();
+}
+
+bool RotatingFileSink::writeLine(std::string_view entry) {
+    if (!prepare(entry.size() + 1)) {
+        return false;
+    }
+    write(entry);
+    write("\n");
+    return true;
+}
+
+void RotatingFileSink::flush() {
+    if (file.is_open()) {
+        file.flush();
+    }
+    last_flush = std::time(nullptr);
+}
+
+void RotatingFileSink::flushIfDue() {
+    if (std::time(nullptr) != last_flush) {
+        flush();
+    }
+}
+
+// private
+
+void RotatingFileSink::helperOpenDate(std::time_t now) {
+    const std::tm local_time = toLocalTime(now);
+    date_name = std::to_string(local_time.tm_year + 1900) + "/"
+        + std::to_string(local_time.tm_mon + 1) + "-" + std::to_string(local_time.tm_mday);
+
+    std::tm next_midnight = local_time;
+    next_midnight.tm_mday += 1;
+    next_midnight.tm_hour = next_midnight.tm_min = next_midnight.tm_sec = 0;
+    next_midnight.tm_isdst = -1;
+    date_end = std::mktime(&next_midnight);
+
+    // continue the last part of today (e.g. after a restart)
+    int last_part = 1;
+    try {
+        while (std::filesystem::exists(helperPartPath(last_part + 1))) {
+            ++last_part;
+        }
+    } catch (const std::exception&) {
+        // start from part 1, helperOpenPart reports if that fails too
+    }
+    helperOpenPart(last_part);
+    if (file.is_open() && bytes_in_file >= max_bytes) {
+        helperOpenPart(last_part + 1);
+    }
+}
+
+void RotatingFileSink::helperOpenPart(int new_part) {
+    namespace fs = std::filesystem;
+    if (file.is_open()) {
+        file.close();
+    }
+    part = new_part;
+    path = helperPartPath(part);
+    try {
+        const fs::path fs_path(path);
+        fs::create_directories(fs_path.parent_path());
+        bytes_in_file = fs::exists(fs_path) ? static_cast<uint64_t>(fs::file_size(fs_path)) : 0;
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.open(fs_path, std::ios_base::app | (is_binary ? std::ios_base::binary : std::ios_base::openmode()));
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to open log file " << path << ": " << e.what() << std::endl;
+    }
+    if (!file.is_open()) {
+        std::cerr << "Unable to open log file: " << path << std::endl;
+        return;
+    }
+    file.clear();
+    ++generation;
+}
+
+std::string RotatingFileSink::helperPartPath(int part_num) const {
+    std::string result = directory + "/" + date_name;
+    if (part_num > 1) {
+        result.append("_").append(std::to_string(part_num));
+    }
+    return result.append(extension);
+}
@@ -0,0 +1,68 @@
+#ifndef ROTATING_FILE_SINK_HPP
+#define ROTATING_FILE_SINK_HPP
+
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+append-only log file that stays open
+  <directory>/<year>/<month>-<day><extension>, then ..._2<extension>, ..._3 when one gets past max bytes
+  - the size is counted in memory, the date is checked against the next local midnight,
+    so the filesystem is only asked when a file is opened
+  - writes go through a 64 KB buffer, flushed when full, by flush(), or by flushIfDue() once a second
+not thread-safe, the owner locks around it (Logger does)
+*/
+class RotatingFileSink {
+public:
+    RotatingFileSink(std::string arg_directory, std::string arg_extension, bool arg_is_binary = false);
+    ~RotatingFileSink();
+
+    RotatingFileSink(const RotatingFileSink&) = delete;
+    RotatingFileSink& operator=(const RotatingFileSink&) = delete;
+
+    void setMaxBytes(uint64_t new_max_bytes) noexcept { max_bytes = new_max_bytes; }
+
+    // opens or rotates the file so that incoming_size more bytes go into it
+    // returns false if no file could be opened (retried a second later)
+    bool prepare(size_t incoming_size);
+    // after prepare()
+    void write(std::string_view bytes);
+    // prepare + entry + '\n'
+    bool writeLine(std::string_view entry);
+
+    void flush();
+    void flushIfDue();
+
+    // changes every time another file is opened (a header may be needed)
+    uint64_t getGeneration() const noexcept { return generation; }
+    uint64_t getBytesInFile() const noexcept { return bytes_in_file; }
+    const std::string& getPath() const noexcept { return path; }
+
+private:
+    std::string directory;
+    std::string extension;
+    bool is_binary;
+    uint64_t max_bytes = 5000000;
+
+    std::ofstream file;
+    std::vector<char> buffer;
+    std::string path;
+    std::string date_name; // <year>/<month>-<day>
+    int part = 1;
+    uint64_t bytes_in_file = 0;
+    uint64_t generation = 0;
+
+    std::time_t date_end = 0; // next local midnight
+    std::time_t last_flush = 0;
+    std::time_t retry_open_at = 0;
+
+    void helperOpenDate(std::time_t now);
+    void helperOpenPart(int new_part);
+    std::string helperPartPath(int part_num) const;
+};
+
+#endif // ROTATING_FILE_SINK_HPP
@@ -0,0 +1,202 @@
+#include "Trace.hpp"
+#include "../Utils/utils.hpp"
+
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace { // Anonymous namespace for private functions
+
+struct Event {
+    const char* name;
+    int64_t start_ns;
+    int64_t end_ns;
+};
+
+struct Chunk {
+    std::array<Event, Trace::EVENTS_PER_CHUNK> events;
+};
+
+// written by its thread only, read by writeChromeJson up to `size`
+struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::string name; // guarded by Registry::mutex
+    std::array<std::atomic<Chunk*>, Trace::MAX_CHUNKS_PER_THREAD> chunks {};
+    std::atomic<size_t> size {0};
+
+    ~ThreadBuffer() {
+        for (std::atomic<Chunk*>& chunk : chunks) {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; // kept after their thread ends
+    std::atomic<int64_t> start_ns {0};
+    std::atomic<uint64_t> dropped {0};
+};
+
+// never destroyed: spans may still end in the destructors of other statics
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+ThreadBuffer& threadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = reg.buffers.back().get();
+        buffer->tid = static_cast<uint32_t>(reg.buffers.size());
+    }
+    return *buffer;
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out.push_back('"');
+    for (const char c : text) {
+        switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out.append(escaped);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+// microseconds with the nanoseconds kept as decimals
+void appendMicros(std::string& out, int64_t ns) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%lld.%03lld",
+        static_cast<long long>(ns / 1000), static_cast<long long>((ns < 0 ? -ns : ns) % 1000));
+    out.append(buffer);
+}
+
+} // Anonymous namespace end
+
+
+void Trace::start() {
+    registry().start_ns.store(nowNs(), std::memory_order_relaxed);
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Trace::stop() {
+    s_enabled.store(false, std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(std::string_view name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name.assign(name.data(), name.size());
+}
+
+int64_t Trace::nowNs() noexcept {
+    return Utils::Time::now_ns();
+}
+
+void Trace::record(const char* name, int64_t start_ns, int64_t end_ns) noexcept {
+    ThreadBuffer* buffer;
+    try {
+        buffer = &threadBuffer();
+    } catch (const std::exception&) {
+        registry().dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const size_t size = buffer->size.load(std::memory_order_relaxed);
+    const size_t chunk_index = size / EVENTS_PER_CHUNK;
+    if (chunk_index >= MAX_CHUNKS_PER_THREAD) {
+        registry().dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Chunk* chunk = buffer->chunks[chunk_index].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new (std::nothrow) Chunk;
+        if (chunk == nullptr) {
+            registry().dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer->chunks[chunk_index].store(chunk, std::memory_order_release);
+    }
+    chunk->events[size % EVENTS_PER_CHUNK] = Event{name, start_ns, end_ns};
+    buffer->size.store(size + 1, std::memory_order_release);
+}
+
+bool Trace::writeChromeJson(const std::string& path) {
+    Registry& reg = registry();
+    const int64_t start_ns = reg.start_ns.load(std::memory_order_relaxed);
+
+    std::string out;
+    out.reserve(1 << 20);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool is_first = true;
+    auto beginEvent = [&]() {
+        out.append(is_first ? "\n" : ",\n");
+        is_first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(reg.mutex); // buffers and names, not the events
+    for (const std::unique_ptr<ThreadBuffer>& buffer : reg.buffers) {
+        const std::string tid = std::to_string(buffer->tid);
+        if (!buffer->name.empty()) {
+            beginEvent();
+            out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":").append(tid)
+                .append(",\"args\":{\"name\":");
+            appendJsonString(out, buffer->name);
+            out.append("}}");
+        }
+        const size_t size = buffer->size.load(std::memory_order_acquire);
+        for (size_t i = 0; i < size; ++i) {
+            const Event& event = buffer->chunks[i / EVENTS_PER_CHUNK].load(std::memory_order_acquire)
+                ->events[i % EVENTS_PER_CHUNK];
+            if (event.start_ns < start_ns) {
+                continue; // from before the last start()
+            }
+            beginEvent();
+            out.append("{\"name\":");
+            appendJsonString(out, event.name);
+            out.append(",\"cat\":\"snake\",\"ph\":\"X\",\"ts\":");
+            appendMicros(out, event.start_ns - start_ns);
+            out.append(",\"dur\":");
+            appendMicros(out, event.end_ns - event.start_ns);
+            out.append(",\"pid\":1,\"tid\":").append(tid).append("}");
+        }
+    }
+    out.append("\n]}\n");
+
+    try {
+        const std::filesystem::path fs_path(path);
+        if (fs_path.has_parent_path()) {
+            std::filesystem::create_directories(fs_path.parent_path());
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    std::ofstream file(path, std::ios_base::trunc | std::ios_base::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+uint64_t Trace::getDroppedCount() noexcept {
+    return registry().dropped.load(std::memory_order_relaxed);
+}
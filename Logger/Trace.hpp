@@ -0,0 +1,73 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+scoped spans for a timeline of a session (chrome://tracing, ui.perfetto.dev)
+  - TRACE_SCOPE("name") records the time from there to the end of the block on the calling thread,
+    name must be a string literal
+  - compiled in with SNAKE_ENABLE_TRACING (the CMake option of the same name), otherwise
+    TRACE_SCOPE is empty
+  - recorded only between Trace::start() and Trace::stop(), into a buffer per thread (no lock,
+    at most EVENTS_PER_CHUNK * MAX_CHUNKS_PER_THREAD spans each, the rest are counted as dropped)
+  - Trace::writeChromeJson(path) writes what was recorded as trace-event JSON
+*/
+class Trace {
+public:
+    static constexpr size_t EVENTS_PER_CHUNK = 4096;
+    static constexpr size_t MAX_CHUNKS_PER_THREAD = 256;
+
+    static void start();
+    static void stop();
+    static bool isEnabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+    // shown as the name of the calling thread's track
+    static void setThreadName(std::string_view name);
+
+    // steady clock
+    static int64_t nowNs() noexcept;
+    static void record(const char* name, int64_t start_ns, int64_t end_ns) noexcept;
+
+    // "X" (complete) events in microseconds since start(), threads named by "M" events
+    // safe while threads still record, spans that end later are not in it
+    static bool writeChromeJson(const std::string& path);
+    static uint64_t getDroppedCount() noexcept;
+
+private:
+    static inline std::atomic<bool> s_enabled {false};
+};
+
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* arg_name) noexcept
+        : name(arg_name), start_ns(Trace::isEnabled() ? Trace::nowNs() : -1) {}
+    ~TraceScope() {
+        if (start_ns >= 0) {
+            Trace::record(name, start_ns, Trace::nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    int64_t start_ns;
+};
+
+
+#ifdef SNAKE_ENABLE_TRACING
+    #define TRACE_CONCAT_DETAIL(a, b) a##b
+    #define TRACE_CONCAT(a, b) TRACE_CONCAT_DETAIL(a, b)
+    #define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+    #define TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // TRACE_HPP
@@ -0,0 +1,141 @@
+#include "Affine2d.hpp"
+
+#include <type_traits>
+
+#include "Simd.hpp"
+
+namespace NS_math {
+
+// the kernels read a Vector2d array as x0 y0 x1 y1 ...
+static_assert(sizeof(Vector2d) == 2 * sizeof(double), "Vector2d must be two packed doubles");
+static_assert(std::is_standard_layout_v<Vector2d>, "Vector2d must be standard layout");
+
+namespace { // Anonymous namespace for private functions
+
+struct Coefficients {
+    double a, b, tx, c, d, ty;
+};
+
+template <typename Out>
+void applyScalar(const Coefficients& m, const double* in, size_t n, Out* out) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        const double x = in[2 * i];
+        const double y = in[2 * i + 1];
+        out[2 * i] = static_cast<Out>(m.a * x + m.b * y + m.tx);
+        out[2 * i + 1] = static_cast<Out>(m.c * x + m.d * y + m.ty);
+    }
+}
+
+#if NS_MATH_X86
+// one point per register: [x y] -> [a*x + b*y + tx, c*x + d*y + ty]
+inline __m128d applySse2(__m128d point, __m128d col_x, __m128d col_y, __m128d t) noexcept {
+    const __m128d xx = _mm_unpacklo_pd(point, point);
+    const __m128d yy = _mm_unpackhi_pd(point, point);
+    return _mm_add_pd(_mm_add_pd(_mm_mul_pd(xx, col_x), _mm_mul_pd(yy, col_y)), t);
+}
+
+void applyDoubleSse2(const Coefficients& m, const double* in, size_t n, double* out) noexcept {
+    const __m128d col_x = _mm_setr_pd(m.a, m.c);
+    const __m128d col_y = _mm_setr_pd(m.b, m.d);
+    const __m128d t = _mm_setr_pd(m.tx, m.ty);
+    for (size_t i = 0; i < n; ++i) {
+        _mm_storeu_pd(out + 2 * i, applySse2(_mm_loadu_pd(in + 2 * i), col_x, col_y, t));
+    }
+}
+
+void applyFloatSse2(const Coefficients& m, const double* in, size_t n, float* out) noexcept {
+    const __m128d col_x = _mm_setr_pd(m.a, m.c);
+    const __m128d col_y = _mm_setr_pd(m.b, m.d);
+    const __m128d t = _mm_setr_pd(m.tx, m.ty);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128 p0 = _mm_cvtpd_ps(applySse2(_mm_loadu_pd(in + 2 * i), col_x, col_y, t));
+        const __m128 p1 = _mm_cvtpd_ps(applySse2(_mm_loadu_pd(in + 2 * i + 2), col_x, col_y, t));
+        _mm_storeu_ps(out + 2 * i, _mm_movelh_ps(p0, p1));
+    }
+    applyScalar(m, in + 2 * i, n - i, out + 2 * i);
+}
+#endif
+
+#if NS_MATH_HAS_AVX2_KERNELS
+// two points per register: [x0 y0 x1 y1]
+NS_MATH_TARGET_AVX2
+inline __m256d applyAvx2(__m256d points, __m256d col_x, __m256d col_y, __m256d t) noexcept {
+    const __m256d xx = _mm256_movedup_pd(points); // x0 x0 x1 x1
+    const __m256d yy = _mm256_permute_pd(points, 0xF); // y0 y0 y1 y1
+    return _mm256_fmadd_pd(xx, col_x, _mm256_fmadd_pd(yy, col_y, t));
+}
+
+NS_MATH_TARGET_AVX2
+void applyDoubleAvx2(const Coefficients& m, const double* in, size_t n, double* out) noexcept {
+    const __m256d col_x = _mm256_setr_pd(m.a, m.c, m.a, m.c);
+    const __m256d col_y = _mm256_setr_pd(m.b, m.d, m.b, m.d);
+    const __m256d t = _mm256_setr_pd(m.tx, m.ty, m.tx, m.ty);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d p01 = applyAvx2(_mm256_loadu_pd(in + 2 * i), col_x, col_y, t);
+        const __m256d p23 = applyAvx2(_mm256_loadu_pd(in + 2 * i + 4), col_x, col_y, t);
+        _mm256_storeu_pd(out + 2 * i, p01);
+        _mm256_storeu_pd(out + 2 * i + 4, p23);
+    }
+    applyScalar(m, in + 2 * i, n - i, out + 2 * i);
+}
+
+NS_MATH_TARGET_AVX2
+void applyFloatAvx2(const Coefficients& m, const double* in, size_t n, float* out) noexcept {
+    const __m256d col_x = _mm256_setr_pd(m.a, m.c, m.a, m.c);
+    const __m256d col_y = _mm256_setr_pd(m.b, m.d, m.b, m.d);
+    const __m256d t = _mm256_setr_pd(m.tx, m.ty, m.tx, m.ty);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 p01 = _mm256_cvtpd_ps(applyAvx2(_mm256_loadu_pd(in + 2 * i), col_x, col_y, t));
+        const __m128 p23 = _mm256_cvtpd_ps(applyAvx2(_mm256_loadu_pd(in + 2 * i + 4), col_x, col_y, t));
+        _mm256_storeu_ps(out + 2 * i, _mm256_set_m128(p23, p01));
+    }
+    applyScalar(m, in + 2 * i, n - i, out + 2 * i);
+}
+#endif
+
+} // Anonymous namespace end
+
+
+void Affine2d::apply(const Vector2d* in, size_t n, Vector2d* out) const noexcept {
+    if (n == 0) {
+        return;
+    }
+    const Coefficients m {a, b, tx, c, d, ty};
+    const double* src = in[0].getArrayConstReference().data();
+    double* dst = out[0].getArrayRefence().data();
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        applyDoubleAvx2(m, src, n, dst);
+        return;
+    }
+#endif
+#if NS_MATH_X86
+    applyDoubleSse2(m, src, n, dst);
+#else
+    applyScalar(m, src, n, dst);
+#endif
+}
+
+void Affine2d::applyToFloat2(const Vector2d* in, size_t n, float* out_xy) const noexcept {
+    if (n == 0) {
+        return;
+    }
+    const Coefficients m {a, b, tx, c, d, ty};
+    const double* src = in[0].getArrayConstReference().data();
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        applyFloatAvx2(m, src, n, out_xy);
+        return;
+    }
+#endif
+#if NS_MATH_X86
+    applyFloatSse2(m, src, n, out_xy);
+#else
+    applyScalar(m, src, n, out_xy);
+#endif
+}
+
+} // namespace NS_math
@@ -0,0 +1,73 @@
+#ifndef MATH_AFFINE_2D_HPP
+#define MATH_AFFINE_2D_HPP
+
+
+#include <cstddef>
+
+#include "Angle.hpp"
+#include "ComplexNumber.hpp"
+#include "Vector2d.hpp"
+
+namespace NS_math {
+
+/*
+2x3 affine transform of the plane
+  | a  b  tx |   x' = a*x + b*y + tx
+  | c  d  ty |   y' = c*x + d*y + ty
+compose rotate/scale/translate into one matrix, then move all points in one pass
+with apply(span) (SIMD when the CPU has it)
+*/
+class Affine2d { // trivially copyable value type
+    private:
+        double a = 1, b = 0, tx = 0;
+        double c = 0, d = 1, ty = 0;
+
+    public:
+        constexpr Affine2d() noexcept = default;
+        constexpr explicit Affine2d(double arg_a, double arg_b, double arg_tx, double arg_c, double arg_d, double arg_ty) noexcept
+            : a(arg_a), b(arg_b), tx(arg_tx), c(arg_c), d(arg_d), ty(arg_ty) {}
+
+        static constexpr Affine2d identity() noexcept { return Affine2d(); }
+        static constexpr Affine2d translation(double x, double y) noexcept { return Affine2d(1, 0, x, 0, 1, y); }
+        static constexpr Affine2d scaling(double s) noexcept { return Affine2d(s, 0, 0, 0, s, 0); }
+        static constexpr Affine2d scaling(double sx, double sy) noexcept { return Affine2d(sx, 0, 0, 0, sy, 0); }
+        // counterclockwise about the origin, sin/cos come from the Angle memo
+        static Affine2d rotation(const Angle& rad) noexcept {
+            const trig::SinCos sin_cos = rad.getSinCos();
+            return Affine2d(sin_cos.cos, -sin_cos.sin, 0, sin_cos.sin, sin_cos.cos, 0);
+        }
+        // multiplication by a complex number: rotation by its angle and scaling by its magnitude
+        static constexpr Affine2d fromComplex(const ComplexNumber& complex) noexcept {
+            return Affine2d(complex.getRe(), -complex.getIm(), 0, complex.getIm(), complex.getRe(), 0);
+        }
+
+        constexpr double getA() const noexcept { return a; }
+        constexpr double getB() const noexcept { return b; }
+        constexpr double getC() const noexcept { return c; }
+        constexpr double getD() const noexcept { return d; }
+        constexpr double getTx() const noexcept { return tx; }
+        constexpr double getTy() const noexcept { return ty; }
+
+        // (this * other)(p) = this(other(p)), other is applied first
+        constexpr Affine2d operator*(const Affine2d& other) const noexcept {
+            return Affine2d(
+                a * other.a + b * other.c, a * other.b + b * other.d, a * other.tx + b * other.ty + tx,
+                c * other.a + d * other.c, c * other.b + d * other.d, c * other.tx + d * other.ty + ty
+            );
+        }
+        // this first, then next
+        constexpr Affine2d then(const Affine2d& next) const noexcept { return next * *this; }
+
+        Vector2d apply(const Vector2d& point) const {
+            return Vector2d(a * point.x() + b * point.y() + tx, c * point.x() + d * point.y() + ty);
+        }
+
+        // out[i] = this(in[i]), in == out is allowed
+        void apply(const Vector2d* in, size_t n, Vector2d* out) const noexcept;
+        // out_xy[2i], out_xy[2i + 1] = this(in[i]) as float, the layout of an array of SDL_FPoint
+        void applyToFloat2(const Vector2d* in, size_t n, float* out_xy) const noexcept;
+};
+
+} // namespace NS_math
+
+#endif // MATH_AFFINE_2D_HPP
@@ -0,0 +1,47 @@
+#ifndef MATH_ALIGNED_ALLOCATOR_HPP
+#define MATH_ALIGNED_ALLOCATOR_HPP
+
+
+#include <cstddef>
+#include <new>
+
+namespace NS_math {
+
+// std::allocator with a bigger alignment, e.g. 64 for cache lines and aligned AVX loads
+// std::vector<double, AlignedAllocator<double, 64>> v(n); // v.data() % 64 == 0
+template <typename T, size_t Alignment>
+class AlignedAllocator {
+    static_assert(Alignment >= alignof(T), "AlignedAllocator: Alignment is smaller than alignof(T)");
+    static_assert((Alignment & (Alignment - 1)) == 0, "AlignedAllocator: Alignment must be a power of 2");
+
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(size_t n) {
+            if (n > static_cast<size_t>(-1) / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+        void deallocate(T* p, size_t) noexcept {
+            ::operator delete(p, std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+} // namespace NS_math
+
+#endif // MATH_ALIGNED_ALLOCATOR_HPP
@@ -183,7 +183,20 @@ Angle Angle::constructorNoCheck(double rad) {
 }
 
 void Angle::helperNormalizeAngle() {
-    // radians %= PI;
-    radians = fmod(radians, PI * 2);
-    radians = (radians < 0 ? radians + PI * 2 : radians);
+    // sums and differences of normalized angles are within one turn of [0, 2PI),
+    // so fmod is only needed for big values
+    if (radians >= 0 && radians < PI * 2) {
+        return;
+    }
+    if (radians >= PI * 2 && radians < PI * 4) {
+        radians -= PI * 2;
+    } else if (radians < 0 && radians >= -PI * 2) {
+        radians += PI * 2;
+    } else {
+        radians = std::fmod(radians, PI * 2);
+        radians = (radians < 0 ? radians + PI * 2 : radians);
+    }
+    if (radians >= PI * 2) { // -tiny + 2PI rounds up to 2PI
+        radians = 0;
+    }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "../Logger/Logger.hpp"
 #include "MathUtils.hpp"
+#include "FastTrig.hpp"
 
 namespace NS_math {
 
@@ -42,6 +43,8 @@ public:
 
     double getRadians() const { return radians; }
     double getDegrees() const  { return radians * 180.0 / PI; }
+    // memoized, repeated angles (a rotation applied every frame) skip the computation
+    trig::SinCos getSinCos() const noexcept { return trig::cachedSincos(radians); }
 
     void setRadians(double rad);
     void setDegrees(double deg);
@@ -0,0 +1,164 @@
+#include "ComplexArray.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Simd.hpp"
+
+namespace NS_math {
+
+namespace { // Anonymous namespace for private functions
+
+// (ar + i ai) *= (br + i bi), element-wise
+void mulScalar(double* ar, double* ai, const double* br, const double* bi, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        const double r = ar[i] * br[i] - ai[i] * bi[i];
+        const double m = ar[i] * bi[i] + ai[i] * br[i];
+        ar[i] = r;
+        ai[i] = m;
+    }
+}
+
+#if NS_MATH_HAS_AVX2_KERNELS
+NS_MATH_TARGET_AVX2
+void mulAvx2(double* ar, double* ai, const double* br, const double* bi, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d a_re = _mm256_loadu_pd(ar + i);
+        const __m256d a_im = _mm256_loadu_pd(ai + i);
+        const __m256d b_re = _mm256_loadu_pd(br + i);
+        const __m256d b_im = _mm256_loadu_pd(bi + i);
+        _mm256_storeu_pd(ar + i, _mm256_fmsub_pd(a_re, b_re, _mm256_mul_pd(a_im, b_im)));
+        _mm256_storeu_pd(ai + i, _mm256_fmadd_pd(a_re, b_im, _mm256_mul_pd(a_im, b_re)));
+    }
+    mulScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+NS_MATH_TARGET_AVX2
+void magnitudesSquaredAvx2(const double* re, const double* im, double* result, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d r = _mm256_loadu_pd(re + i);
+        const __m256d m = _mm256_loadu_pd(im + i);
+        _mm256_storeu_pd(result + i, _mm256_fmadd_pd(r, r, _mm256_mul_pd(m, m)));
+    }
+    for (; i < n; ++i) {
+        result[i] = re[i] * re[i] + im[i] * im[i];
+    }
+}
+#endif
+
+// add/sub/scale are plain loops over the planes, the compiler vectorizes them already
+
+} // Anonymous namespace end
+
+
+ComplexArray::ComplexArray(const std::vector<ComplexNumber>& complexes)
+    : re(complexes.size()), im(complexes.size())
+{
+    for (size_t i = 0; i < complexes.size(); ++i) {
+        re[i] = complexes[i].getRe();
+        im[i] = complexes[i].getIm();
+    }
+}
+
+void ComplexArray::fill(const ComplexNumber& value) {
+    std::fill(re.begin(), re.end(), value.getRe());
+    std::fill(im.begin(), im.end(), value.getIm());
+}
+
+ComplexNumber ComplexArray::get(size_t index) const {
+    if (index >= size()) {
+        logAndThrow<std::out_of_range>("get(size_t index) const", "index(" + std::to_string(index) + ") out of range");
+    }
+    return ComplexNumber(re[index], im[index]);
+}
+void ComplexArray::set(size_t index, const ComplexNumber& value) {
+    if (index >= size()) {
+        logAndThrow<std::out_of_range>("set(size_t index, const ComplexNumber& value)", "index(" + std::to_string(index) + ") out of range");
+    }
+    re[index] = value.getRe();
+    im[index] = value.getIm();
+}
+
+ComplexArray& ComplexArray::operator+=(const ComplexArray& other) {
+    helperThrowIfSizeNotMatch("operator+=(const ComplexArray& other)", other);
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        re[i] += other.re[i];
+        im[i] += other.im[i];
+    }
+    return *this;
+}
+ComplexArray& ComplexArray::operator-=(const ComplexArray& other) {
+    helperThrowIfSizeNotMatch("operator-=(const ComplexArray& other)", other);
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        re[i] -= other.re[i];
+        im[i] -= other.im[i];
+    }
+    return *this;
+}
+ComplexArray& ComplexArray::operator*=(const ComplexArray& other) {
+    helperThrowIfSizeNotMatch("operator*=(const ComplexArray& other)", other);
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        mulAvx2(re.data(), im.data(), other.re.data(), other.im.data(), size());
+        return *this;
+    }
+#endif
+    mulScalar(re.data(), im.data(), other.re.data(), other.im.data(), size());
+    return *this;
+}
+ComplexArray& ComplexArray::operator*=(double scalar) noexcept {
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        re[i] *= scalar;
+        im[i] *= scalar;
+    }
+    return *this;
+}
+ComplexArray& ComplexArray::conjugate() noexcept {
+    for (double& x : im) {
+        x = -x;
+    }
+    return *this;
+}
+
+void ComplexArray::magnitudesSquared(std::vector<double>& result) const {
+    result.resize(size());
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        magnitudesSquaredAvx2(re.data(), im.data(), result.data(), size());
+        return;
+    }
+#endif
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        result[i] = re[i] * re[i] + im[i] * im[i];
+    }
+}
+void ComplexArray::magnitudes(std::vector<double>& result) const {
+    magnitudesSquared(result);
+    for (double& x : result) {
+        x = std::sqrt(x);
+    }
+}
+
+std::vector<ComplexNumber> ComplexArray::toVector() const {
+    std::vector<ComplexNumber> result;
+    result.reserve(size());
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        result.emplace_back(re[i], im[i]);
+    }
+    return result;
+}
+
+// private
+
+void ComplexArray::helperThrowIfSizeNotMatch(const std::string& func_name, const ComplexArray& other) const {
+    if (size() != other.size()) {
+        logAndThrow<std::invalid_argument>(
+            func_name,
+            "size does not match (" + std::to_string(size()) + " vs " + std::to_string(other.size()) + ")"
+        );
+    }
+}
+
+} // namespace NS_math
@@ -0,0 +1,68 @@
+#ifndef MATH_COMPLEX_ARRAY_HPP
+#define MATH_COMPLEX_ARRAY_HPP
+
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include "ComplexNumber.hpp"
+#include "../Logger/Logger.hpp"
+
+namespace NS_math {
+
+/*
+array of complex numbers stored as two planes (SoA): all real parts, then all imaginary parts
+so element-wise ops run on whole SIMD registers (AVX2 if the CPU has it)
+resize() keeps the capacity, reuse one array instead of creating one per call
+*/
+class ComplexArray {
+    private:
+        std::vector<double> re;
+        std::vector<double> im;
+
+    public:
+        ComplexArray() = default;
+        explicit ComplexArray(size_t n) : re(n, 0.0), im(n, 0.0) {}
+        explicit ComplexArray(const std::vector<double>& real) : re(real), im(real.size(), 0.0) {}
+        explicit ComplexArray(const std::vector<ComplexNumber>& complexes);
+
+        size_t size() const noexcept { return re.size(); }
+        bool empty() const noexcept { return re.empty(); }
+        void resize(size_t n) { re.resize(n, 0.0); im.resize(n, 0.0); }
+        void fill(const ComplexNumber& value);
+
+        double* getRePtr() noexcept { return re.data(); }
+        double* getImPtr() noexcept { return im.data(); }
+        const double* cgetRePtr() const noexcept { return re.data(); }
+        const double* cgetImPtr() const noexcept { return im.data(); }
+
+        ComplexNumber get(size_t index) const;
+        void set(size_t index, const ComplexNumber& value);
+        ComplexNumber operator[](size_t index) const noexcept { return ComplexNumber(re[index], im[index]); }
+
+        // element-wise, sizes must match
+        ComplexArray& operator+=(const ComplexArray& other);
+        ComplexArray& operator-=(const ComplexArray& other);
+        ComplexArray& operator*=(const ComplexArray& other);
+        ComplexArray& operator*=(double scalar) noexcept;
+        ComplexArray& conjugate() noexcept;
+
+        // |z|^2 of every element into result (resized), e.g. the power spectrum after an FFT
+        void magnitudesSquared(std::vector<double>& result) const;
+        void magnitudes(std::vector<double>& result) const;
+
+        std::vector<ComplexNumber> toVector() const;
+
+    private:
+        void helperThrowIfSizeNotMatch(const std::string& func_name, const ComplexArray& other) const;
+
+        template <typename ExceptionType>
+        [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+            Logger::logAndThrow<ExceptionType>("ComplexArray::" + where, what);
+        }
+};
+
+} // namespace NS_math
+
+#endif // MATH_COMPLEX_ARRAY_HPP
@@ -7,137 +7,47 @@
 namespace NS_math {
 
 ComplexNumber ComplexNumber::createFromPolar(double magnitude, const Angle& rad) {
-    return ComplexNumber(
-        magnitude * std::cos(rad.getRadians()), 
-        magnitude * std::sin(rad.getRadians())
-    );
-}
-
-ComplexNumber::ComplexNumber(
-) : Vector2d(0, 0) {
-    helperInitReIm();
-}
-
-ComplexNumber::ComplexNumber(
-    double real
-) : Vector2d(real, 0) {
-    helperInitReIm();
-}
-
-ComplexNumber::ComplexNumber(
-    double real, double imag
-) : Vector2d(real, imag) {
-    helperInitReIm();
+    const trig::SinCos sin_cos = rad.getSinCos();
+    return ComplexNumber(magnitude * sin_cos.cos, magnitude * sin_cos.sin);
 }
 
-ComplexNumber::ComplexNumber(
-    const Vector2d& vect
-) : Vector2d(vect) {
-    helperInitReIm();
-}
-
-ComplexNumber::ComplexNumber(
-    const std::initializer_list<double>& il
-) : Vector2d(il) {
-    helperInitReIm();
-}
-
-ComplexNumber::ComplexNumber(const ComplexNumber& other)
-    : Vector2d(other), precision(other.precision) 
-{
-    helperInitReIm();
+ComplexNumber::ComplexNumber(const std::initializer_list<double>& il) {
+    if (il.size() != 2) {
+        logAndThrow<std::invalid_argument>(
+            "ComplexNumber(const std::initializer_list<double>& il)",
+            "il should have length = 2"
+        );
+    }
+    re = *il.begin();
+    im = *(il.begin() + 1);
 }
 
-ComplexNumber::ComplexNumber(ComplexNumber&& other) = default;
-
 // getters
 
-double ComplexNumber::getRe() const {
-    return (*Re);
-}
-double ComplexNumber::getIm() const {
-    return (*Im);
-}
 double ComplexNumber::getMagnitude() const {
-    return std::sqrt((*Re) * (*Re) + (*Im) * (*Im));
+    return std::sqrt(re * re + im * im);
 }
 Angle ComplexNumber::getAngle() const {
-    return Angle(std::atan2(*Im, *Re));
-}
-
-const double* ComplexNumber::cgetRePtr() const {
-    return Re.get();
-}
-const double* ComplexNumber::cgetImPtr() const {
-    return Im.get();
-}
-
-double* ComplexNumber::getRePtr() {
-    return Re.get();
-}
-double* ComplexNumber::getImPtr() {
-    return Im.get();
+    return Angle(std::atan2(im, re));
 }
 
 // operators with double
 
-ComplexNumber ComplexNumber::operator+(double real) const {
-    return ComplexNumber(
-        (*Re) + real,
-        (*Im)
-    );
-}
-
-ComplexNumber ComplexNumber::operator-(double real) const {
-    return ComplexNumber(
-        (*Re) - real,
-        (*Im)
-    );
-}
-
-ComplexNumber ComplexNumber::operator*(double scalar) const {
-    return ComplexNumber(
-        (*Re) * scalar,
-        (*Im) * scalar
-    );
-}
-
 ComplexNumber ComplexNumber::operator/(double denominator) const {
     if (std::abs(denominator) < precision) {
         logAndThrow<ZeroDivisionException>(
-            "ComplexNumber::operator/(double denominator) const",
+            "operator/(double denominator) const",
             "denominator cannot be 0"
         );
     } 
     return ComplexNumber(
-        (*Re) / denominator,
-        (*Im) / denominator
+        re / denominator,
+        im / denominator
     );
 }
 
 // operators with complex number
 
-ComplexNumber ComplexNumber::operator+(const ComplexNumber& other) const {
-    return ComplexNumber(
-        (*Re) + (*other.Re),
-        (*Im) + (*other.Im)
-    );
-}
-
-ComplexNumber ComplexNumber::operator-(const ComplexNumber& other) const {
-    return ComplexNumber(
-        (*Re) - (*other.Re),
-        (*Im) - (*other.Im)
-    );
-}
-
-ComplexNumber ComplexNumber::operator*(const ComplexNumber& other) const {
-    return ComplexNumber(
-        (*Re) * (*other.Re) - (*Im) * (*other.Im),
-        (*Re) * (*other.Im) + (*Im) * (*other.Re)
-    );
-} 
-
 ComplexNumber ComplexNumber::operator/(const ComplexNumber& complex) const {
     double d = complex.mulWithComjugate();
     if (d < precision) { // d is in [0, inf)
@@ -150,28 +60,6 @@ ComplexNumber ComplexNumber::operator/(const ComplexNumber& complex) const {
 }
 
 
-Vector2d ComplexNumber::toVector2d() const {
-    return Vector2d(*Re, *Im);
-}
-
-ComplexNumber ComplexNumber::toConjugate() const {
-    return ComplexNumber((*Re), -(*Im));
-}
-
-
-double ComplexNumber::mulWithComjugate() const {
-    return (*Re) * (*Re) + (*Im) * (*Im);
-}
-
-bool ComplexNumber::isReal() const {
-    return std::abs(*Im) < precision;
-}
-
-void ComplexNumber::helperInitReIm() {
-    this->Re = std::make_unique<double>(data[0]);
-    this->Im = std::make_unique<double>(data[1]);
-}
-
 void ComplexNumber::log(const std::string &where, const std::string &what, const Logger::LogLevel& lev) const {
     Logger::log("ComplexNumber::" + where, what, lev);
 }
@@ -3,66 +3,84 @@
 
 
 #include "Vector2d.hpp"
-#include <memory>
+#include <initializer_list>
+#include <type_traits>
 #include "Angle.hpp"
 
 namespace NS_math {
-class ComplexNumber : protected Vector2d {
+class ComplexNumber { // trivially copyable value type, no allocation
     private:
-        double precision = 1e-6;
-        std::unique_ptr<double> Re;
-        std::unique_ptr<double> Im;
+        double re = 0;
+        double im = 0;
     public:
+        static constexpr double precision = 1e-6;
+
         static ComplexNumber createFromPolar(double magnitude, const Angle& rad);
-        explicit ComplexNumber();
-        explicit ComplexNumber(double real);
-        explicit ComplexNumber(double real, double imag);
-        explicit ComplexNumber(const Vector2d& vect);
+        constexpr explicit ComplexNumber() noexcept = default;
+        constexpr explicit ComplexNumber(double real) noexcept : re(real) {}
+        constexpr explicit ComplexNumber(double real, double imag) noexcept : re(real), im(imag) {}
+        explicit ComplexNumber(const Vector2d& vect) noexcept : re(vect.x()), im(vect.y()) {}
         explicit ComplexNumber(const std::initializer_list<double>& il);
 
-        ComplexNumber(const ComplexNumber& other);
-        ComplexNumber(ComplexNumber&& other);
+        constexpr ComplexNumber(const ComplexNumber& other) noexcept = default;
+        constexpr ComplexNumber(ComplexNumber&& other) noexcept = default;
+        constexpr ComplexNumber& operator=(const ComplexNumber& other) noexcept = default;
+        constexpr ComplexNumber& operator=(ComplexNumber&& other) noexcept = default;
 
-        double getRe() const;
-        double getIm() const;
+        constexpr double getRe() const noexcept { return re; }
+        constexpr double getIm() const noexcept { return im; }
         double getMagnitude() const;
         Angle getAngle() const;
 
-        const double* cgetRePtr() const;
-        const double* cgetImPtr() const;
+        constexpr const double* cgetRePtr() const noexcept { return &re; }
+        constexpr const double* cgetImPtr() const noexcept { return &im; }
 
-        double* getRePtr();
-        double* getImPtr();
+        constexpr double* getRePtr() noexcept { return &re; }
+        constexpr double* getImPtr() noexcept { return &im; }
 
-        ComplexNumber operator+(double real) const;
-        ComplexNumber operator-(double real) const;
-        ComplexNumber operator*(double scalar) const;
+        constexpr ComplexNumber operator+(double real) const noexcept { return ComplexNumber(re + real, im); }
+        constexpr ComplexNumber operator-(double real) const noexcept { return ComplexNumber(re - real, im); }
+        constexpr ComplexNumber operator*(double scalar) const noexcept { return ComplexNumber(re * scalar, im * scalar); }
         ComplexNumber operator/(double denominator) const;
         
-        ComplexNumber operator+(const ComplexNumber& complex) const;
-        ComplexNumber operator-(const ComplexNumber& complex) const;
-        ComplexNumber operator*(const ComplexNumber& complex) const;
+        constexpr ComplexNumber operator+(const ComplexNumber& complex) const noexcept {
+            return ComplexNumber(re + complex.re, im + complex.im);
+        }
+        constexpr ComplexNumber operator-(const ComplexNumber& complex) const noexcept {
+            return ComplexNumber(re - complex.re, im - complex.im);
+        }
+        constexpr ComplexNumber operator*(const ComplexNumber& complex) const noexcept {
+            return ComplexNumber(
+                re * complex.re - im * complex.im,
+                re * complex.im + im * complex.re
+            );
+        }
         ComplexNumber operator/(const ComplexNumber& complex) const;
 
-        Vector2d toVector2d() const;
-        ComplexNumber toConjugate() const;
+        constexpr ComplexNumber& operator+=(const ComplexNumber& complex) noexcept { return *this = *this + complex; }
+        constexpr ComplexNumber& operator-=(const ComplexNumber& complex) noexcept { return *this = *this - complex; }
+        constexpr ComplexNumber& operator*=(const ComplexNumber& complex) noexcept { return *this = *this * complex; }
+        constexpr ComplexNumber& operator*=(double scalar) noexcept { return *this = *this * scalar; }
+
+        Vector2d toVector2d() const { return Vector2d(re, im); }
+        constexpr ComplexNumber toConjugate() const noexcept { return ComplexNumber(re, -im); }
 
-        double mulWithComjugate() const;
+        constexpr double mulWithComjugate() const noexcept { return re * re + im * im; }
 
-        bool isReal() const;
+        bool isReal() const noexcept { return (im < 0 ? -im : im) < precision; }
 
         
 
     private:
-        void helperInitReIm();
-
         void log(const std::string& where, const std::string& what, const Logger::LogLevel& lev) const;
         template <typename ExceptionType>
         [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const;
 
 };
+
+static_assert(std::is_trivially_copyable_v<ComplexNumber>, "ComplexNumber must stay a plain value type");
 }
 
 #include "ComplexNumber.inl"
 
-#endif // COMPLEX_NUMBER_HPP
\ No newline at end of file
+#endif // COMPLEX_NUMBER_HPP
@@ -9,7 +9,7 @@ namespace NS_math {
 
 template <typename ExceptionType>
 [[noreturn]] void ComplexNumber::logAndThrow(const std::string& where, const std::string& what) const {
-    Logger::logAndThrow("ComplexNumber::" + where, what);
+    Logger::logAndThrow<ExceptionType>("ComplexNumber::" + where, what);
 }
 
 }
@@ -0,0 +1,105 @@
+#ifndef MATH_DENSE_MATRIX_HPP
+#define MATH_DENSE_MATRIX_HPP
+
+
+#include <initializer_list>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Logger/Logger.hpp"
+#include "AlignedAllocator.hpp"
+
+namespace NS_math {
+
+/*
+runtime sized matrix, row-major and contiguous, storage aligned to 64 bytes (a cache line)
+(Matrix<RowN, ColN> is the fixed size one)
+operator* for double goes to matrix_kernels::mulBlocked: packed, cache blocked,
+register tiled (AVX2 when available) and spread over all hardware threads
+other element types use a cache friendly i-k-j loop
+*/
+template <typename T>
+class DenseMatrix {
+
+    static_assert(std::is_arithmetic_v<T>, "DenseMatrix: T must be an arithmetic type");
+
+    public:
+        static constexpr size_t alignment = 64;
+        using StorageT = std::vector<T, AlignedAllocator<T, alignment>>;
+
+    private:
+        size_t row_num = 0;
+        size_t col_num = 0;
+        StorageT elems;
+
+    public:
+        DenseMatrix() = default;
+        DenseMatrix(size_t arg_row_num, size_t arg_col_num, const T& default_val = T());
+        DenseMatrix(std::initializer_list<std::initializer_list<T>> arg_data); // using initializer_list, don't use explicit
+
+        static DenseMatrix<T> identity(size_t n);
+
+        inline std::pair<size_t, size_t> size() const noexcept { return std::make_pair(row_num, col_num); }
+        inline size_t num_of_row() const noexcept { return row_num; }
+        inline size_t num_of_col() const noexcept { return col_num; }
+        inline bool empty() const noexcept { return elems.empty(); }
+
+        // element (r, c) is data()[r * num_of_col() + c]
+        inline T* data() noexcept { return elems.data(); }
+        inline const T* data() const noexcept { return elems.data(); }
+        inline T* row(size_t r) noexcept { return elems.data() + r * col_num; }
+        inline const T* row(size_t r) const noexcept { return elems.data() + r * col_num; }
+
+        // unchecked
+        inline T& operator()(size_t r, size_t c) noexcept { return elems[r * col_num + c]; }
+        inline const T& operator()(size_t r, size_t c) const noexcept { return elems[r * col_num + c]; }
+        // throws std::out_of_range
+        T& at(size_t r, size_t c);
+        const T& at(size_t r, size_t c) const;
+
+        // drops the content
+        void resize(size_t arg_row_num, size_t arg_col_num, const T& default_val = T());
+        void fill(const T& value);
+
+        bool operator==(const DenseMatrix<T>& other) const;
+        bool operator!=(const DenseMatrix<T>& other) const { return !(*this == other); }
+
+        DenseMatrix<T> operator-() const;
+        DenseMatrix<T> operator+(const DenseMatrix<T>& other) const;
+        DenseMatrix<T> operator-(const DenseMatrix<T>& other) const;
+        DenseMatrix<T>& operator+=(const DenseMatrix<T>& other);
+        DenseMatrix<T>& operator-=(const DenseMatrix<T>& other);
+
+        DenseMatrix<T> operator*(const T& scalar) const;
+        DenseMatrix<T>& operator*=(const T& scalar) noexcept;
+
+        // throws std::invalid_argument if num_of_col() != other.num_of_row()
+        DenseMatrix<T> operator*(const DenseMatrix<T>& other) const;
+        // result = a * b, reuses the storage of result (must not be a or b)
+        static void mulInto(const DenseMatrix<T>& a, const DenseMatrix<T>& b, DenseMatrix<T>& result);
+
+        DenseMatrix<T> transpose() const;
+
+        std::string to_string() const;
+
+    private:
+        static size_t helperCheckedSize(size_t arg_row_num, size_t arg_col_num);
+        void helperThrowIfSizeNotMatch(const std::string& func_name, const DenseMatrix<T>& other) const;
+
+        template <typename ExceptionType>
+        [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+            Logger::logAndThrow<ExceptionType>("DenseMatrix::" + where, what);
+        }
+};
+
+template <typename T>
+inline DenseMatrix<T> operator*(const T& scalar, const DenseMatrix<T>& matrix) { return matrix * scalar; }
+
+} // namespace NS_math
+
+#include "DenseMatrix.inl"
+
+#endif // MATH_DENSE_MATRIX_HPP
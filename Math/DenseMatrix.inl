@@ -0,0 +1,270 @@
+#pragma once
+#ifndef MATH_DENSE_MATRIX_INL
+#define MATH_DENSE_MATRIX_INL
+
+
+#include <algorithm>
+#include <sstream>
+
+#include "DenseMatrix.hpp"
+#include "MatrixKernels.hpp"
+
+
+namespace NS_math {
+
+namespace dense_matrix_detail {
+
+// c = a * b (c zeroed here), k in blocks so a block of rows of b stays in cache
+// the inner loop runs along rows of b and c, which the compiler vectorizes
+template <typename T>
+void mulGeneric(const T* a, const T* b, T* c, size_t m, size_t k, size_t n) noexcept {
+    constexpr size_t BLOCK_K = 128;
+    std::fill_n(c, m * n, T());
+    for (size_t p0 = 0; p0 < k; p0 += BLOCK_K) {
+        const size_t p1 = std::min(k, p0 + BLOCK_K);
+        for (size_t i = 0; i < m; ++i) {
+            T* c_row = c + i * n;
+            for (size_t p = p0; p < p1; ++p) {
+                const T a_ip = a[i * k + p];
+                const T* b_row = b + p * n;
+                for (size_t j = 0; j < n; ++j) {
+                    c_row[j] += a_ip * b_row[j];
+                }
+            }
+        }
+    }
+}
+
+} // namespace dense_matrix_detail
+
+// constructors
+
+template <typename T>
+inline DenseMatrix<T>::DenseMatrix(size_t arg_row_num, size_t arg_col_num, const T& default_val)
+    : row_num(arg_row_num), col_num(arg_col_num), elems(helperCheckedSize(arg_row_num, arg_col_num), default_val) {}
+
+template <typename T>
+inline DenseMatrix<T>::DenseMatrix(std::initializer_list<std::initializer_list<T>> arg_data)
+    : row_num(arg_data.size()), col_num(arg_data.size() ? arg_data.begin()->size() : 0) {
+    elems.reserve(row_num * col_num);
+    for (const std::initializer_list<T>& arg_row : arg_data) {
+        if (arg_row.size() != col_num) {
+            logAndThrow<std::invalid_argument>(
+                "DenseMatrix(std::initializer_list<std::initializer_list<T>>)",
+                "rows have different sizes"
+            );
+        }
+        elems.insert(elems.end(), arg_row.begin(), arg_row.end());
+    }
+}
+
+template <typename T>
+inline DenseMatrix<T> DenseMatrix<T>::identity(size_t n) {
+    DenseMatrix<T> result(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        result(i, i) = T(1);
+    }
+    return result;
+}
+
+// element access
+
+template <typename T>
+inline T& DenseMatrix<T>::at(size_t r, size_t c) {
+    if (r >= row_num || c >= col_num) {
+        logAndThrow<std::out_of_range>(
+            "at(size_t r, size_t c)",
+            "(" + std::to_string(r) + ", " + std::to_string(c) + ") out of range, size is "
+                + std::to_string(row_num) + "x" + std::to_string(col_num)
+        );
+    }
+    return (*this)(r, c);
+}
+
+template <typename T>
+inline const T& DenseMatrix<T>::at(size_t r, size_t c) const {
+    if (r >= row_num || c >= col_num) {
+        logAndThrow<std::out_of_range>(
+            "at(size_t r, size_t c) const",
+            "(" + std::to_string(r) + ", " + std::to_string(c) + ") out of range, size is "
+                + std::to_string(row_num) + "x" + std::to_string(col_num)
+        );
+    }
+    return (*this)(r, c);
+}
+
+template <typename T>
+inline void DenseMatrix<T>::resize(size_t arg_row_num, size_t arg_col_num, const T& default_val) {
+    elems.assign(helperCheckedSize(arg_row_num, arg_col_num), default_val);
+    row_num = arg_row_num;
+    col_num = arg_col_num;
+}
+
+template <typename T>
+inline void DenseMatrix<T>::fill(const T& value) {
+    std::fill(elems.begin(), elems.end(), value);
+}
+
+// comparison
+
+template <typename T>
+inline bool DenseMatrix<T>::operator==(const DenseMatrix<T>& other) const {
+    return row_num == other.row_num && col_num == other.col_num && elems == other.elems;
+}
+
+// element-wise arithmetic
+
+template <typename T>
+inline DenseMatrix<T> DenseMatrix<T>::operator-() const {
+    DenseMatrix<T> result(*this);
+    for (T& elem : result.elems) {
+        elem = -elem;
+    }
+    return result;
+}
+
+template <typename T>
+inline DenseMatrix<T> DenseMatrix<T>::operator+(const DenseMatrix<T>& other) const {
+    DenseMatrix<T> result(*this);
+    result += other;
+    return result;
+}
+
+template <typename T>
+inline DenseMatrix<T> DenseMatrix<T>::operator-(const DenseMatrix<T>& other) const {
+    DenseMatrix<T> result(*this);
+    result -= other;
+    return result;
+}
+
+template <typename T>
+inline DenseMatrix<T>& DenseMatrix<T>::operator+=(const DenseMatrix<T>& other) {
+    helperThrowIfSizeNotMatch("operator+=(const DenseMatrix<T>& other)", other);
+    T* dst = elems.data();
+    const T* src = other.elems.data();
+    for (size_t i = 0, n = elems.size(); i < n; ++i) {
+        dst[i] += src[i];
+    }
+    return *this;
+}
+
+template <typename T>
+inline DenseMatrix<T>& DenseMatrix<T>::operator-=(const DenseMatrix<T>& other) {
+    helperThrowIfSizeNotMatch("operator-=(const DenseMatrix<T>& other)", other);
+    T* dst = elems.data();
+    const T* src = other.elems.data();
+    for (size_t i = 0, n = elems.size(); i < n; ++i) {
+        dst[i] -= src[i];
+    }
+    return *this;
+}
+
+template <typename T>
+inline DenseMatrix<T> DenseMatrix<T>::operator*(const T& scalar) const {
+    DenseMatrix<T> result(*this);
+    result *= scalar;
+    return result;
+}
+
+template <typename T>
+inline DenseMatrix<T>& DenseMatrix<T>::operator*=(const T& scalar) noexcept {
+    for (T& elem : elems) {
+        elem *= scalar;
+    }
+    return *this;
+}
+
+// matrix multiplication
+
+template <typename T>
+inline DenseMatrix<T> DenseMatrix<T>::operator*(const DenseMatrix<T>& other) const {
+    DenseMatrix<T> result;
+    mulInto(*this, other, result);
+    return result;
+}
+
+template <typename T>
+inline void DenseMatrix<T>::mulInto(const DenseMatrix<T>& a, const DenseMatrix<T>& b, DenseMatrix<T>& result) {
+    if (a.col_num != b.row_num) {
+        a.logAndThrow<std::invalid_argument>(
+            "mulInto(const DenseMatrix<T>& a, const DenseMatrix<T>& b, DenseMatrix<T>& result)",
+            "cannot multiply " + std::to_string(a.row_num) + "x" + std::to_string(a.col_num)
+                + " by " + std::to_string(b.row_num) + "x" + std::to_string(b.col_num)
+        );
+    }
+    if (&result == &a || &result == &b) {
+        a.logAndThrow<std::invalid_argument>(
+            "mulInto(const DenseMatrix<T>& a, const DenseMatrix<T>& b, DenseMatrix<T>& result)",
+            "result must not be a or b"
+        );
+    }
+    result.elems.resize(a.row_num * b.col_num);
+    result.row_num = a.row_num;
+    result.col_num = b.col_num;
+    if constexpr (std::is_same_v<T, double>) {
+        matrix_kernels::mulDynamic(a.data(), b.data(), result.data(), a.row_num, a.col_num, b.col_num);
+    } else {
+        dense_matrix_detail::mulGeneric(a.data(), b.data(), result.data(), a.row_num, a.col_num, b.col_num);
+    }
+}
+
+template <typename T>
+inline DenseMatrix<T> DenseMatrix<T>::transpose() const {
+    constexpr size_t BLOCK = 32; // a 32x32 block of both matrices stays in L1
+    DenseMatrix<T> result(col_num, row_num);
+    for (size_t i0 = 0; i0 < row_num; i0 += BLOCK) {
+        for (size_t j0 = 0; j0 < col_num; j0 += BLOCK) {
+            const size_t i1 = std::min(row_num, i0 + BLOCK);
+            const size_t j1 = std::min(col_num, j0 + BLOCK);
+            for (size_t i = i0; i < i1; ++i) {
+                for (size_t j = j0; j < j1; ++j) {
+                    result(j, i) = (*this)(i, j);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+inline std::string DenseMatrix<T>::to_string() const {
+    std::ostringstream stream;
+    stream << "[";
+    for (size_t i = 0; i < row_num; ++i) {
+        stream << (i ? ", \n [" : "[");
+        for (size_t j = 0; j < col_num; ++j) {
+            stream << (j ? ", " : "") << (*this)(i, j);
+        }
+        stream << "]";
+    }
+    stream << "]";
+    return stream.str();
+}
+
+// private
+
+template <typename T>
+inline size_t DenseMatrix<T>::helperCheckedSize(size_t arg_row_num, size_t arg_col_num) {
+    if (arg_col_num != 0 && arg_row_num > StorageT().max_size() / arg_col_num) {
+        Logger::logAndThrow<std::length_error>(
+            "DenseMatrix::helperCheckedSize(size_t arg_row_num, size_t arg_col_num)",
+            std::to_string(arg_row_num) + "x" + std::to_string(arg_col_num) + " is too big"
+        );
+    }
+    return arg_row_num * arg_col_num;
+}
+
+template <typename T>
+inline void DenseMatrix<T>::helperThrowIfSizeNotMatch(const std::string& func_name, const DenseMatrix<T>& other) const {
+    if (row_num != other.row_num || col_num != other.col_num) {
+        logAndThrow<std::invalid_argument>(
+            func_name,
+            "size not match, " + std::to_string(row_num) + "x" + std::to_string(col_num)
+                + " and " + std::to_string(other.row_num) + "x" + std::to_string(other.col_num)
+        );
+    }
+}
+
+} // namespace NS_math
+
+#endif // MATH_DENSE_MATRIX_INL
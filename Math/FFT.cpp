@@ -0,0 +1,157 @@
+#include "FFT.hpp"
+
+#include <cmath>
+#include <utility>
+
+#include "MathUtils.hpp"
+
+namespace NS_math {
+
+FFTPlan::FFTPlan(size_t arg_n)
+    : n(arg_n), is_power_of_2(isPowerOf2(arg_n))
+{
+    if (n == 0) {
+        logAndThrow<std::invalid_argument>("FFTPlan(size_t arg_n) /* constructor */", "size cannot be 0");
+    }
+    if (is_power_of_2) {
+        twiddle_re.resize(n / 2);
+        twiddle_im.resize(n / 2);
+        for (size_t k = 0; k < n / 2; ++k) {
+            const double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(n);
+            twiddle_re[k] = std::cos(angle);
+            twiddle_im[k] = std::sin(angle);
+        }
+        size_t num_of_bits = 0;
+        while ((size_t(1) << num_of_bits) < n) {
+            ++num_of_bits;
+        }
+        bit_reverse.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t reversed = 0;
+            for (size_t b = 0; b < num_of_bits; ++b) {
+                reversed |= static_cast<uint32_t>(((i >> b) & 1) << (num_of_bits - 1 - b));
+            }
+            bit_reverse[i] = reversed;
+        }
+        return;
+    }
+
+    size_t m = 1;
+    while (m < 2 * n - 1) {
+        m <<= 1;
+    }
+    inner_plan = std::make_unique<FFTPlan>(m);
+    chirp.resize(n);
+    filter_spectrum.resize(m);
+    work.resize(m);
+    for (size_t k = 0; k < n; ++k) {
+        // k^2 mod 2n keeps the angle small and exact for big k
+        const size_t k2 = (k * k) % (2 * n);
+        const double angle = PI * static_cast<double>(k2) / static_cast<double>(n);
+        chirp.getRePtr()[k] = std::cos(angle);
+        chirp.getImPtr()[k] = -std::sin(angle);
+        // the filter is conj(chirp) at +k and -k (wrapped)
+        filter_spectrum.getRePtr()[k] = std::cos(angle);
+        filter_spectrum.getImPtr()[k] = std::sin(angle);
+        if (k != 0) {
+            filter_spectrum.getRePtr()[m - k] = std::cos(angle);
+            filter_spectrum.getImPtr()[m - k] = std::sin(angle);
+        }
+    }
+    inner_plan->forward(filter_spectrum);
+}
+
+void FFTPlan::forward(ComplexArray& data) const {
+    helperThrowIfSizeNotMatch("forward(ComplexArray& data) const", data);
+    if (is_power_of_2) {
+        helperRadix2(data.getRePtr(), data.getImPtr(), false);
+    } else {
+        helperBluestein(data);
+    }
+}
+
+void FFTPlan::inverse(ComplexArray& data) const {
+    helperThrowIfSizeNotMatch("inverse(ComplexArray& data) const", data);
+    if (is_power_of_2) {
+        helperRadix2(data.getRePtr(), data.getImPtr(), true);
+    } else {
+        // ifft(x) = conj(fft(conj(x))) / n
+        data.conjugate();
+        helperBluestein(data);
+        data.conjugate();
+    }
+    data *= 1.0 / static_cast<double>(n);
+}
+
+// private
+
+void FFTPlan::helperRadix2(double* re, double* im, bool is_inverse) const noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        const size_t j = bit_reverse[i];
+        if (i < j) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+    const double sign = is_inverse ? -1.0 : 1.0;
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t step = n / len;
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t k = 0; k < half; ++k) {
+                const double w_re = twiddle_re[k * step];
+                const double w_im = sign * twiddle_im[k * step];
+                const size_t a = start + k;
+                const size_t b = a + half;
+                const double t_re = re[b] * w_re - im[b] * w_im;
+                const double t_im = re[b] * w_im + im[b] * w_re;
+                re[b] = re[a] - t_re;
+                im[b] = im[a] - t_im;
+                re[a] += t_re;
+                im[a] += t_im;
+            }
+        }
+    }
+}
+
+void FFTPlan::helperBluestein(ComplexArray& data) const {
+    const size_t m = work.size();
+    double* w_re = work.getRePtr();
+    double* w_im = work.getImPtr();
+    const double* c_re = chirp.cgetRePtr();
+    const double* c_im = chirp.cgetImPtr();
+    double* d_re = data.getRePtr();
+    double* d_im = data.getImPtr();
+
+    // a[k] = x[k] * chirp[k], zero padded
+    for (size_t k = 0; k < n; ++k) {
+        w_re[k] = d_re[k] * c_re[k] - d_im[k] * c_im[k];
+        w_im[k] = d_re[k] * c_im[k] + d_im[k] * c_re[k];
+    }
+    for (size_t k = n; k < m; ++k) {
+        w_re[k] = 0;
+        w_im[k] = 0;
+    }
+    // circular convolution with the filter
+    inner_plan->forward(work);
+    work *= filter_spectrum;
+    inner_plan->inverse(work);
+    // X[k] = chirp[k] * (a * filter)[k]
+    for (size_t k = 0; k < n; ++k) {
+        const double r = w_re[k] * c_re[k] - w_im[k] * c_im[k];
+        const double i = w_re[k] * c_im[k] + w_im[k] * c_re[k];
+        d_re[k] = r;
+        d_im[k] = i;
+    }
+}
+
+void FFTPlan::helperThrowIfSizeNotMatch(const std::string& func_name, const ComplexArray& data) const {
+    if (data.size() != n) {
+        logAndThrow<std::invalid_argument>(
+            func_name,
+            "data size(" + std::to_string(data.size()) + ") does not match plan size(" + std::to_string(n) + ")"
+        );
+    }
+}
+
+} // namespace NS_math
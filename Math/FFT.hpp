@@ -0,0 +1,69 @@
+#ifndef MATH_FFT_HPP
+#define MATH_FFT_HPP
+
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include "ComplexArray.hpp"
+#include "../Logger/Logger.hpp"
+
+namespace NS_math {
+
+/*
+in-place discrete Fourier transform of one fixed size
+twiddles and the bit-reversal table are computed once in the constructor,
+so transforms do not allocate
+  - power of 2 sizes: iterative radix-2
+  - other sizes: Bluestein (chirp-z), the convolution runs on a power of 2 plan
+caution: a plan keeps a work buffer, use one plan per thread
+*/
+class FFTPlan {
+    private:
+        size_t n;
+        bool is_power_of_2;
+
+        // radix-2
+        std::vector<double> twiddle_re; // cos(-2*pi*k/n), k < n/2
+        std::vector<double> twiddle_im; // sin(-2*pi*k/n)
+        std::vector<uint32_t> bit_reverse;
+
+        // Bluestein
+        std::unique_ptr<FFTPlan> inner_plan; // size m (power of 2, >= 2n-1)
+        ComplexArray chirp; // exp(-i*pi*k^2/n), k < n
+        ComplexArray filter_spectrum; // FFT of the conjugate chirp, wrapped to size m
+        mutable ComplexArray work; // size m
+
+    public:
+        explicit FFTPlan(size_t arg_n);
+
+        FFTPlan(const FFTPlan&) = delete; // disable copy constructor
+        FFTPlan& operator=(const FFTPlan&) = delete; // disable copy assignment
+
+        size_t size() const noexcept { return n; }
+
+        // X[k] = sum x[j] * exp(-2*pi*i*jk/n)
+        void forward(ComplexArray& data) const;
+        // inverse of forward, including the 1/n
+        void inverse(ComplexArray& data) const;
+
+        static bool isPowerOf2(size_t x) noexcept { return x != 0 && (x & (x - 1)) == 0; }
+
+    private:
+        // unscaled, inverse uses the conjugate twiddles
+        void helperRadix2(double* re, double* im, bool is_inverse) const noexcept;
+        void helperBluestein(ComplexArray& data) const;
+        void helperThrowIfSizeNotMatch(const std::string& func_name, const ComplexArray& data) const;
+
+        template <typename ExceptionType>
+        [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+            Logger::logAndThrow<ExceptionType>("FFTPlan::" + where, what);
+        }
+};
+
+} // namespace NS_math
+
+#endif // MATH_FFT_HPP
@@ -0,0 +1,181 @@
+#include "FastTrig.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace NS_math {
+namespace trig {
+
+namespace { // Anonymous namespace for private functions
+
+constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+// pi/2 split so that j * PIO2_1 and j * PIO2_2 are exact for |j| < 2^20 (fdlibm)
+constexpr double PIO2_1 = 1.57079632673412561417e+00;
+constexpr double PIO2_2 = 6.07710050630396597660e-11;
+constexpr double PIO2_2T = 2.02226624879595063154e-21;
+constexpr double POLYNOMIAL_LIMIT = 1e6;
+// adding 1.5 * 2^52 rounds to an integer and leaves it in the low mantissa bits
+constexpr double ROUND_MAGIC = 6755399441055744.0;
+
+// minimax coefficients on [-pi/4, pi/4] (fdlibm __kernel_sin / __kernel_cos)
+constexpr double S1 = -1.66666666666666324348e-01;
+constexpr double S2 = 8.33333333332248946124e-03;
+constexpr double S3 = -1.98412698298579493134e-04;
+constexpr double S4 = 2.75573137070700676789e-06;
+constexpr double S5 = -2.50507602534068634195e-08;
+constexpr double S6 = 1.58969099521155010221e-10;
+
+constexpr double C1 = 4.16666666666666019037e-02;
+constexpr double C2 = -1.38888888888741095749e-03;
+constexpr double C3 = 2.48015872894767294178e-05;
+constexpr double C4 = -2.75573143513906633035e-07;
+constexpr double C5 = 2.08757232129817482790e-09;
+constexpr double C6 = -1.13596475577881948265e-11;
+
+constexpr size_t TABLE_SIZE = 4096; // power of 2
+constexpr double TABLE_STEP_INV = TABLE_SIZE / 6.28318530717958647692;
+
+inline uint64_t toBits(double x) noexcept {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+inline double fromBits(uint64_t bits) noexcept {
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// |x| < POLYNOMIAL_LIMIT
+inline SinCos polynomialSincos(double x) noexcept {
+    // x = q * pi/2 + r, |r| <= pi/4
+    // (magic number rounding instead of nearbyint, SSE2 has no vector round)
+    const double shifted = x * TWO_OVER_PI + ROUND_MAGIC;
+    const double q = shifted - ROUND_MAGIC;
+    const double r = ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_2T;
+    const double z = r * r;
+    const double s = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+    const double c = 1.0 - 0.5 * z + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+    // quadrant: 0 (s, c), 1 (c, -s), 2 (-s, -c), 3 (-c, s)
+    // selected with bit masks, data dependent branches would mispredict half the time
+    const uint64_t quadrant = toBits(shifted);
+    const uint64_t swap_mask = 0 - (quadrant & 1);
+    const uint64_t sin_sign = (quadrant & 2) << 62;
+    const uint64_t cos_sign = ((quadrant + 1) & 2) << 62;
+    const uint64_t s_bits = toBits(s);
+    const uint64_t c_bits = toBits(c);
+    return {
+        fromBits(((s_bits & ~swap_mask) | (c_bits & swap_mask)) ^ sin_sign),
+        fromBits(((c_bits & ~swap_mask) | (s_bits & swap_mask)) ^ cos_sign)
+    };
+}
+
+const std::array<double, TABLE_SIZE + 1>& sinTable() {
+    static const std::array<double, TABLE_SIZE + 1> table = [] {
+        std::array<double, TABLE_SIZE + 1> result {};
+        for (size_t i = 0; i <= TABLE_SIZE; ++i) {
+            result[i] = std::sin(static_cast<double>(i) / TABLE_STEP_INV);
+        }
+        return result;
+    }();
+    return table;
+}
+
+inline SinCos tableSincos(const std::array<double, TABLE_SIZE + 1>& table, double x) noexcept {
+    const double position = x * TABLE_STEP_INV;
+    const double index_floor = std::floor(position);
+    const double frac = position - index_floor;
+    // wraps negative angles too (two's complement)
+    const size_t i = static_cast<size_t>(static_cast<int64_t>(index_floor)) & (TABLE_SIZE - 1);
+    // cos(x) = sin(x + pi/2), a quarter of the table further
+    const size_t j = (i + TABLE_SIZE / 4) & (TABLE_SIZE - 1);
+    return {
+        table[i] + (table[i + 1] - table[i]) * frac,
+        table[j] + (table[j + 1] - table[j]) * frac
+    };
+}
+
+SinCos exactSincos(double x) noexcept {
+    return {std::sin(x), std::cos(x)};
+}
+
+} // Anonymous namespace end
+
+
+SinCos sincos(double radians, Accuracy accuracy) noexcept {
+    switch (accuracy) {
+        case Accuracy::Polynomial:
+            if (std::abs(radians) < POLYNOMIAL_LIMIT) {
+                return polynomialSincos(radians);
+            }
+            return exactSincos(radians);
+        case Accuracy::Table:
+            if (std::abs(radians) < POLYNOMIAL_LIMIT) {
+                return tableSincos(sinTable(), radians);
+            }
+            return exactSincos(radians);
+        case Accuracy::Exact:
+        default:
+            return exactSincos(radians);
+    }
+}
+
+void sincos(const double* radians, double* sin_out, double* cos_out, size_t n, Accuracy accuracy) noexcept {
+    if (accuracy == Accuracy::Exact) {
+        for (size_t i = 0; i < n; ++i) {
+            sin_out[i] = std::sin(radians[i]);
+            cos_out[i] = std::cos(radians[i]);
+        }
+        return;
+    }
+    // angles outside the reduction range are computed as 0 here and fixed up below,
+    // so the main loops have no branches and vectorize
+    if (accuracy == Accuracy::Table) {
+        const std::array<double, TABLE_SIZE + 1>& table = sinTable();
+        for (size_t i = 0; i < n; ++i) {
+            const double x = std::abs(radians[i]) < POLYNOMIAL_LIMIT ? radians[i] : 0.0;
+            const SinCos result = tableSincos(table, x);
+            sin_out[i] = result.sin;
+            cos_out[i] = result.cos;
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            const double x = std::abs(radians[i]) < POLYNOMIAL_LIMIT ? radians[i] : 0.0;
+            const SinCos result = polynomialSincos(x);
+            sin_out[i] = result.sin;
+            cos_out[i] = result.cos;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!(std::abs(radians[i]) < POLYNOMIAL_LIMIT)) {
+            sin_out[i] = std::sin(radians[i]);
+            cos_out[i] = std::cos(radians[i]);
+        }
+    }
+}
+
+SinCos cachedSincos(double radians) noexcept {
+    struct Entry {
+        uint64_t key;
+        SinCos value;
+        bool is_valid;
+    };
+    constexpr int CACHE_BITS = 6;
+    constexpr size_t CACHE_SIZE = size_t(1) << CACHE_BITS;
+    thread_local std::array<Entry, CACHE_SIZE> cache {};
+
+    uint64_t key;
+    std::memcpy(&key, &radians, sizeof(key));
+    // Fibonacci hashing of the bit pattern
+    const size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - CACHE_BITS));
+    Entry& entry = cache[index];
+    if (entry.is_valid && entry.key == key) {
+        return entry.value;
+    }
+    entry = {key, sincos(radians, Accuracy::Polynomial), true};
+    return entry.value;
+}
+
+} // namespace trig
+} // namespace NS_math
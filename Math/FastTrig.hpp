@@ -0,0 +1,45 @@
+#ifndef MATH_FAST_TRIG_HPP
+#define MATH_FAST_TRIG_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+
+namespace NS_math {
+namespace trig {
+
+/*
+sin and cos of the same angle in one call
+  - Exact: std::sin / std::cos
+  - Polynomial: Cody-Waite reduction to [-pi/4, pi/4] + minimax polynomials,
+    within ~2 ulp of std for |x| < 1e6 (larger angles fall back to std)
+  - Table: 4096 entry table with linear interpolation, |error| < 3e-7,
+    good enough for anything that ends up in pixels
+*/
+enum class Accuracy : uint8_t {
+    Exact,
+    Polynomial,
+    Table
+};
+
+struct SinCos {
+    double sin;
+    double cos;
+};
+
+SinCos sincos(double radians, Accuracy accuracy = Accuracy::Polynomial) noexcept;
+
+// sin_out[i], cos_out[i] of radians[i], the polynomial loop has no branches so it vectorizes
+void sincos(const double* radians, double* sin_out, double* cos_out, size_t n, Accuracy accuracy = Accuracy::Polynomial) noexcept;
+
+/*
+small direct-mapped memo for angles that repeat (the same rotation every frame)
+keyed on the exact bit pattern of the angle, a miss costs one Polynomial sincos
+one cache per thread, so no locking
+*/
+SinCos cachedSincos(double radians) noexcept;
+
+} // namespace trig
+} // namespace NS_math
+
+#endif // MATH_FAST_TRIG_HPP
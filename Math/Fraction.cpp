@@ -1,11 +1,272 @@
 #include "Fraction.hpp"
 #include <string>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
 
 #include "ZeroDivisionException.hpp"
 
 using namespace NS_math;
+
+namespace { // Anonymous namespace for private functions
+
+constexpr int64_t INT64_MAX_VALUE = std::numeric_limits<int64_t>::max();
+constexpr int64_t INT64_MIN_VALUE = std::numeric_limits<int64_t>::min();
+
+struct Parts {
+    int64_t num;
+    int64_t den; // > 0
+    bool is_reduced;
+};
+
+[[noreturn]] void throwOverflow(const char* where) {
+    throw std::overflow_error(std::string("Fraction::") + where + " overflow: result does not fit in 64 bits");
+}
+
+uint64_t absU(int64_t x) noexcept {
+    // no UB for INT64_MIN
+    return x < 0 ? 0 - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+}
+
+int countTrailingZeros(uint64_t x) noexcept { // x != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+#if defined(__SIZEOF_INT128__)
+// 128-bit intermediate path: sums and products of two int64 never overflow here
+__extension__ typedef __int128 wide_t;
+__extension__ typedef unsigned __int128 uwide_t;
+
+int countTrailingZeros(uwide_t x) noexcept { // x != 0
+    const uint64_t low = static_cast<uint64_t>(x);
+    return low ? countTrailingZeros(low) : 64 + countTrailingZeros(static_cast<uint64_t>(x >> 64));
+}
+#endif
+
+// Stein's binary GCD: shifts and subtractions only, no division
+template <typename Unsigned>
+Unsigned binaryGcd(Unsigned a, Unsigned b) noexcept {
+    if (a == 0) {
+        return b;
+    }
+    if (b == 0) {
+        return a;
+    }
+    const int shift = countTrailingZeros(a | b);
+    a >>= countTrailingZeros(a);
+    do {
+        b >>= countTrailingZeros(b);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        b -= a;
+    } while (b != 0);
+    return a << shift;
+}
+
+#if defined(__SIZEOF_INT128__)
+bool fitsInt64(wide_t x) noexcept {
+    return x >= INT64_MIN_VALUE && x <= INT64_MAX_VALUE;
+}
+
+// reduce only if the result does not fit
+Parts fromWide(wide_t num, wide_t den, const char* where) {
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    if (fitsInt64(num) && den <= INT64_MAX_VALUE) {
+        return {static_cast<int64_t>(num), static_cast<int64_t>(den), false};
+    }
+    const uwide_t gcf = binaryGcd<uwide_t>(num < 0 ? uwide_t(0) - uwide_t(num) : uwide_t(num), uwide_t(den));
+    num /= static_cast<wide_t>(gcf);
+    den /= static_cast<wide_t>(gcf);
+    if (fitsInt64(num) && den <= INT64_MAX_VALUE) {
+        return {static_cast<int64_t>(num), static_cast<int64_t>(den), true};
+    }
+    throwOverflow(where);
+}
+
+// a/b (+ or -) c/d
+Parts addParts(int64_t a, int64_t b, int64_t c, int64_t d, bool is_sub, const char* where) {
+    if (b == d) {
+        return fromWide(is_sub ? wide_t(a) - c : wide_t(a) + c, b, where);
+    }
+    const wide_t lhs = static_cast<wide_t>(a) * d;
+    const wide_t rhs = static_cast<wide_t>(c) * b;
+    return fromWide(is_sub ? lhs - rhs : lhs + rhs, static_cast<wide_t>(b) * d, where);
+}
+
+// (a/b) * (c/d), d may be negative
+Parts mulParts(int64_t a, int64_t b, int64_t c, int64_t d, const char* where) {
+    return fromWide(static_cast<wide_t>(a) * c, static_cast<wide_t>(b) * d, where);
+}
+
+int compareParts(int64_t a, int64_t b, int64_t c, int64_t d) noexcept {
+    const wide_t lhs = static_cast<wide_t>(a) * d;
+    const wide_t rhs = static_cast<wide_t>(c) * b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+#else
+// no 128-bit integer: checked 64-bit ops, and on overflow reduce the operands first (Knuth)
+
+bool mulOverflow(int64_t a, int64_t b, int64_t* result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(a, b, result);
+#else
+    if (a == 0 || b == 0) {
+        *result = 0;
+        return false;
+    }
+    if ((a == -1 && b == INT64_MIN_VALUE) || (b == -1 && a == INT64_MIN_VALUE)) {
+        return true;
+    }
+    if (a > 0 ? (b > 0 ? a > INT64_MAX_VALUE / b : b < INT64_MIN_VALUE / a)
+              : (b > 0 ? a < INT64_MIN_VALUE / b : a < INT64_MAX_VALUE / b)) {
+        return true;
+    }
+    *result = a * b;
+    return false;
+#endif
+}
+bool addOverflow(int64_t a, int64_t b, int64_t* result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(a, b, result);
+#else
+    if ((b > 0 && a > INT64_MAX_VALUE - b) || (b < 0 && a < INT64_MIN_VALUE - b)) {
+        return true;
+    }
+    *result = a + b;
+    return false;
+#endif
+}
+bool subOverflow(int64_t a, int64_t b, int64_t* result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_sub_overflow(a, b, result);
+#else
+    if ((b < 0 && a > INT64_MAX_VALUE + b) || (b > 0 && a < INT64_MIN_VALUE + b)) {
+        return true;
+    }
+    *result = a - b;
+    return false;
+#endif
+}
+
+void reduce(int64_t& num, int64_t& den) noexcept {
+    const int64_t gcf = static_cast<int64_t>(binaryGcd<uint64_t>(absU(num), absU(den)));
+    if (gcf > 1) {
+        num /= gcf;
+        den /= gcf;
+    }
+}
+
+// moves the sign to the numerator
+Parts makeParts(int64_t num, int64_t den, bool is_reduced, const char* where) {
+    if (den < 0) {
+        if (num == INT64_MIN_VALUE || den == INT64_MIN_VALUE) {
+            reduce(num, den);
+            is_reduced = true;
+            if (num == INT64_MIN_VALUE || den == INT64_MIN_VALUE) {
+                throwOverflow(where);
+            }
+        }
+        num = -num;
+        den = -den;
+    }
+    return {num, den, is_reduced};
+}
+
+Parts addParts(int64_t a, int64_t b, int64_t c, int64_t d, bool is_sub, const char* where) {
+    int64_t ad, cb, num, den;
+    if (b == d) {
+        if (!(is_sub ? subOverflow(a, c, &num) : addOverflow(a, c, &num))) {
+            return {num, b, false};
+        }
+    } else if (!mulOverflow(a, d, &ad) && !mulOverflow(c, b, &cb)
+            && !(is_sub ? subOverflow(ad, cb, &num) : addOverflow(ad, cb, &num))
+            && !mulOverflow(b, d, &den)) {
+        return {num, den, false};
+    }
+    // a/b + c/d = (a*(d/g) + c*(b/g)) / (b*d/g), g = gcd(b, d)
+    reduce(a, b);
+    reduce(c, d);
+    const int64_t gcf = static_cast<int64_t>(binaryGcd<uint64_t>(absU(b), absU(d)));
+    const int64_t b_g = b / gcf;
+    const int64_t d_g = d / gcf;
+    int64_t t;
+    if (mulOverflow(a, d_g, &ad) || mulOverflow(c, b_g, &cb)
+        || (is_sub ? subOverflow(ad, cb, &t) : addOverflow(ad, cb, &t))) {
+        throwOverflow(where);
+    }
+    const int64_t gcf2 = static_cast<int64_t>(binaryGcd<uint64_t>(absU(t), static_cast<uint64_t>(gcf)));
+    if (mulOverflow(b_g, d / gcf2, &den)) {
+        throwOverflow(where);
+    }
+    return {t / gcf2, den, true};
+}
+
+Parts mulParts(int64_t a, int64_t b, int64_t c, int64_t d, const char* where) {
+    int64_t num, den;
+    if (!mulOverflow(a, c, &num) && !mulOverflow(b, d, &den)) {
+        return makeParts(num, den, false, where);
+    }
+    // cross reduce: (a/g1 * c/g2) / (b/g2 * d/g1)
+    reduce(a, b);
+    reduce(c, d);
+    reduce(a, d);
+    reduce(c, b);
+    if (mulOverflow(a, c, &num) || mulOverflow(b, d, &den)) {
+        throwOverflow(where);
+    }
+    return makeParts(num, den, true, where);
+}
+
+// compares a/b with c/d (b, d > 0) through their continued fractions, never overflows
+int compareParts(int64_t a, int64_t b, int64_t c, int64_t d) noexcept {
+    int64_t ad, cb;
+    if (!mulOverflow(a, d, &ad) && !mulOverflow(c, b, &cb)) {
+        return (ad > cb) - (ad < cb);
+    }
+    while (true) {
+        int64_t ra = a % b;
+        int64_t rc = c % d;
+        const int64_t qa = a / b - (ra < 0);
+        const int64_t qc = c / d - (rc < 0);
+        if (qa != qc) {
+            return qa < qc ? -1 : 1;
+        }
+        ra += ra < 0 ? b : 0;
+        rc += rc < 0 ? d : 0;
+        if (ra == 0 || rc == 0) {
+            return (ra > rc) - (ra < rc);
+        }
+        // ra/b < rc/d  <=>  d/rc < b/ra
+        const int64_t old_b = b;
+        a = d;
+        b = rc;
+        c = old_b;
+        d = ra;
+    }
+}
+#endif
+
+int64_t floorDiv(int64_t num, int64_t den) noexcept { // den > 0
+    const int64_t quotient = num / den;
+    return quotient - ((num % den) < 0);
+}
+
+} // Anonymous namespace end
+
 // static
 
 uint8_t Fraction::default_precision = 6; // default precision for double to fraction conversion
@@ -14,31 +275,13 @@ int Fraction::find_gcf(int n1, int n2) {
     if (n1 == 0 && n2 == 0) {
         throw std::invalid_argument("GCF is undefined for (0, 0)");
     }
-    int tmp;
-    if (std::abs(n1) < std::abs(n2)) {
-        std::swap(n1, n2);
-    }
-    while (n2 != 0) {
-        tmp = n2;
-        n2 = n1 % n2;
-        n1 = tmp;
-    }
-    return n1;
+    return static_cast<int>(binaryGcd<uint64_t>(absU(n1), absU(n2)));
 }
 long long Fraction::find_gcf(long long n1, long long n2) {
     if (n1 == 0 && n2 == 0) {
         throw std::invalid_argument("GCF is undefined for (0, 0)");
     }
-    long long tmp;
-    if (std::abs(n1) < std::abs(n2)) {
-        std::swap(n1, n2);
-    }
-    while (n2 != 0) {
-        tmp = n2;
-        n2 = n1 % n2;
-        n1 = tmp;
-    }
-    return n1;
+    return static_cast<long long>(binaryGcd<uint64_t>(absU(n1), absU(n2)));
 }
 
 
@@ -46,80 +289,109 @@ Fraction Fraction::get_fraction_from_double(double value, unsigned int precision
     if (!std::isfinite(value)) {
         throw std::invalid_argument("Value must be finite");
     }
+    if (std::abs(value) >= 9.2e18) {
+        throw std::overflow_error("Value is too large to convert to fraction");
+    }
     if (precision == 0) {
-        return Fraction(static_cast<int>(std::round(value)), 1);
+        return Fraction(static_cast<int64_t>(std::round(value)), 1);
     }
-    double factor = std::pow(10, precision);
-    if (std::abs(value * factor) > static_cast<double>(LLONG_MAX)) {
-        throw std::overflow_error("Value is too large to convert to fraction");
+    int64_t max_denominator = 1;
+    for (unsigned int i = 0; i < precision && i < 18; ++i) {
+        max_denominator *= 10;
     }
-    long long numerator_ll = static_cast<long long>(std::round(value * factor));
-    long long denominator_ll = static_cast<long long>(factor);
-    if (numerator_ll == 0) {
-        return Fraction(0, 1);
+
+    // continued fraction expansion, h/k are the convergents
+    const double x = std::abs(value);
+    double rest = x;
+    int64_t h_prev = 0, h = 1; // h(-2), h(-1)
+    int64_t k_prev = 1, k = 0;
+    for (int iteration = 0; iteration < 64; ++iteration) {
+        const double a_double = std::floor(rest);
+        if (a_double > static_cast<double>(INT64_MAX_VALUE)) {
+            break;
+        }
+        const int64_t a = static_cast<int64_t>(a_double);
+        // stop before the denominator (or the numerator) gets too big
+        if (k != 0 && a > (max_denominator - k_prev) / k) {
+            // best semiconvergent that still fits: (t*h + h_prev) / (t*k + k_prev)
+            const int64_t t = (max_denominator - k_prev) / k;
+            if (t > 0 && (h == 0 || t <= (INT64_MAX_VALUE - h_prev) / h)) {
+                const int64_t semi_h = t * h + h_prev;
+                const int64_t semi_k = t * k + k_prev;
+                const double semi_error = std::abs(x - static_cast<double>(semi_h) / static_cast<double>(semi_k));
+                const double error = std::abs(x - static_cast<double>(h) / static_cast<double>(k));
+                if (semi_error < error) {
+                    h = semi_h;
+                    k = semi_k;
+                }
+            }
+            break;
+        }
+        if (h != 0 && a > (INT64_MAX_VALUE - h_prev) / h) {
+            break;
+        }
+        const int64_t h_next = a * h + h_prev;
+        const int64_t k_next = a * k + k_prev;
+        h_prev = h;
+        h = h_next;
+        k_prev = k;
+        k = k_next;
+
+        const double frac = rest - a_double;
+        if (frac == 0.0 || static_cast<double>(h) / static_cast<double>(k) == x) {
+            break;
+        }
+        rest = 1.0 / frac;
     }
-    long long gcf = find_gcf(numerator_ll, denominator_ll);
-    numerator_ll /= gcf;
-    denominator_ll /= gcf;
-    if (denominator_ll == 0) {
+    if (k == 0) {
         throw std::logic_error("Fraction::get_fraction_from_double: ***Unreachable code***: denominator cannot be 0");
     }
-    if (numerator_ll < INT_MAX && numerator_ll > INT_MIN &&
-        denominator_ll < INT_MAX && denominator_ll > INT_MIN) {
-        return Fraction(static_cast<int>(numerator_ll), static_cast<int>(denominator_ll));
-    }
-    throw std::runtime_error("Fraction::get_fraction_from_double: numerator or denominator exceeds int limits");
+    // convergents are already in lowest terms
+    return helperMake(value < 0 ? -h : h, k, true);
 }
 
 // public
 // Constructor
-Fraction::Fraction(const int& dividend, const int& divisor) : numerator(dividend), denominator(divisor) {
+Fraction::Fraction(int64_t dividend, int64_t divisor)
+    : numerator(dividend), denominator(divisor)
+{
     if (denominator == 0) {
         throw ZeroDivisionException("Fraction::Fraction ZeroDivErr: divisor cannot be 0");
     }
-    simplify();
-}
-Fraction::Fraction(double value, uint8_t precision) {
-    Fraction tmp = get_fraction_from_double(value, precision);
-    numerator = tmp.numerator;
-    denominator = tmp.denominator;
-}
-
-void Fraction::simplify() {
-    if (numerator == 0) {
-        denominator = 1;
-        return;
-    }
-    // move negative to numerator if there is
     if (denominator < 0) {
+        if (numerator == INT64_MIN_VALUE || denominator == INT64_MIN_VALUE) {
+            helperNormalize();
+            if (numerator == INT64_MIN_VALUE || denominator == INT64_MIN_VALUE) {
+                throw std::overflow_error("Fraction::Fraction overflow: cannot move the sign to the numerator");
+            }
+        }
         numerator = -numerator;
         denominator = -denominator;
     }
-    // simplify
-    int gcf = find_gcf(numerator, denominator);
-    numerator /= gcf;
-    denominator /= gcf;
+    helperNormalize();
+}
+
+void Fraction::simplify() {
 }
 
 // member getters
-int Fraction::get_numerator() const {
+int64_t Fraction::get_numerator() const {
     return numerator;
 }
-int Fraction::get_denominator() const {
+int64_t Fraction::get_denominator() const {
     return denominator;
 }
 
 // member setters
-void Fraction::set_numerator(int new_numerator) {
+void Fraction::set_numerator(int64_t new_numerator) {
     numerator = new_numerator;
-    simplify();
+    helperNormalize();
 }
-void Fraction::set_denominator(int new_denominator) {
+void Fraction::set_denominator(int64_t new_denominator) {
     if (new_denominator == 0) {
         throw ZeroDivisionException("Fraction::set_denominator ZeroDivErr: divisor cannot be 0");
     }
-    denominator = new_denominator;
-    simplify();
+    *this = Fraction(numerator, new_denominator);
 }
 
 // other getters
@@ -129,103 +401,130 @@ std::string Fraction::to_string(bool add_prefix) const {
 double Fraction::get_in_double() const {
     return static_cast<double>(numerator)/denominator;
 }
-int Fraction::floor() const {
-    return static_cast<int>(std::floor(get_in_double()));
+int64_t Fraction::floor() const {
+    return floorDiv(numerator, denominator);
 }
-int Fraction::ceil() const {
-    return static_cast<int>(std::ceil(get_in_double()));
+int64_t Fraction::ceil() const {
+    return numerator / denominator + ((numerator % denominator) > 0);
 }
-std::pair<int, Fraction> Fraction::get_mixed_fraction() const {
-    int integral_part = floor();
-    return {integral_part, Fraction(numerator-integral_part*denominator, denominator)};
+std::pair<int64_t, Fraction> Fraction::get_mixed_fraction() const {
+    const int64_t integral_part = floor();
+    int64_t remainder = numerator % denominator;
+    remainder += remainder < 0 ? denominator : 0; // 0 <= remainder < denominator
+    return {integral_part, helperMake(remainder, denominator, true)};
 }
 
 
 
-Fraction& Fraction::operator=(const Fraction& other) {
-    if (this == &other) {
-        return *this; // self-assignment check
-    }
-    numerator = other.numerator;
-    denominator = other.denominator;
-    return *this;
-}
-Fraction& Fraction::operator=(int num) {
+Fraction& Fraction::operator=(int64_t num) {
     numerator = num;
     denominator = 1;
     return *this;
 }
-Fraction& Fraction::operator=(double value) {
-    Fraction tmp = get_fraction_from_double(value);
-    numerator = tmp.numerator;
-    denominator = tmp.denominator;
-    return *this;
-}
 
 
 bool Fraction::operator==(const Fraction& other) const {
-    return numerator==other.numerator && denominator==other.denominator;
+    return helperCompare(other.numerator, other.denominator) == 0;
 }
 bool Fraction::operator<(const Fraction& other) const {
-    return numerator*other.denominator < other.numerator*denominator;
+    return helperCompare(other.numerator, other.denominator) < 0;
 }
 bool Fraction::operator>(const Fraction& other) const {
-    return numerator*other.denominator > other.numerator*denominator;
+    return helperCompare(other.numerator, other.denominator) > 0;
 }
 bool Fraction::operator!=(const Fraction& other) const {
     return !operator==(other);
 }
 bool Fraction::operator<=(const Fraction& other) const {
-    return operator<(other) || operator==(other);
+    return !operator>(other);
 }
 bool Fraction::operator>=(const Fraction& other) const {
-    return operator>(other) || operator==(other);
+    return !operator<(other);
 }
 Fraction Fraction::operator+(const Fraction& other) const {
-    return Fraction(numerator*other.denominator+other.numerator*denominator, denominator*other.denominator);
+    const Parts result = addParts(numerator, denominator, other.numerator, other.denominator, false, "operator+");
+    return helperMake(result.num, result.den, result.is_reduced);
 }
 Fraction Fraction::operator-(const Fraction& other) const {
-    return Fraction(numerator*other.denominator-other.numerator*denominator, denominator*other.denominator);
+    const Parts result = addParts(numerator, denominator, other.numerator, other.denominator, true, "operator-");
+    return helperMake(result.num, result.den, result.is_reduced);
 }
 Fraction Fraction::operator*(const Fraction& other) const {
-    return Fraction(numerator*other.numerator, denominator*other.denominator);
+    const Parts result = mulParts(numerator, denominator, other.numerator, other.denominator, "operator*");
+    return helperMake(result.num, result.den, result.is_reduced);
 }
 Fraction Fraction::operator/(const Fraction& other) const {
-    return Fraction(numerator*other.denominator, denominator*other.numerator);
+    if (other.numerator == 0) {
+        throw ZeroDivisionException("Fraction::operator/(Fraction) ZeroDivErr: divisor cannot be 0");
+    }
+    const Parts result = mulParts(numerator, denominator, other.denominator, other.numerator, "operator/");
+    return helperMake(result.num, result.den, result.is_reduced);
 }
 
-bool Fraction::operator==(const int& num) const {
-    return denominator==1 && numerator==num;
+bool Fraction::operator==(int64_t num) const {
+    return helperCompare(num, 1) == 0;
 }
-bool Fraction::operator<(const int& num) const {
-    return numerator < num*denominator;
+bool Fraction::operator<(int64_t num) const {
+    return helperCompare(num, 1) < 0;
 }
-bool Fraction::operator>(const int& num) const {
-    return numerator > num*denominator;
+bool Fraction::operator>(int64_t num) const {
+    return helperCompare(num, 1) > 0;
 }
-bool Fraction::operator!=(const int& num) const {
+bool Fraction::operator!=(int64_t num) const {
     return !operator==(num);
 }
-bool Fraction::operator<=(const int& num) const {
-    return operator<(num) || operator==(num);
+bool Fraction::operator<=(int64_t num) const {
+    return !operator>(num);
 }
-bool Fraction::operator>=(const int& num) const {
-    return operator>(num) || operator==(num);
+bool Fraction::operator>=(int64_t num) const {
+    return !operator<(num);
 }
-Fraction Fraction::operator+(const int& num) const {
-    return Fraction(numerator+num*denominator, denominator);
+Fraction Fraction::operator+(int64_t num) const {
+    const Parts result = addParts(numerator, denominator, num, 1, false, "operator+");
+    return helperMake(result.num, result.den, result.is_reduced);
 }
-Fraction Fraction::operator-(const int& num) const {
-    return Fraction(numerator-num*denominator, denominator);
+Fraction Fraction::operator-(int64_t num) const {
+    const Parts result = addParts(numerator, denominator, num, 1, true, "operator-");
+    return helperMake(result.num, result.den, result.is_reduced);
 }
-Fraction Fraction::operator*(const int& num) const {
-    return Fraction(numerator*num, denominator);
+Fraction Fraction::operator*(int64_t num) const {
+    const Parts result = mulParts(numerator, denominator, num, 1, "operator*");
+    return helperMake(result.num, result.den, result.is_reduced);
 }
-Fraction Fraction::operator/(const int& num) const {
+Fraction Fraction::operator/(int64_t num) const {
     if (num == 0) {
         throw ZeroDivisionException("Fraction::operator/(int) ZeroDivErr: divisor cannot be 0");
     }
-    return Fraction(numerator, denominator*num);
+    const Parts result = mulParts(numerator, denominator, 1, num, "operator/");
+    return helperMake(result.num, result.den, result.is_reduced);
+}
+
+// private
+
+Fraction Fraction::helperMake(int64_t num, int64_t den, bool is_reduced) noexcept {
+    Fraction result;
+    result.numerator = num;
+    result.denominator = den;
+    if (!is_reduced) {
+        result.helperNormalize();
+    }
+    return result;
+}
+
+void Fraction::helperNormalize() noexcept {
+    if (numerator == 0) {
+        denominator = 1;
+    } else {
+        const uint64_t gcf = binaryGcd<uint64_t>(absU(numerator), absU(denominator));
+        if (gcf > 1) {
+            numerator /= static_cast<int64_t>(gcf);
+            denominator /= static_cast<int64_t>(gcf);
+        }
+    }
+}
+
+int Fraction::helperCompare(int64_t other_numerator, int64_t other_denominator) const noexcept {
+    return compareParts(numerator, denominator, other_numerator, other_denominator);
 }
 
 
@@ -238,8 +537,8 @@ Fraction Fraction::operator/(const int& num) const {
 
 //     std::cout << f1.numerator << ", " << f1.denominator << std::endl;
 //     std::cout << f1.floor() << ", " << f1.get_mixed_fraction().second.numerator << std::endl;
-//     std::cout 
-//         << "float:" << f.get_in_double() << ", floor:" << f.floor() << ", ceil:" << f.ceil() 
-//         << ", mixed:" << f.get_mixed_fraction().first 
+//     std::cout
+//         << "float:" << f.get_in_double() << ", floor:" << f.floor() << ", ceil:" << f.ceil()
+//         << ", mixed:" << f.get_mixed_fraction().first
 //         << "+" << f.get_mixed_fraction().second.numerator << "/" << f.get_mixed_fraction().second.denominator << std::endl;
-// }
\ No newline at end of file
+// }
@@ -5,48 +5,66 @@
 #include <exception>
 #include <utility>
 #include <cmath>
+#include <cstdint>
+#include <type_traits>
 
 #include "MathUtils.hpp"
 
 
 namespace NS_math {
 
+/*
+64-bit rational number
+  - the denominator is always positive
+  - always in lowest terms: constructors, setters and arithmetic reduce their result,
+    so const members never modify the fraction and can be read from several threads
+  - products and sums are computed in 128 bits when the compiler has __int128,
+    a result that does not fit even after reducing throws std::overflow_error
+*/
 class Fraction {
     private:
-        int numerator;
-        int denominator;
+        int64_t numerator;
+        int64_t denominator; // > 0
     public:
         static int find_gcf(int n1, int n2);
         static long long find_gcf(long long n1, long long n2);
         static uint8_t default_precision;
+        // best rational approximation with denominator <= 10^precision
         static Fraction get_fraction_from_double(double value, unsigned int precision = default_precision);
 
-        explicit Fraction(const int& dividend = 0, const int& divisor = 1);
-        explicit Fraction(double value, uint8_t precision = default_precision);
+        explicit Fraction(int64_t dividend = 0, int64_t divisor = 1);
+        // template so that (int, int) never competes with (double, uint8_t)
+        template <typename Floating, typename = std::enable_if_t<std::is_floating_point_v<Floating>>>
+        explicit Fraction(Floating value, uint8_t precision = default_precision)
+            : Fraction(get_fraction_from_double(static_cast<double>(value), precision)) {}
         inline Fraction(const Fraction& other) = default; // copy constructor
         inline Fraction(Fraction&&) noexcept = default; // move constructor
 
-        void simplify();
+        void simplify(); // no-op, kept for the callers: a Fraction is always in lowest terms
 
-        int get_numerator() const;
-        int get_denominator() const;
+        int64_t get_numerator() const;
+        int64_t get_denominator() const;
 
-        void set_numerator(int new_numerator);
-        void set_denominator(int new_denominator);
+        void set_numerator(int64_t new_numerator);
+        void set_denominator(int64_t new_denominator);
 
 
         std::string to_string(bool add_prefix = true) const;
         double get_in_double() const;
-        int floor() const;
-        int ceil() const;
-        std::pair<int, Fraction> get_mixed_fraction() const;
+        int64_t floor() const;
+        int64_t ceil() const;
+        std::pair<int64_t, Fraction> get_mixed_fraction() const;
+
 
 
-        
         // Assignment operator
-        Fraction& operator=(const Fraction& other);
-        Fraction& operator=(int num);
-        Fraction& operator=(double value);
+        Fraction& operator=(const Fraction& other) = default;
+        Fraction& operator=(Fraction&& other) noexcept = default;
+        Fraction& operator=(int64_t num);
+        template <typename Floating, typename = std::enable_if_t<std::is_floating_point_v<Floating>>>
+        Fraction& operator=(Floating value) {
+            return *this = get_fraction_from_double(static_cast<double>(value));
+        }
 
         bool operator==(const Fraction& other) const;
         bool operator<(const Fraction& other) const;
@@ -59,16 +77,23 @@ class Fraction {
         Fraction operator*(const Fraction& other) const;
         Fraction operator/(const Fraction& other) const;
 
-        bool operator==(const int& num) const;
-        bool operator<(const int& num) const;
-        bool operator>(const int& num) const;
-        bool operator!=(const int& num) const;
-        bool operator<=(const int& num) const;
-        bool operator>=(const int& num) const;
-        Fraction operator+(const int& num) const;
-        Fraction operator-(const int& num) const;
-        Fraction operator*(const int& num) const;
-        Fraction operator/(const int& num) const;
+        bool operator==(int64_t num) const;
+        bool operator<(int64_t num) const;
+        bool operator>(int64_t num) const;
+        bool operator!=(int64_t num) const;
+        bool operator<=(int64_t num) const;
+        bool operator>=(int64_t num) const;
+        Fraction operator+(int64_t num) const;
+        Fraction operator-(int64_t num) const;
+        Fraction operator*(int64_t num) const;
+        Fraction operator/(int64_t num) const;
+
+    private:
+        // den must be > 0
+        static Fraction helperMake(int64_t num, int64_t den, bool is_reduced) noexcept;
+        void helperNormalize() noexcept;
+        // -1, 0 or 1
+        int helperCompare(int64_t other_numerator, int64_t other_denominator) const noexcept;
 }; // class
 
 } // namespace NS_math
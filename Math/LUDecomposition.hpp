@@ -0,0 +1,175 @@
+#ifndef MATH_LU_DECOMPOSITION_HPP
+#define MATH_LU_DECOMPOSITION_HPP
+
+
+#include <array>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+#include "../Logger/Logger.hpp"
+
+namespace NS_math {
+
+/*
+PA = LU with (row-scaled) partial pivoting, O(N^3) once, then O(N^2) per solve
+L (unit diagonal, not stored) and U share one array
+everything is constexpr, so small systems can be solved at compile time
+*/
+template <size_t N>
+class LUDecomposition {
+
+    static_assert(N > 0, "LUDecomposition: N(size) must be positive");
+
+    private:
+        std::array<std::array<double, N>, N> lu {}; // below the diagonal: L, on and above: U
+        std::array<size_t, N> perm {}; // row i of PA is row perm[i] of A
+        int perm_sign = 1; // determinant of P
+        bool is_singular = false;
+
+    public:
+        constexpr explicit LUDecomposition(const std::array<std::array<double, N>, N>& arg_data) noexcept
+         : lu(arg_data)
+        {
+            // implicit partial pivoting: each row is measured against its own largest element,
+            // so rows of very different magnitude (e.g. diag(1e20, 1)) neither steal the pivot
+            // nor make the other rows' pivots look like rounding noise
+            std::array<double, N> row_scale {}; // by original row, follows perm
+            for (size_t r = 0; r < N; ++r) {
+                perm[r] = r;
+                for (size_t c = 0; c < N; ++c) {
+                    row_scale[r] = (helperAbs(lu[r][c]) > row_scale[r]) ? helperAbs(lu[r][c]) : row_scale[r];
+                }
+            }
+            const double relative_tolerance = static_cast<double>(N) * std::numeric_limits<double>::epsilon();
+
+            for (size_t k = 0; k < N; ++k) {
+                size_t pivot_row = k;
+                double pivot_ratio = helperScaled(lu[k][k], row_scale[perm[k]]);
+                for (size_t r = k + 1; r < N; ++r) {
+                    const double ratio = helperScaled(lu[r][k], row_scale[perm[r]]);
+                    if (ratio > pivot_ratio) {
+                        pivot_row = r;
+                        pivot_ratio = ratio;
+                    }
+                }
+                // a pivot this small relative to its row is rounding noise of a zero
+                if (pivot_ratio <= relative_tolerance) {
+                    is_singular = true;
+                    continue; // the column is already eliminated
+                }
+                if (pivot_row != k) {
+                    for (size_t c = 0; c < N; ++c) {
+                        double tmp = lu[k][c];
+                        lu[k][c] = lu[pivot_row][c];
+                        lu[pivot_row][c] = tmp;
+                    }
+                    size_t tmp = perm[k];
+                    perm[k] = perm[pivot_row];
+                    perm[pivot_row] = tmp;
+                    perm_sign = -perm_sign;
+                }
+                const double inv_pivot = 1.0 / lu[k][k];
+                for (size_t r = k + 1; r < N; ++r) {
+                    const double factor = lu[r][k] * inv_pivot;
+                    lu[r][k] = factor;
+                    for (size_t c = k + 1; c < N; ++c) {
+                        lu[r][c] -= factor * lu[k][c];
+                    }
+                }
+            }
+        }
+
+        constexpr bool isSingular() const noexcept { return is_singular; }
+        constexpr const std::array<std::array<double, N>, N>& get_data_constReference() const noexcept { return lu; }
+        constexpr const std::array<size_t, N>& get_permutation() const noexcept { return perm; }
+
+        constexpr double determinant() const noexcept {
+            if (is_singular) {
+                return 0;
+            }
+            double result = perm_sign;
+            for (size_t i = 0; i < N; ++i) {
+                result *= lu[i][i];
+            }
+            return result;
+        }
+
+        // x such that Ax = b
+        constexpr std::array<double, N> solve(const std::array<double, N>& b) const {
+            helperThrowIfSingular("solve(const std::array<double, N>& b) const");
+            std::array<double, N> x {};
+            // Ly = Pb
+            for (size_t r = 0; r < N; ++r) {
+                double sum = b[perm[r]];
+                for (size_t c = 0; c < r; ++c) {
+                    sum -= lu[r][c] * x[c];
+                }
+                x[r] = sum;
+            }
+            // Ux = y
+            for (size_t r = N; r-- > 0; ) {
+                double sum = x[r];
+                for (size_t c = r + 1; c < N; ++c) {
+                    sum -= lu[r][c] * x[c];
+                }
+                x[r] = sum / lu[r][r];
+            }
+            return x;
+        }
+        // X such that AX = B, column by column
+        template <size_t ColN>
+        constexpr std::array<std::array<double, ColN>, N> solve(const std::array<std::array<double, ColN>, N>& b) const {
+            helperThrowIfSingular("solve(const std::array<std::array<double, ColN>, N>& b) const");
+            std::array<std::array<double, ColN>, N> result {};
+            std::array<double, N> column {};
+            for (size_t c = 0; c < ColN; ++c) {
+                for (size_t r = 0; r < N; ++r) {
+                    column[r] = b[r][c];
+                }
+                column = solve(column);
+                for (size_t r = 0; r < N; ++r) {
+                    result[r][c] = column[r];
+                }
+            }
+            return result;
+        }
+
+        constexpr std::array<std::array<double, N>, N> inverse() const {
+            helperThrowIfSingular("inverse() const");
+            std::array<std::array<double, N>, N> identity {};
+            for (size_t i = 0; i < N; ++i) {
+                identity[i][i] = 1;
+            }
+            return solve<N>(identity);
+        }
+
+    private:
+        static constexpr double helperAbs(double x) noexcept { return (x < 0) ? -x : x; }
+        // |x| relative to the scale of its row, 0 for an all zero row
+        static constexpr double helperScaled(double x, double scale) noexcept {
+            return (scale > 0) ? helperAbs(x) / scale : 0;
+        }
+
+        constexpr void helperThrowIfSingular(const char* func_name) const {
+            if (is_singular) {
+                log_and_throw<std::runtime_error>(
+                    func_name,
+                    "the matrix is singular/non-invertible(determinant is zero)"
+                );
+            }
+        }
+
+        template <typename ExceptionType = std::runtime_error>
+        [[noreturn]] void log_and_throw(const std::string& func_name, const std::string& message) const {
+            Logger::log_and_throw<ExceptionType>(
+                "LUDecomposition<" + std::to_string(N) + ">::" + func_name,
+                message
+            );
+        }
+
+}; // class LUDecomposition
+
+} // namespace NS_math
+
+#endif // MATH_LU_DECOMPOSITION_HPP
@@ -5,15 +5,20 @@
 #include "Angle.hpp"
 
 #include "Fraction.hpp"
+#include "Primes.hpp"
 
 #include "Vector.hpp"
 #include "Vector2d.hpp"
 #include "Vector3d.hpp"
+#include "Vector3dArray.hpp"
 
 #include "ComplexNumber.hpp"
 
+#include "Affine2d.hpp"
+
 #include "Matrix.hpp"
 #include "SquareMatrix.hpp"
 #include "RotationMatrix.hpp"
+#include "DenseMatrix.hpp"
 
 #endif // MATH_HPP_ANDY
\ No newline at end of file
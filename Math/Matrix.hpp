@@ -8,9 +8,10 @@
 #include <stdexcept>
 
 #include "../Logger/Logger.hpp"
+#include "MathUtils.hpp"
+#include "MatrixKernels.hpp"
 
 namespace NS_math {
-#include "MathUtils.hpp"
 
 
 template <size_t RowN, size_t ColN>
@@ -457,16 +457,8 @@ template <size_t RowN, size_t ColN>
 template <size_t oColN>
 inline Matrix<RowN, oColN> Matrix<RowN, ColN>::mul(const Matrix<ColN, oColN>& other) const {
     Matrix<RowN, oColN> result;
-    double tmp;
-    for (size_t rr = 0; rr < RowN; ++rr) {
-        for (size_t rc = 0; rc < oColN; ++rc) {
-            tmp = 0;
-            for (size_t i = 0; i < ColN; ++i) {
-                tmp += data[rr][i] * other[i][rc];
-            }
-            result[rr][rc] = tmp;
-        }
-    }
+    // works on data directly, the sizes are checked at compile time
+    matrix_kernels::mulFixed<RowN, ColN, oColN>(data, other.data, result.data);
     return result;
 }
 
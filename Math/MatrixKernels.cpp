@@ -0,0 +1,295 @@
+#include "MatrixKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+#include "Parallel.hpp"
+#include "Simd.hpp"
+
+namespace NS_math {
+namespace matrix_kernels {
+
+namespace { // Anonymous namespace for private functions
+
+using KernelT = void (*)(const double*, const double*, double*, size_t, size_t, size_t) noexcept;
+
+#if NS_MATH_X86
+// 2 columns of c per step
+void mulSse2(const double* a, const double* b, double* c, size_t m, size_t k, size_t n) noexcept {
+    for (size_t i = 0; i < m; ++i) {
+        const double* a_row = a + i * k;
+        double* c_row = c + i * n;
+        size_t j = 0;
+        for (; j + 2 <= n; j += 2) {
+            __m128d acc = _mm_setzero_pd();
+            for (size_t kk = 0; kk < k; ++kk) {
+                acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(a_row[kk]), _mm_loadu_pd(b + kk * n + j)));
+            }
+            _mm_storeu_pd(c_row + j, acc);
+        }
+        for (; j < n; ++j) {
+            double acc = 0;
+            for (size_t kk = 0; kk < k; ++kk) {
+                acc += a_row[kk] * b[kk * n + j];
+            }
+            c_row[j] = acc;
+        }
+    }
+}
+#endif
+
+#if NS_MATH_HAS_AVX2_KERNELS
+// 8 columns of c per step (two independent FMA chains), then 4, then scalar
+NS_MATH_TARGET_AVX2
+void mulAvx2(const double* a, const double* b, double* c, size_t m, size_t k, size_t n) noexcept {
+    for (size_t i = 0; i < m; ++i) {
+        const double* a_row = a + i * k;
+        double* c_row = c + i * n;
+        size_t j = 0;
+        for (; j + 8 <= n; j += 8) {
+            __m256d acc0 = _mm256_setzero_pd();
+            __m256d acc1 = _mm256_setzero_pd();
+            for (size_t kk = 0; kk < k; ++kk) {
+                const __m256d a_ik = _mm256_broadcast_sd(a_row + kk);
+                const double* b_row = b + kk * n + j;
+                acc0 = _mm256_fmadd_pd(a_ik, _mm256_loadu_pd(b_row), acc0);
+                acc1 = _mm256_fmadd_pd(a_ik, _mm256_loadu_pd(b_row + 4), acc1);
+            }
+            _mm256_storeu_pd(c_row + j, acc0);
+            _mm256_storeu_pd(c_row + j + 4, acc1);
+        }
+        for (; j + 4 <= n; j += 4) {
+            __m256d acc = _mm256_setzero_pd();
+            for (size_t kk = 0; kk < k; ++kk) {
+                acc = _mm256_fmadd_pd(_mm256_broadcast_sd(a_row + kk), _mm256_loadu_pd(b + kk * n + j), acc);
+            }
+            _mm256_storeu_pd(c_row + j, acc);
+        }
+        for (; j < n; ++j) {
+            double acc = 0;
+            for (size_t kk = 0; kk < k; ++kk) {
+                acc += a_row[kk] * b[kk * n + j];
+            }
+            c_row[j] = acc;
+        }
+    }
+}
+#endif
+
+// blocking of mulBlocked, a c tile is TILE_M x TILE_N and the k loop goes in steps of BLOCK_K
+// packed a: TILE_M x BLOCK_K (128 KB, L2), packed b: BLOCK_K x TILE_N (512 KB), one micro-panel of b: 16 KB (L1)
+constexpr size_t MICRO_M = 4;
+constexpr size_t MICRO_N = 8;
+constexpr size_t TILE_M = 64;
+constexpr size_t TILE_N = 256;
+constexpr size_t BLOCK_K = 256;
+
+using PackBuffer = std::vector<double, AlignedAllocator<double, 64>>;
+
+struct TileBuffers {
+    PackBuffer packed_a = PackBuffer(TILE_M * BLOCK_K);
+    PackBuffer packed_b = PackBuffer(BLOCK_K * TILE_N);
+};
+
+// rows [i0, i0 + rows) x cols [p0, p0 + depth) of a into MICRO_M-row panels, column by column, zero padded
+void packA(const double* a, size_t k, size_t i0, size_t rows, size_t p0, size_t depth, double* out) noexcept {
+    for (size_t ir = 0; ir < rows; ir += MICRO_M) {
+        const size_t panel_rows = std::min(MICRO_M, rows - ir);
+        for (size_t p = 0; p < depth; ++p) {
+            size_t r = 0;
+            for (; r < panel_rows; ++r) {
+                out[r] = a[(i0 + ir + r) * k + p0 + p];
+            }
+            for (; r < MICRO_M; ++r) {
+                out[r] = 0;
+            }
+            out += MICRO_M;
+        }
+    }
+}
+
+// rows [p0, p0 + depth) x cols [j0, j0 + cols) of b into MICRO_N-column panels, row by row, zero padded
+void packB(const double* b, size_t n, size_t p0, size_t depth, size_t j0, size_t cols, double* out) noexcept {
+    for (size_t jr = 0; jr < cols; jr += MICRO_N) {
+        const size_t panel_cols = std::min(MICRO_N, cols - jr);
+        for (size_t p = 0; p < depth; ++p) {
+            const double* b_row = b + (p0 + p) * n + j0 + jr;
+            size_t col = 0;
+            for (; col < panel_cols; ++col) {
+                out[col] = b_row[col];
+            }
+            for (; col < MICRO_N; ++col) {
+                out[col] = 0;
+            }
+            out += MICRO_N;
+        }
+    }
+}
+
+// acc (MICRO_M x MICRO_N) = packed a panel * packed b panel
+using MicroKernelT = void (*)(size_t depth, const double* a_panel, const double* b_panel, double* acc) noexcept;
+
+void microKernelScalar(size_t depth, const double* a_panel, const double* b_panel, double* acc) noexcept {
+    double sums[MICRO_M][MICRO_N] = {};
+    for (size_t p = 0; p < depth; ++p) {
+        for (size_t r = 0; r < MICRO_M; ++r) {
+            const double a_rp = a_panel[p * MICRO_M + r];
+            for (size_t col = 0; col < MICRO_N; ++col) {
+                sums[r][col] += a_rp * b_panel[p * MICRO_N + col];
+            }
+        }
+    }
+    std::memcpy(acc, sums, sizeof(sums));
+}
+
+#if NS_MATH_HAS_AVX2_KERNELS
+// 4 rows x 2 registers of accumulators, 8 independent FMA chains per step of p
+NS_MATH_TARGET_AVX2
+void microKernelAvx2(size_t depth, const double* a_panel, const double* b_panel, double* acc) noexcept {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    for (size_t p = 0; p < depth; ++p) {
+        const __m256d b0 = _mm256_load_pd(b_panel);
+        const __m256d b1 = _mm256_load_pd(b_panel + 4);
+        __m256d a_r = _mm256_broadcast_sd(a_panel);
+        c00 = _mm256_fmadd_pd(a_r, b0, c00);
+        c01 = _mm256_fmadd_pd(a_r, b1, c01);
+        a_r = _mm256_broadcast_sd(a_panel + 1);
+        c10 = _mm256_fmadd_pd(a_r, b0, c10);
+        c11 = _mm256_fmadd_pd(a_r, b1, c11);
+        a_r = _mm256_broadcast_sd(a_panel + 2);
+        c20 = _mm256_fmadd_pd(a_r, b0, c20);
+        c21 = _mm256_fmadd_pd(a_r, b1, c21);
+        a_r = _mm256_broadcast_sd(a_panel + 3);
+        c30 = _mm256_fmadd_pd(a_r, b0, c30);
+        c31 = _mm256_fmadd_pd(a_r, b1, c31);
+        a_panel += MICRO_M;
+        b_panel += MICRO_N;
+    }
+    _mm256_storeu_pd(acc, c00);
+    _mm256_storeu_pd(acc + 4, c01);
+    _mm256_storeu_pd(acc + 8, c10);
+    _mm256_storeu_pd(acc + 12, c11);
+    _mm256_storeu_pd(acc + 16, c20);
+    _mm256_storeu_pd(acc + 20, c21);
+    _mm256_storeu_pd(acc + 24, c30);
+    _mm256_storeu_pd(acc + 28, c31);
+}
+#endif
+
+MicroKernelT selectMicroKernel() noexcept {
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        return microKernelAvx2;
+    }
+#endif
+    return microKernelScalar; // fixed bounds, the compiler vectorizes it with SSE2
+}
+
+// c tile [i0, i0 + rows) x [j0, j0 + cols) = a * b, accumulated over k in BLOCK_K steps
+void mulTile(
+    const double* a, const double* b, double* c, size_t k, size_t n,
+    size_t i0, size_t rows, size_t j0, size_t cols, TileBuffers& buffers, MicroKernelT micro_kernel
+) noexcept {
+    for (size_t i = 0; i < rows; ++i) {
+        std::fill_n(c + (i0 + i) * n + j0, cols, 0.0);
+    }
+    alignas(32) double acc[MICRO_M * MICRO_N];
+    for (size_t p0 = 0; p0 < k; p0 += BLOCK_K) {
+        const size_t depth = std::min(BLOCK_K, k - p0);
+        packA(a, k, i0, rows, p0, depth, buffers.packed_a.data());
+        packB(b, n, p0, depth, j0, cols, buffers.packed_b.data());
+        for (size_t jr = 0; jr < cols; jr += MICRO_N) {
+            const double* b_panel = buffers.packed_b.data() + jr * depth;
+            const size_t panel_cols = std::min(MICRO_N, cols - jr);
+            for (size_t ir = 0; ir < rows; ir += MICRO_M) {
+                micro_kernel(depth, buffers.packed_a.data() + ir * depth, b_panel, acc);
+                const size_t panel_rows = std::min(MICRO_M, rows - ir);
+                for (size_t r = 0; r < panel_rows; ++r) {
+                    double* c_row = c + (i0 + ir + r) * n + j0 + jr;
+                    for (size_t col = 0; col < panel_cols; ++col) {
+                        c_row[col] += acc[r * MICRO_N + col];
+                    }
+                }
+            }
+        }
+    }
+}
+
+KernelT selectKernel() noexcept {
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        return mulAvx2;
+    }
+#endif
+#if NS_MATH_X86
+    return mulSse2;
+#else
+    return mulScalar;
+#endif
+}
+
+} // Anonymous namespace end
+
+
+void mulScalar(const double* a, const double* b, double* c, size_t m, size_t k, size_t n) noexcept {
+    for (size_t i = 0; i < m; ++i) {
+        double* c_row = c + i * n;
+        for (size_t j = 0; j < n; ++j) {
+            c_row[j] = 0;
+        }
+        for (size_t kk = 0; kk < k; ++kk) {
+            const double a_ik = a[i * k + kk];
+            const double* b_row = b + kk * n;
+            for (size_t j = 0; j < n; ++j) {
+                c_row[j] += a_ik * b_row[j];
+            }
+        }
+    }
+}
+
+void mulDynamic(const double* a, const double* b, double* c, size_t m, size_t k, size_t n) noexcept {
+    static const KernelT kernel = selectKernel(); // resolved once
+    if (m >= MICRO_M && n >= MICRO_N && m * k * n >= blocked_min_num_of_ops) {
+        try {
+            mulBlocked(a, b, c, m, k, n);
+            return;
+        } catch (const std::bad_alloc&) {
+            // no memory for the packing buffers, the unblocked kernel needs none
+        }
+    }
+    kernel(a, b, c, m, k, n);
+}
+
+void mulBlocked(const double* a, const double* b, double* c, size_t m, size_t k, size_t n, size_t num_of_threads) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (k == 0) {
+        std::fill_n(c, m * n, 0.0);
+        return;
+    }
+    static const MicroKernelT micro_kernel = selectMicroKernel();
+    const size_t tile_rows = (m + TILE_M - 1) / TILE_M;
+    const size_t tile_cols = (n + TILE_N - 1) / TILE_N;
+    // small products are not worth a thread each
+    const size_t max_threads = (m * k * n < 4 * blocked_min_num_of_ops) ? 1 : num_of_threads;
+    parallel::forEachIndex(
+        tile_rows * tile_cols,
+        []() { return TileBuffers(); },
+        [&](TileBuffers& buffers, size_t tile) {
+            const size_t i0 = (tile / tile_cols) * TILE_M;
+            const size_t j0 = (tile % tile_cols) * TILE_N;
+            mulTile(a, b, c, k, n, i0, std::min(TILE_M, m - i0), j0, std::min(TILE_N, n - j0), buffers, micro_kernel);
+        },
+        max_threads
+    );
+}
+
+} // namespace matrix_kernels
+} // namespace NS_math
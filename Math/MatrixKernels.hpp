@@ -0,0 +1,87 @@
+#ifndef MATH_MATRIX_KERNELS_HPP
+#define MATH_MATRIX_KERNELS_HPP
+
+
+#include <array>
+#include <cstddef>
+
+namespace NS_math {
+namespace matrix_kernels {
+
+// below this many multiply-adds the fixed-size loops (unrolled by the compiler) are faster than dispatching
+constexpr size_t simd_min_num_of_ops = 512; // e.g. 8x8 * 8x8
+
+// c = a * b, all row-major and contiguous, a: m x k, b: k x n, c: m x n (c must not alias a or b)
+// picks the AVX2, SSE2 or scalar kernel at runtime
+void mulDynamic(const double* a, const double* b, double* c, size_t m, size_t k, size_t n) noexcept;
+// portable i-k-j loops, always available
+void mulScalar(const double* a, const double* b, double* c, size_t m, size_t k, size_t n) noexcept;
+
+// from this many multiply-adds on, mulDynamic goes to mulBlocked
+constexpr size_t blocked_min_num_of_ops = 64 * 64 * 64;
+
+/*
+c = a * b for big matrices, same layout as mulDynamic
+c is cut into tiles that are spread over num_of_threads workers (0: all hardware threads),
+a tile packs its panels of a and b into contiguous aligned buffers (sized for L1/L2)
+and runs a 4x8 register-tiled micro-kernel over them (AVX2/FMA if the CPU has it)
+throws std::bad_alloc (on the calling thread, after all workers are joined) if a buffer can't be allocated
+*/
+void mulBlocked(const double* a, const double* b, double* c, size_t m, size_t k, size_t n, size_t num_of_threads = 0);
+
+/*
+c = a * b for fixed sizes
+2x2, 3x3 and 4x4 are written out so they constant-fold and stay constexpr,
+other small sizes use loops with constant bounds, big ones go to mulDynamic
+Tools/snake-matbench times it against the loop Matrix::mul had before
+(2x2 and 3x3 gain little: that loop was already cheap at those sizes)
+*/
+template <size_t M, size_t K, size_t N>
+constexpr void mulFixed(
+    const std::array<std::array<double, K>, M>& a,
+    const std::array<std::array<double, N>, K>& b,
+    std::array<std::array<double, N>, M>& c
+) noexcept {
+    if constexpr (M == 2 && K == 2 && N == 2) {
+        c[0][0] = a[0][0] * b[0][0] + a[0][1] * b[1][0];
+        c[0][1] = a[0][0] * b[0][1] + a[0][1] * b[1][1];
+        c[1][0] = a[1][0] * b[0][0] + a[1][1] * b[1][0];
+        c[1][1] = a[1][0] * b[0][1] + a[1][1] * b[1][1];
+    } else if constexpr (M == 3 && K == 3 && N == 3) {
+        for (size_t i = 0; i < 3; ++i) {
+            const std::array<double, 3>& r = a[i];
+            c[i][0] = r[0] * b[0][0] + r[1] * b[1][0] + r[2] * b[2][0];
+            c[i][1] = r[0] * b[0][1] + r[1] * b[1][1] + r[2] * b[2][1];
+            c[i][2] = r[0] * b[0][2] + r[1] * b[1][2] + r[2] * b[2][2];
+        }
+    } else if constexpr (M == 4 && K == 4 && N == 4) {
+        for (size_t i = 0; i < 4; ++i) {
+            const std::array<double, 4>& r = a[i];
+            c[i][0] = r[0] * b[0][0] + r[1] * b[1][0] + r[2] * b[2][0] + r[3] * b[3][0];
+            c[i][1] = r[0] * b[0][1] + r[1] * b[1][1] + r[2] * b[2][1] + r[3] * b[3][1];
+            c[i][2] = r[0] * b[0][2] + r[1] * b[1][2] + r[2] * b[2][2] + r[3] * b[3][2];
+            c[i][3] = r[0] * b[0][3] + r[1] * b[1][3] + r[2] * b[2][3] + r[3] * b[3][3];
+        }
+    } else if constexpr (M * K * N < simd_min_num_of_ops) {
+        // i-k-j: the inner loop runs along rows of b and c, which the compiler vectorizes
+        for (size_t i = 0; i < M; ++i) {
+            for (size_t j = 0; j < N; ++j) {
+                c[i][j] = 0;
+            }
+            for (size_t kk = 0; kk < K; ++kk) {
+                const double a_ik = a[i][kk];
+                for (size_t j = 0; j < N; ++j) {
+                    c[i][j] += a_ik * b[kk][j];
+                }
+            }
+        }
+    } else {
+        static_assert(sizeof(a) == M * K * sizeof(double), "matrix rows must be contiguous");
+        mulDynamic(a[0].data(), b[0].data(), c[0].data(), M, K, N);
+    }
+}
+
+} // namespace matrix_kernels
+} // namespace NS_math
+
+#endif // MATH_MATRIX_KERNELS_HPP
@@ -0,0 +1,78 @@
+#ifndef MATH_PARALLEL_HPP
+#define MATH_PARALLEL_HPP
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace NS_math {
+namespace parallel {
+
+// number of workers used when the caller passes 0
+inline size_t defaultNumOfThreads() noexcept {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/*
+runs func(state, index) for every index in [0, num_of_tasks)
+each worker (the calling thread is one of them) makes its own state with make_state() once
+and claims indices from a shared counter, so uneven tasks still balance
+if make_state or func throws on any worker, the remaining tasks are dropped,
+all threads are joined and the first exception is rethrown on the calling thread
+*/
+template <typename MakeState, typename Func>
+void forEachIndex(size_t num_of_tasks, MakeState&& make_state, Func&& func, size_t max_threads = 0) {
+    std::atomic<size_t> next_task {0};
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+    auto worker = [&]() noexcept {
+        try {
+            auto state = make_state();
+            for (size_t i = next_task.fetch_add(1); i < num_of_tasks; i = next_task.fetch_add(1)) {
+                func(state, i);
+            }
+        } catch (...) {
+            next_task.store(num_of_tasks); // the other workers stop at their next claim
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+    };
+    const size_t num_of_threads = std::min(max_threads ? max_threads : defaultNumOfThreads(), num_of_tasks);
+    std::vector<std::thread> threads;
+    if (num_of_threads > 1) {
+        try {
+            threads.reserve(num_of_threads - 1);
+        } catch (const std::bad_alloc&) {
+            // no room for the handles, this thread does all the tasks
+        }
+    }
+    // never past the reserved capacity, so emplace_back can't reallocate (and throw bad_alloc) mid-loop
+    for (size_t t = 1; t < num_of_threads && threads.size() < threads.capacity(); ++t) {
+        try {
+            threads.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break; // the threads that did start (and this one) take the remaining tasks
+        }
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+} // namespace parallel
+} // namespace NS_math
+
+#endif // MATH_PARALLEL_HPP
@@ -0,0 +1,357 @@
+#include "Primes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#include "Parallel.hpp"
+
+namespace NS_math {
+namespace primes {
+
+namespace { // Anonymous namespace for private functions
+
+constexpr uint64_t SEGMENT_BYTES = uint64_t(1) << 16; // one byte per odd number
+constexpr uint64_t SEGMENT_SPAN = SEGMENT_BYTES * 2; // numbers covered by a segment
+constexpr uint64_t SEGMENTS_PER_BLOCK = 16; // a block is the unit of work of a thread
+constexpr uint64_t BLOCK_SPAN = SEGMENT_SPAN * SEGMENTS_PER_BLOCK;
+
+// odd primes whose multiples are pre-sieved with a pattern, 3 * 5 * 7 * 11 * 13 odd numbers long
+constexpr std::array<uint64_t, 5> PRESIEVE_PRIMES = {3, 5, 7, 11, 13};
+constexpr uint64_t PRESIEVE_PERIOD = 3 * 5 * 7 * 11 * 13;
+
+constexpr uint64_t TABLE_LIMIT = uint64_t(1) << 24; // largest limit kept in the shared table
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uwide_t;
+
+uint64_t mulMod(uint64_t a, uint64_t b, uint64_t m) noexcept {
+    return static_cast<uint64_t>(static_cast<uwide_t>(a) * b % m);
+}
+#else
+uint64_t mulMod(uint64_t a, uint64_t b, uint64_t m) noexcept {
+    // double and add, no 128-bit integer
+    uint64_t result = 0;
+    a %= m;
+    while (b) {
+        if (b & 1) {
+            result = (result >= m - a) ? result - (m - a) : result + a;
+        }
+        a = (a >= m - a) ? a - (m - a) : a + a;
+        b >>= 1;
+    }
+    return result;
+}
+#endif
+
+uint64_t powMod(uint64_t base, uint64_t exponent, uint64_t m) noexcept {
+    uint64_t result = 1;
+    base %= m;
+    while (exponent) {
+        if (exponent & 1) {
+            result = mulMod(result, base, m);
+        }
+        base = mulMod(base, base, m);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+// n odd, n > 3, n - 1 = d * 2^s
+bool isStrongProbablePrime(uint64_t n, uint64_t base, uint64_t d, int s) noexcept {
+    base %= n;
+    if (base == 0) {
+        return true;
+    }
+    uint64_t x = powMod(base, d, n);
+    if (x == 1 || x == n - 1) {
+        return true;
+    }
+    for (int r = 1; r < s; ++r) {
+        x = mulMod(x, x, n);
+        if (x == n - 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// odd primes <= limit, plain sieve (used for the sieving primes, limit is about sqrt of the range)
+std::vector<uint64_t> smallOddPrimes(uint64_t limit) {
+    std::vector<uint64_t> result;
+    if (limit < 3) {
+        return result;
+    }
+    std::vector<uint8_t> is_composite(limit / 2 + 1, 0); // index i -> 2i + 1
+    for (uint64_t i = 1; 2 * i + 1 <= limit; ++i) {
+        if (is_composite[i]) {
+            continue;
+        }
+        const uint64_t p = 2 * i + 1;
+        result.push_back(p);
+        for (uint64_t m = p * p; m <= limit; m += 2 * p) {
+            is_composite[m / 2] = 1;
+        }
+    }
+    return result;
+}
+
+// pattern[k] = 1 if 2k + 1 has no factor in PRESIEVE_PRIMES
+const std::vector<uint8_t>& presievePattern() {
+    static const std::vector<uint8_t> pattern = [] {
+        std::vector<uint8_t> result(PRESIEVE_PERIOD, 1);
+        for (uint64_t p : PRESIEVE_PRIMES) {
+            for (uint64_t k = p / 2; k < PRESIEVE_PERIOD; k += p) {
+                result[k] = 0;
+            }
+        }
+        return result;
+    }();
+    return pattern;
+}
+
+/*
+sieves [begin, end) (begin even) one segment at a time
+next_multiple[j] is the next odd multiple of sieving_primes[j] to cross off,
+it carries over from one segment to the next inside a block
+*/
+class BlockSieve {
+    private:
+        const std::vector<uint64_t>& sieving_primes; // odd primes > 13
+        std::vector<uint8_t> segment;
+        std::vector<uint64_t> next_multiple;
+
+    public:
+        explicit BlockSieve(const std::vector<uint64_t>& arg_sieving_primes)
+            : sieving_primes(arg_sieving_primes), segment(SEGMENT_BYTES), next_multiple(arg_sieving_primes.size()) {}
+
+        // calls on_segment(low, flags, length) for every segment, flags[i] = 1 if low + 2i + 1 is prime
+        template <typename OnSegment>
+        void run(uint64_t begin, uint64_t end, OnSegment&& on_segment) {
+            for (size_t j = 0; j < sieving_primes.size(); ++j) {
+                const uint64_t p = sieving_primes[j];
+                uint64_t m = std::max(p * p, (begin + p - 1) / p * p);
+                if (!(m & 1)) {
+                    m += p;
+                }
+                next_multiple[j] = m;
+            }
+            for (uint64_t low = begin; low < end; low += SEGMENT_SPAN) {
+                const uint64_t high = std::min(low + SEGMENT_SPAN, end);
+                const size_t length = static_cast<size_t>((high - low) / 2);
+                helperPresieve(low, length);
+                uint8_t* flags = segment.data();
+                for (size_t j = 0; j < sieving_primes.size(); ++j) {
+                    const uint64_t p = sieving_primes[j];
+                    if (p * p >= high) {
+                        break;
+                    }
+                    uint64_t m = next_multiple[j];
+                    for (; m < high; m += 2 * p) {
+                        flags[(m - low) / 2] = 0;
+                    }
+                    next_multiple[j] = m;
+                }
+                on_segment(low, static_cast<const uint8_t*>(flags), length);
+            }
+        }
+
+    private:
+        void helperPresieve(uint64_t low, size_t length) {
+            const std::vector<uint8_t>& pattern = presievePattern();
+            size_t offset = static_cast<size_t>((low / 2) % PRESIEVE_PERIOD);
+            size_t filled = 0;
+            while (filled < length) {
+                const size_t chunk = std::min(length - filled, static_cast<size_t>(PRESIEVE_PERIOD) - offset);
+                std::memcpy(segment.data() + filled, pattern.data() + offset, chunk);
+                filled += chunk;
+                offset = 0;
+            }
+            if (low == 0) {
+                segment[0] = 0; // 1 is not prime
+                for (uint64_t p : PRESIEVE_PRIMES) { // the pattern crossed off the pre-sieve primes themselves
+                    if (p / 2 < length) {
+                        segment[p / 2] = 1;
+                    }
+                }
+            }
+        }
+};
+
+// sieve [0, limit] block by block, on_block(block_index, sieve, begin, end) runs the sieve and keeps its output
+template <typename OnBlock>
+void sieveBlocks(uint64_t limit, OnBlock&& on_block) {
+    const uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(limit))) + 1;
+    std::vector<uint64_t> sieving_primes = smallOddPrimes(root);
+    sieving_primes.erase(
+        sieving_primes.begin(),
+        std::upper_bound(sieving_primes.begin(), sieving_primes.end(), PRESIEVE_PRIMES.back())
+    );
+    // odd numbers only, so sieve to an even end past limit and let on_block drop values > limit
+    const uint64_t end = (limit + 2) & ~uint64_t(1);
+    const size_t num_of_blocks = static_cast<size_t>((end + BLOCK_SPAN - 1) / BLOCK_SPAN);
+    parallel::forEachIndex(
+        num_of_blocks,
+        [&]() { return BlockSieve(sieving_primes); },
+        [&](BlockSieve& sieve, size_t block_index) {
+            const uint64_t begin = block_index * BLOCK_SPAN;
+            on_block(block_index, sieve, begin, std::min(begin + BLOCK_SPAN, end));
+        }
+    );
+}
+
+struct PrimeTable {
+    std::mutex mutex;
+    uint64_t limit = 0;
+    std::vector<uint64_t> primes;
+};
+
+PrimeTable& primeTable() {
+    static PrimeTable table;
+    return table;
+}
+
+std::vector<uint64_t> sievePrimesUpTo(uint64_t limit) {
+    std::vector<std::vector<uint64_t>> block_primes(static_cast<size_t>(((limit + 2) / BLOCK_SPAN) + 1));
+    sieveBlocks(limit, [&](size_t block_index, BlockSieve& sieve, uint64_t begin, uint64_t end) {
+        std::vector<uint64_t>& out = block_primes[block_index];
+        sieve.run(begin, end, [&](uint64_t low, const uint8_t* flags, size_t length) {
+            for (size_t i = 0; i < length; ++i) {
+                if (flags[i]) {
+                    const uint64_t value = low + 2 * i + 1;
+                    if (value > limit) {
+                        break;
+                    }
+                    out.push_back(value);
+                }
+            }
+        });
+    });
+    std::vector<uint64_t> result;
+    size_t total = 1;
+    for (const std::vector<uint64_t>& block : block_primes) {
+        total += block.size();
+    }
+    result.reserve(total);
+    result.push_back(2);
+    for (const std::vector<uint64_t>& block : block_primes) {
+        result.insert(result.end(), block.begin(), block.end());
+    }
+    return result;
+}
+
+} // Anonymous namespace end
+
+
+bool isPrime(uint64_t n) noexcept {
+    if (n < 2) {
+        return false;
+    }
+    constexpr std::array<uint64_t, 12> SMALL_PRIMES = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (uint64_t p : SMALL_PRIMES) {
+        if (n % p == 0) {
+            return n == p;
+        }
+    }
+    if (n < 41 * 41) {
+        return true;
+    }
+    uint64_t d = n - 1;
+    int s = 0;
+    while (!(d & 1)) {
+        d >>= 1;
+        ++s;
+    }
+    // these 7 bases decide every n < 2^64 (Jim Sinclair)
+    constexpr std::array<uint64_t, 7> BASES = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    for (uint64_t base : BASES) {
+        if (!isStrongProbablePrime(n, base, d, s)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint64_t> primesUpTo(uint64_t limit) {
+    if (limit < 2) {
+        return {};
+    }
+    PrimeTable& table = primeTable();
+    {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        if (limit <= table.limit) {
+            return std::vector<uint64_t>(
+                table.primes.begin(),
+                std::upper_bound(table.primes.begin(), table.primes.end(), limit)
+            );
+        }
+    }
+    // sieve without holding the lock, a bigger table may be stored meanwhile, keep the bigger one
+    if (limit <= TABLE_LIMIT) {
+        std::vector<uint64_t> result = sievePrimesUpTo(TABLE_LIMIT);
+        std::lock_guard<std::mutex> lock(table.mutex);
+        if (table.limit < TABLE_LIMIT) {
+            table.primes = result;
+            table.limit = TABLE_LIMIT;
+        }
+        result.erase(std::upper_bound(result.begin(), result.end(), limit), result.end());
+        return result;
+    }
+    return sievePrimesUpTo(limit);
+}
+
+std::vector<uint64_t> firstPrimes(size_t count) {
+    if (count == 0) {
+        return {};
+    }
+    // p_n < n (ln n + ln ln n) for n >= 6 (Rosser)
+    uint64_t bound = 15;
+    if (count >= 6) {
+        const double n = static_cast<double>(count);
+        bound = static_cast<uint64_t>(n * (std::log(n) + std::log(std::log(n)))) + 1;
+    }
+    std::vector<uint64_t> result = primesUpTo(bound);
+    result.resize(count);
+    return result;
+}
+
+uint64_t countPrimes(uint64_t limit) {
+    if (limit < 2) {
+        return 0;
+    }
+    {
+        PrimeTable& table = primeTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        if (limit <= table.limit) {
+            return static_cast<uint64_t>(
+                std::upper_bound(table.primes.begin(), table.primes.end(), limit) - table.primes.begin()
+            );
+        }
+    }
+    std::vector<uint64_t> block_counts(static_cast<size_t>(((limit + 2) / BLOCK_SPAN) + 1), 0);
+    sieveBlocks(limit, [&](size_t block_index, BlockSieve& sieve, uint64_t begin, uint64_t end) {
+        uint64_t count = 0;
+        sieve.run(begin, end, [&](uint64_t low, const uint8_t* flags, size_t length) {
+            // drop the odd numbers past limit in the last segment
+            if (low + 2 * length - 1 > limit) {
+                length = static_cast<size_t>((limit - low + 1) / 2);
+            }
+            size_t segment_count = 0;
+            for (size_t i = 0; i < length; ++i) {
+                segment_count += flags[i];
+            }
+            count += segment_count;
+        });
+        block_counts[block_index] = count;
+    });
+    uint64_t total = 1; // 2
+    for (uint64_t count : block_counts) {
+        total += count;
+    }
+    return total;
+}
+
+} // namespace primes
+} // namespace NS_math
@@ -0,0 +1,37 @@
+#ifndef MATH_PRIMES_HPP
+#define MATH_PRIMES_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace NS_math {
+namespace primes {
+
+/*
+prime numbers
+  - primesUpTo / countPrimes: segmented sieve of Eratosthenes over odd numbers
+    (one byte per odd number, 64 KB segments so a segment stays in cache),
+    multiples of 3, 5, 7, 11 and 13 are pre-sieved by copying a repeating pattern,
+    blocks of segments are spread over all hardware threads
+  - results up to 2^24 are kept in a shared table, later calls below that are copies
+  - isPrime: deterministic Miller-Rabin, exact for every 64-bit n
+countPrimes(1e10) does not store the primes, primesUpTo(1e10) would need ~3.6 GB
+*/
+
+bool isPrime(uint64_t n) noexcept;
+
+// all primes <= limit, ascending
+std::vector<uint64_t> primesUpTo(uint64_t limit);
+
+// the first count primes
+std::vector<uint64_t> firstPrimes(size_t count);
+
+// number of primes <= limit
+uint64_t countPrimes(uint64_t limit);
+
+} // namespace primes
+} // namespace NS_math
+
+#endif // MATH_PRIMES_HPP
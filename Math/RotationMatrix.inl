@@ -19,8 +19,9 @@ inline RotationMatrix<N>::RotationMatrix(
 ) : m_angle(rad), 
     SquareMatrix<N>::SquareMatrix() 
 {
-    data[0][0] = std::cos(rad); data[0][1] = -std::sin(rad);
-    data[1][0] = std::sin(rad); data[1][1] = std::cos(rad);
+    const trig::SinCos sin_cos = rad.getSinCos();
+    data[0][0] = sin_cos.cos; data[0][1] = -sin_cos.sin;
+    data[1][0] = sin_cos.sin; data[1][1] = sin_cos.cos;
     if constexpr (N == 3) {
                                         data[0][2] = 0;
                                         data[1][2] = 0;
@@ -0,0 +1,47 @@
+#ifndef MATH_SIMD_HPP
+#define MATH_SIMD_HPP
+
+// instruction set detection shared by the SIMD kernels of NS_math
+// AVX2 code is compiled per function (NS_MATH_TARGET_AVX2) and only called if hasAvx2() at runtime,
+// so the binary still runs on CPUs without it
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define NS_MATH_X86 1
+    #include <immintrin.h>
+#else
+    #define NS_MATH_X86 0
+#endif
+
+#if NS_MATH_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define NS_MATH_HAS_AVX2_KERNELS 1
+    #define NS_MATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#elif NS_MATH_X86 && defined(_MSC_VER) && defined(__AVX2__)
+    // MSVC cannot target single functions, only /arch:AVX2 builds get the kernels
+    #define NS_MATH_HAS_AVX2_KERNELS 1
+    #define NS_MATH_TARGET_AVX2
+#else
+    #define NS_MATH_HAS_AVX2_KERNELS 0
+    #define NS_MATH_TARGET_AVX2
+#endif
+
+namespace NS_math {
+namespace simd {
+
+// SSE2 is part of x86-64, so it is a compile time property
+constexpr bool has_sse2 = NS_MATH_X86;
+
+inline bool hasAvx2() noexcept {
+#if NS_MATH_HAS_AVX2_KERNELS && (defined(__GNUC__) || defined(__clang__))
+    static const bool result = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return result;
+#elif NS_MATH_HAS_AVX2_KERNELS
+    return true; // built with /arch:AVX2
+#else
+    return false;
+#endif
+}
+
+} // namespace simd
+} // namespace NS_math
+
+#endif // MATH_SIMD_HPP
@@ -8,6 +8,7 @@
 
 #include "MathUtils.hpp"
 #include "Matrix.hpp"
+#include "LUDecomposition.hpp"
 
 namespace NS_math {
 
@@ -162,34 +163,17 @@ class SquareMatrix : protected Matrix<N, N> {
             }
             return result;
         }
+        // 2x2, 3x3 and 4x4 stay constexpr (see matrix_kernels::mulFixed)
         inline constexpr SquareMatrix<N> operator*(const SquareMatrix<N>& other) const noexcept {
             SquareMatrix<N> result;
-            double tmp;
-            for (size_t rr = 0; rr < N; ++rr) {
-                for (size_t rc = 0; rc < N; ++rc) {
-                    tmp = 0;
-                    for (size_t i = 0; i < N; ++i) {
-                        tmp += data[rr][i] * other[i][rc];
-                    }
-                    result[rr][rc] = tmp;
-                }
-            }
+            matrix_kernels::mulFixed<N, N, N>(data, other.data, result.data);
             return result;
         }
         
         template <size_t ColN>
         inline constexpr Matrix<N, ColN> operator*(const Matrix<N, ColN>& mat) const noexcept {
             Matrix<N, ColN> result;
-            double tmp;
-            for (size_t rr = 0; rr < N; ++rr) { // first r in rr and rc means return/result
-                for (size_t rc = 0; rc < ColN; ++rc) {
-                    tmp = 0;
-                    for (size_t i = 0; i < N; ++i) {
-                        tmp += data[rr][i] * other[i][rc];
-                    }
-                    result[rr][rc] = tmp;
-                }
-            }
+            matrix_kernels::mulFixed<N, N, ColN>(data, mat.data, result.data);
             return result;
         }
 
@@ -266,31 +250,64 @@ class SquareMatrix : protected Matrix<N, N> {
             }
             return result;
         }
-        inline SquareMatrix<N> inverse() const {
-            double det = determinant();
-            if (det == 0) {
-                log_and_throw<std::runtime_error>(
-                    "inverse() const", 
-                    "this SquareMatrix is singular/non-invertible(determinant is zero)");
+        // LU factorization with partial pivoting, keep it to solve several systems with the same matrix
+        inline constexpr LUDecomposition<N> lu() const noexcept {
+            return LUDecomposition<N>(data);
+        }
+        // x such that (this)x = b, O(N^3), use lu().solve(...) for several b
+        inline std::array<double, N> solve(const std::array<double, N>& b) const {
+            try {
+                return lu().solve(b);
+            } catch (const std::exception& e) {
+                log_and_throw<Logger::SeeAbove>(
+                    "solve(const std::array<double, N>& b) const",
+                    e.what()
+                );
                 throw;
             }
-            if constexpr (N==1) {
-                return SquareMatrix<1>(1/data[0][0]);
-            } else if constexpr (N==2) {
-                return (
-                    SquareMatrix<2>({
-                        {data[1][1], -data[0][1]}, 
-                        {-data[1][0], data[0][0]}
-                    }) / det
+        }
+        template <size_t ColN>
+        inline Matrix<N, ColN> solve(const Matrix<N, ColN>& b) const {
+            try {
+                return Matrix<N, ColN>(lu().template solve<ColN>(b.data));
+            } catch (const std::exception& e) {
+                log_and_throw<Logger::SeeAbove>(
+                    "solve(const Matrix<N, ColN>& b) const",
+                    e.what()
                 );
+                throw;
+            }
+        }
+
+        inline SquareMatrix<N> inverse() const {
+            if constexpr (N > 2) {
+                // O(N^3) instead of the cofactor matrix
+                const LUDecomposition<N> decomposition = lu();
+                if (decomposition.isSingular()) {
+                    log_and_throw<std::runtime_error>(
+                        "inverse() const", 
+                        "this SquareMatrix is singular/non-invertible(determinant is zero)");
+                    throw;
+                }
+                return SquareMatrix<N>(decomposition.inverse());
             } else {
-                SquareMatrix<N> tmp;
-                for (size_t r = 0; r < N; ++r) {
-                    for (size_t c = 0; c < N; ++c) {
-                        tmp[r][c] = this->cofactor(r, c);
-                    }
+                double det = determinant();
+                if (det == 0) {
+                    log_and_throw<std::runtime_error>(
+                        "inverse() const", 
+                        "this SquareMatrix is singular/non-invertible(determinant is zero)");
+                    throw;
+                }
+                if constexpr (N==1) {
+                    return SquareMatrix<1>(1/data[0][0]);
+                } else {
+                    return (
+                        SquareMatrix<2>({
+                            {data[1][1], -data[0][1]}, 
+                            {-data[1][0], data[0][0]}
+                        }) / det
+                    );
                 }
-                return tmp.transpose() / det;
             }
         }
 
@@ -346,57 +363,8 @@ class SquareMatrix : protected Matrix<N, N> {
                     - data[0][1] * data[1][0] * data[2][2]
                     - data[0][0] * data[1][2] * data[2][1];
             } else {
-                static_assert(N > 3, "SquareMatrix::determinant NEVER !>3");
-                // N > 3
-                // with minor() {
-                // double result = 0.0;
-                // for (size_t r = 0; r < N; ++r) {
-                //     result += ((r % 2 == 1)? -1 : 1) * data[r][0] * minor(r, 0).determinant();
-                // }
-                // } mine {
-                double result = 0;
-                SquareMatrix<N-1> minor_matrix;
-                std::array<double, N-1> tmp_arr;
-                for (size_t r = 0; r < N-1; ++r) {
-                    for (size_t c = 0; c < N-1; ++c) {
-                        minor_matrix[r][c] = data[r+1][c+1];
-                    }
-                }
-                for (size_t r = 0; r < N; ++r) {
-                    result += ((r % 2 == 1)? -1 : 1) * data[r][0] * minor_matrix.determinant();
-                    if (r == N-1) {
-                        return result;
-                    }
-                    
-                    // sub_array of data[r] from index 1 to end // data[r][1:]
-                    for (size_t i = 0; i < N-1; ++i) {
-                        tmp_arr[i] = data[r][i+1];
-                    }
-                    minor_matrix[r] = tmp_arr;
-                }
-                log_and_throw<std::runtime_error>(
-                        "determinant() const",
-                        "UNREACHEABLE"
-                );
-                throw;
-                // } AI {
-                // double result = 0.0;
-                // for (size_t col = 0; col < N; ++col) {
-                //     SquareMatrix<N-1> minor;
-                //     // Build the minor matrix by skipping row 0 and column 'col'
-                //     for (size_t i = 1; i < N; ++i) {
-                //         size_t minor_col = 0;
-                //         for (size_t j = 0; j < N; ++j) {
-                //             if (j == col) continue;
-                //             minor[i-1][minor_col] = data[i][j];
-                //             ++minor_col;
-                //         }
-                //     }
-                //     double sign = ((col % 2) == 0) ? 1.0 : -1.0;
-                //     result += sign * data[0][col] * minor.determinant();
-                // }
-                // return result;
-                // }
+                // N > 3: O(N^3) instead of cofactor expansion
+                return lu().determinant();
             }
         }
 
@@ -4,11 +4,13 @@
 #include <array>
 #include "../Logger/Logger.hpp"
 #include "../Utils/utils.hpp"
+#include "VectorExpression.hpp"
 
 namespace NS_math {
 
+// arithmetic (+, -, * scalar, / scalar, unary -) is lazy, see VectorExpression.hpp
 template <size_t Dimension>
-class Vector {
+class Vector : public VectorExpression<Vector<Dimension>, Dimension> {
     static_assert(Dimension > 0, "Dimension should be larger than 0");
 
 protected:
@@ -17,14 +19,19 @@ protected:
 public:
     Vector(std::array<double, Dimension> arr);
     Vector(const std::initializer_list<double>& il);
-    Vector(const Vector&);
-    Vector(Vector&&);
+    Vector(const Vector&) = default;
+    Vector(Vector&&) = default;
     explicit Vector(const double& val = 0.0);
+    // evaluates the whole expression in one loop
+    template <typename Expression>
+    Vector(const VectorExpression<Expression, Dimension>& expr);
     // explicit Vector(const double& x, const double& y);
     // explicit Vector(const double& x, const double& y, const double& z);
     // explicit Vector(const double& x, const double& y, const double& z, const double& w);
 
-    Vector<Dimension>& operator=(Vector<Dimension> other);
+    Vector<Dimension>& operator=(const Vector<Dimension>& other) = default;
+    template <typename Expression>
+    Vector<Dimension>& operator=(const VectorExpression<Expression, Dimension>& expr);
 
     const double& x() const;
     double& x();
@@ -42,14 +49,13 @@ public:
     double& operator[](const size_t& index);
     const double& operator[](const size_t& index) const;
 
-    Vector<Dimension> operator-() const;
-    Vector<Dimension> operator+(const Vector<Dimension>& other) const;
-    Vector<Dimension> operator-(const Vector<Dimension>& other) const;
-    Vector<Dimension> operator*(double scalar) const;
-    Vector<Dimension> operator/(double scalar) const;
+    // unchecked element access for expressions
+    double eval(size_t index) const noexcept { return data[index]; }
 
-    Vector<Dimension>& operator+=(const Vector<Dimension>& other);
-    Vector<Dimension>& operator-=(const Vector<Dimension>& other);
+    template <typename Expression>
+    Vector<Dimension>& operator+=(const VectorExpression<Expression, Dimension>& expr);
+    template <typename Expression>
+    Vector<Dimension>& operator-=(const VectorExpression<Expression, Dimension>& expr);
     Vector<Dimension>& operator*=(double scalar);
     Vector<Dimension>& operator/=(double scalar);
 
@@ -67,7 +73,7 @@ public:
 
 private:
     template <typename ExceptionType>
-    void logAndThrow(const std::string& where, const std::string& message) const;
+    [[noreturn]] void logAndThrow(const std::string& where, const std::string& message) const;
 };
 
 } // namespace Math
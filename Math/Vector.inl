@@ -3,6 +3,10 @@
 
 #include "Vector.hpp"
 
+#include <cmath>
+
+#include "ZeroDivisionException.hpp"
+
 namespace NS_math {
 
 template <size_t Dimension>
@@ -22,17 +26,20 @@ Vector<Dimension>::Vector(const std::initializer_list<double>& il) {
     }
 }
 
-template <size_t Dimension>
-Vector<Dimension>::Vector(const Vector&) = default;
-
-template <size_t Dimension>
-Vector<Dimension>::Vector(Vector&&) = default;
-
 template <size_t Dimension>
 Vector<Dimension>::Vector(const double& val) {
     data.fill(val);
 }
 
+template <size_t Dimension>
+template <typename Expression>
+Vector<Dimension>::Vector(const VectorExpression<Expression, Dimension>& expr) {
+    const Expression& e = expr.derived();
+    for (size_t i = 0; i < Dimension; ++i) {
+        data[i] = e.eval(i);
+    }
+}
+
 // template <size_t Dimension>
 // Vector<Dimension>::Vector(const double& x, const double& y) {
 //     static_assert(Dimension == 2, "This constructor is only usable when Dimension = 2");
@@ -51,15 +58,56 @@ Vector<Dimension>::Vector(const double& val) {
 //     data = {x, y, z, w};
 // }
 
+// element i of the result only reads element i of the operands, so a = b + a is safe
 template <size_t Dimension>
-Vector<Dimension>& Vector<Dimension>::operator=(Vector<Dimension> other) {
-    if (this == &other) {
-        return *this;
+template <typename Expression>
+Vector<Dimension>& Vector<Dimension>::operator=(const VectorExpression<Expression, Dimension>& expr) {
+    const Expression& e = expr.derived();
+    for (size_t i = 0; i < Dimension; ++i) {
+        data[i] = e.eval(i);
     }
-    data = other.data;
     return *this;
 }
 
+template <size_t Dimension>
+const double& Vector<Dimension>::x() const {
+    return data[0];
+}
+template <size_t Dimension>
+double& Vector<Dimension>::x() {
+    return data[0];
+}
+template <size_t Dimension>
+const double& Vector<Dimension>::y() const {
+    static_assert(Dimension >= 2, "y() needs at least 2 dimensions");
+    return data[1];
+}
+template <size_t Dimension>
+double& Vector<Dimension>::y() {
+    static_assert(Dimension >= 2, "y() needs at least 2 dimensions");
+    return data[1];
+}
+template <size_t Dimension>
+const double& Vector<Dimension>::z() const {
+    static_assert(Dimension >= 3, "z() needs at least 3 dimensions");
+    return data[2];
+}
+template <size_t Dimension>
+double& Vector<Dimension>::z() {
+    static_assert(Dimension >= 3, "z() needs at least 3 dimensions");
+    return data[2];
+}
+template <size_t Dimension>
+const double& Vector<Dimension>::w() const {
+    static_assert(Dimension >= 4, "w() needs at least 4 dimensions");
+    return data[3];
+}
+template <size_t Dimension>
+double& Vector<Dimension>::w() {
+    static_assert(Dimension >= 4, "w() needs at least 4 dimensions");
+    return data[3];
+}
+
 template <size_t Dimension>
 std::array<double, Dimension> Vector<Dimension>::getData() const {
     return data;
@@ -96,68 +144,21 @@ const double& Vector<Dimension>::operator[](const size_t& index) const {
 }
 
 template <size_t Dimension>
-Vector<Dimension> Vector<Dimension>::operator-() const {
-    Vector<Dimension> result;
-    for (size_t i = 0; i < Dimension; ++i) {
-        result[i] = -data[i];
-    }
-    return result;
-}
-
-template <size_t Dimension>
-Vector<Dimension> Vector<Dimension>::operator+(const Vector<Dimension>& other) const {
-    Vector<Dimension> result;
-    for (size_t i = 0; i < Dimension; ++i) {
-        result[i] = data[i] + other[i];
-    }
-    return result;
-}
-
-template <size_t Dimension>
-Vector<Dimension> Vector<Dimension>::operator-(const Vector<Dimension>& other) const {
-    Vector<Dimension> result;
-    for (size_t i = 0; i < Dimension; ++i) {
-        result[i] = data[i] - other[i];
-    }
-    return result;
-}
-
-template <size_t Dimension>
-Vector<Dimension> Vector<Dimension>::operator*(double scalar) const {
-    Vector<Dimension> result;
-    for (size_t i = 0; i < Dimension; ++i) {
-        result[i] = data[i] * scalar;
-    }
-    return result;
-}
-
-template <size_t Dimension>
-Vector<Dimension> Vector<Dimension>::operator/(double scalar) const {
-    if (scalar == 0) { 
-        logAndThrow<ZeroDivisionError>(
-            "operator/(double scalar) const", 
-            "dividing by scalar, scalar cannot be zero"
-        );
-    }
-    Vector<Dimension> result;
-    for (size_t i = 0; i < Dimension; ++i) {
-        result[i] = data[i] / scalar;
-    }
-    return result;
-}
-
-template <size_t Dimension>
-Vector<Dimension>& Vector<Dimension>::operator+=(const Vector<Dimension>& other) {
+template <typename Expression>
+Vector<Dimension>& Vector<Dimension>::operator+=(const VectorExpression<Expression, Dimension>& expr) {
+    const Expression& e = expr.derived();
     for (size_t i = 0; i < Dimension; ++i) {
-        data[i] += other[i];
+        data[i] += e.eval(i);
     }
     return *this;
 }
 
 template <size_t Dimension>
-Vector<Dimension>& Vector<Dimension>::operator-=(const Vector<Dimension>& other) {
+template <typename Expression>
+Vector<Dimension>& Vector<Dimension>::operator-=(const VectorExpression<Expression, Dimension>& expr) {
+    const Expression& e = expr.derived();
     for (size_t i = 0; i < Dimension; ++i) {
-        data[i] -= other[i];
+        data[i] -= e.eval(i);
     }
     return *this;
 }
@@ -173,8 +174,8 @@ Vector<Dimension>& Vector<Dimension>::operator*=(double scalar) {
 template <size_t Dimension>
 Vector<Dimension>& Vector<Dimension>::operator/=(double scalar) {
     if (scalar == 0) { 
-        logAndThrow<ZeroDivisionError>(
-            "operator/(double scalar) const", 
+        logAndThrow<ZeroDivisionException>(
+            "operator/=(double scalar)", 
             "dividing by scalar, scalar cannot be zero"
         );
     }
@@ -209,19 +210,24 @@ double Vector<Dimension>::scalarCrossMul(const Vector<Dimension>& other) const {
     } else if constexpr (Dimension == 2) {
         return data[0] * other[1] - other[0] * data[1];
     } else if constexpr (Dimension == 3) {
-        return magnitude(cross_mul(other));
+        return crossMul(other).magnitude();
     }
-    logAndThrow<std::runtime_error>("scalarCrossMul", "");
+    logAndThrow<std::runtime_error>("scalarCrossMul", "only defined for 1 to 3 dimensions");
 }
 
 template <size_t Dimension>
 Vector<Dimension> Vector<Dimension>::crossMul(const Vector<Dimension>& other) const {
     static_assert(Dimension == 3, "crossMul can only be used for some dimensions of vectors");
+    return Vector<Dimension>({
+        data[1] * other.data[2] - data[2] * other.data[1],
+        data[2] * other.data[0] - data[0] * other.data[2],
+        data[0] * other.data[1] - data[1] * other.data[0]
+    });
 }
 
 template <size_t Dimension>
 bool Vector<Dimension>::isZeroVector(double precision) const {
-    return is_equal(Vector<Dimension>::zero_vector(), precision);
+    return isEqual(Vector<Dimension>::zeroVector(), precision);
 }
 
 template <size_t Dimension>
@@ -237,7 +243,7 @@ template <size_t Dimension>
 bool Vector<Dimension>::isParallel(const Vector<Dimension>& other, double precision) const {
     double ratio = data[0] / other[0];
     for (size_t i = 1; i < Dimension; ++i) {
-        if (!Utils::double_equal(ratio, data[i] / other[i])) {
+        if (std::abs(ratio - data[i] / other[i]) > precision) {
             return false;
         }
     }
@@ -246,7 +252,7 @@ bool Vector<Dimension>::isParallel(const Vector<Dimension>& other, double precis
 
 template <size_t Dimension>
 bool Vector<Dimension>::isPerpendicular(const Vector<Dimension>& other, double precision) const {
-    return std::abs(dot_mul(other)) < precision;
+    return std::abs(dotMul(other)) < precision;
 }
 
 template <size_t Dimension>
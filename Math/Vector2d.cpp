@@ -12,9 +12,6 @@ Vector2d::Vector2d(double arg_x, double arg_y)
     : Vector<2>{ arg_x, arg_y }
 {}
 
-Vector2d::Vector2d(const Vector2d&) = default;
-Vector2d::Vector2d(Vector2d&&) = default;
-
 Vector2d::Vector2d(const std::array<double, 2>& arr)
     : Vector<2>(arr) 
 {}
@@ -32,15 +29,7 @@ Vector2d::Vector2d(const std::initializer_list<double>& il)
     data[1] = *++ptr;
 }
 
-Vector2d Vector2d::operator=(const Vector2d& other) {
-    if (this == &other) {
-        return *this; // self-assignment check
-    }
-    data = other.data;
-    return *this;
-}
-
-Vector2d Vector2d::operator=(const Vector<2>& vect2d) {
+Vector2d& Vector2d::operator=(const Vector<2>& vect2d) {
     data = vect2d.getData();
     return *this;
 }
@@ -79,74 +68,6 @@ std::array<std::array<double, 1>, 2> Vector2d::toColumn() const {
     return column;
 }
 
-Vector2d Vector2d::operator-() const {
-    return Vector2d(-data[0], -data[1]);
-}
-
-Vector2d Vector2d::operator+(const Vector2d& other) const {
-    return Vector2d(data[0] + other[0], data[1] + other[1]);
-}
-
-Vector2d Vector2d::operator-(const Vector2d& other) const {
-    return Vector2d(data[0] - other[0], data[1] - other[1]);
-}
-
-Vector2d Vector2d::operator*(double scalar) const {
-    return Vector2d(data[0] * scalar, data[1] * scalar);
-}
-
-Vector2d Vector2d::operator/(double scalar) const {
-    if (scalar == 0) { 
-        logAndThrow<ZeroDivisionException>(
-            "operator/(double scalar) const", 
-            "dividing by scalar, scalar cannot be zero"
-        );
-    }
-    return Vector2d(data[0] * scalar, data[1] * scalar);
-}
-
-Vector2d& Vector2d::operator+=(const Vector2d& other) {
-    data[0] += other[0];
-    data[1] += other[1];
-    return *this;
-}
-
-Vector2d& Vector2d::operator-=(const Vector2d& other) {
-    data[0] -= other[0];
-    data[1] -= other[1];
-    return *this;
-}
-
-Vector2d& Vector2d::operator*=(double scalar) {
-    data[0] *= scalar;
-    data[1] *= scalar;
-    return *this;
-}
-
-Vector2d& Vector2d::operator/=(double scalar) {
-    if (scalar == 0) { 
-        logAndThrow<ZeroDivisionException>(
-            "operator/(double scalar) const", 
-            "dividing by scalar, scalar cannot be zero"
-        );
-    }
-    data[0] /= scalar;
-    data[1] /= scalar;
-    return *this;
-}
-
-double Vector2d::dotMul(const Vector2d& other) const {
-    return data[0] * other[0] + data[1] * other[1];
-}
-
-double Vector2d::scalarCrossMul(const Vector2d& other) const {
-    return data[0] * other[1] - other[0] * data[1];
-}
-
-double Vector2d::magnitude() const {
-    return std::sqrt(data[0] * data[0] + data[1] * data[1]);
-}
-
 bool Vector2d::isEqual(const Vector2d& other, double precision) const {
     return 
         std::abs(data[0] - other[0]) < precision 
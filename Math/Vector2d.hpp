@@ -13,15 +13,15 @@ class Vector2d : protected Vector<2> {
         explicit Vector2d();
         explicit Vector2d(double arg_x, double arg_y);
 
-        Vector2d(const Vector2d&);
-        Vector2d(Vector2d&&);
+        Vector2d(const Vector2d&) = default;
+        Vector2d(Vector2d&&) = default;
         
         Vector2d(const std::array<double, 2>& arr);
         Vector2d(const std::initializer_list<double>& il);
 
         // Assignment operator
-        Vector2d operator=(const Vector2d& other);
-        Vector2d operator=(const Vector<2>& vect2d);
+        Vector2d& operator=(const Vector2d& other) = default;
+        Vector2d& operator=(const Vector<2>& vect2d);
 
         const double& x() const { return data[0]; }
         const double& y() const { return data[1]; }
@@ -39,7 +39,9 @@ class Vector2d : protected Vector<2> {
         std::array<std::array<double, 1>, 2> toColumn() const;
 
         // Operators
-        
+        // arithmetic is inline (Vector2d.inl) so a + b * s - c compiles to straight-line
+        // code with the temporaries kept in registers
+
         double& operator[](size_t index) { return Vector<2>::operator[](index); }
         const double& operator[](size_t index) const { return Vector<2>::operator[](index); }
 
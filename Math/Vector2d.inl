@@ -3,6 +3,10 @@
 
 #include "Vector2d.hpp"
 
+#include <cmath>
+
+#include "ZeroDivisionException.hpp"
+
 namespace NS_math {
 
 template <typename ExceptionType>
@@ -12,6 +16,74 @@ inline void Vector2d::logAndThrow(const std::string& func_name, const std::strin
         message);
 }
 
+inline Vector2d Vector2d::operator-() const {
+    return Vector2d(-data[0], -data[1]);
+}
+
+inline Vector2d Vector2d::operator+(const Vector2d& other) const {
+    return Vector2d(data[0] + other.data[0], data[1] + other.data[1]);
+}
+
+inline Vector2d Vector2d::operator-(const Vector2d& other) const {
+    return Vector2d(data[0] - other.data[0], data[1] - other.data[1]);
+}
+
+inline Vector2d Vector2d::operator*(double scalar) const {
+    return Vector2d(data[0] * scalar, data[1] * scalar);
+}
+
+inline Vector2d Vector2d::operator/(double scalar) const {
+    if (scalar == 0) { 
+        logAndThrow<ZeroDivisionException>(
+            "operator/(double scalar) const", 
+            "dividing by scalar, scalar cannot be zero"
+        );
+    }
+    return Vector2d(data[0] / scalar, data[1] / scalar);
+}
+
+inline Vector2d& Vector2d::operator+=(const Vector2d& other) {
+    data[0] += other.data[0];
+    data[1] += other.data[1];
+    return *this;
+}
+
+inline Vector2d& Vector2d::operator-=(const Vector2d& other) {
+    data[0] -= other.data[0];
+    data[1] -= other.data[1];
+    return *this;
+}
+
+inline Vector2d& Vector2d::operator*=(double scalar) {
+    data[0] *= scalar;
+    data[1] *= scalar;
+    return *this;
+}
+
+inline Vector2d& Vector2d::operator/=(double scalar) {
+    if (scalar == 0) { 
+        logAndThrow<ZeroDivisionException>(
+            "operator/=(double scalar)", 
+            "dividing by scalar, scalar cannot be zero"
+        );
+    }
+    data[0] /= scalar;
+    data[1] /= scalar;
+    return *this;
+}
+
+inline double Vector2d::dotMul(const Vector2d& other) const {
+    return data[0] * other.data[0] + data[1] * other.data[1];
+}
+
+inline double Vector2d::scalarCrossMul(const Vector2d& other) const {
+    return data[0] * other.data[1] - other.data[0] * data[1];
+}
+
+inline double Vector2d::magnitude() const {
+    return std::sqrt(data[0] * data[0] + data[1] * data[1]);
+}
+
 }
 
 #endif // VECTOR_2D_INL
\ No newline at end of file
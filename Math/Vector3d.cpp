@@ -56,34 +56,6 @@ const double& Vector3d::operator[](size_t index) const {
 }
 
 
-Vector3d Vector3d::operator+(const Vector3d& other) const {
-    return Vector3d(x+other.x, y+other.y, z+other.z);
-}
-Vector3d Vector3d::operator-(const Vector3d& other) const {
-    return Vector3d(x-other.x, y-other.y, z-other.z);
-}
-Vector3d Vector3d::operator*(double scalar) const {
-    return Vector3d(x * scalar, y * scalar, z * scalar);
-}
-Vector3d Vector3d::operator/(double scalar) const {
-    if (scalar == 0) {
-        throw std::invalid_argument("Vector3d::operator/(double) ZeroDivisionError: divisor cannot be 0");
-    }
-    return Vector3d(x / scalar, y / scalar, z / scalar);
-}
-double Vector3d::dot_mul(const Vector3d& other) const {
-    return x*other.x + y*other.y + z*other.z;
-}
-Vector3d Vector3d::cross_mul(const Vector3d& other) const {
-    return Vector3d(
-        y * other.z - z * other.y,
-        z * other.x - x * other.z,
-        x * other.y - y * other.x
-    );
-}
-double Vector3d::magnitude() const {
-    return sqrt(x*x + y*y + z*z);
-}
 Vector3d Vector3d::unit_vector() const {
     if (is_equal(Vector3d(0, 0, 0))) {
         return Vector3d(0, 0, 0); // Return zero vector if magnitude is zero
@@ -6,6 +6,7 @@
 #include <type_traits>
 #include <stdexcept>
 #include <iterator>
+#include <cmath>
 
 #include "../Logger/Logger.hpp"
 
@@ -54,15 +55,8 @@ class Vector3d {
         
 
         // Assignment operator
-        inline Vector3d operator=(const Vector3d& other) {
-            if (this == &other) {
-                return *this; // self-assignment check
-            }
-            x = other.x;
-            y = other.y;
-            z = other.z;
-            return *this;
-        }
+        inline Vector3d& operator=(const Vector3d& other) = default;
+        inline Vector3d& operator=(Vector3d&& other) = default;
 
         std::string to_string(bool add_prefix = true) const;
         std::array<double, 3> to_array() const;
@@ -73,13 +67,57 @@ class Vector3d {
         double& operator[](size_t index);
         const double& operator[](size_t index) const;
 
-        Vector3d operator+(const Vector3d& other) const;
-        Vector3d operator-(const Vector3d& other) const;
-        Vector3d operator*(double scalar) const;
-        Vector3d operator/(double scalar) const;
-        double dot_mul(const Vector3d& other) const;
-        Vector3d cross_mul(const Vector3d& other) const;
-        double magnitude() const;
+        // arithmetic is inline so a + b * s - c compiles to straight-line code
+        // with the temporaries kept in registers
+        inline Vector3d operator-() const {
+            return Vector3d(-x, -y, -z);
+        }
+        inline Vector3d operator+(const Vector3d& other) const {
+            return Vector3d(x + other.x, y + other.y, z + other.z);
+        }
+        inline Vector3d operator-(const Vector3d& other) const {
+            return Vector3d(x - other.x, y - other.y, z - other.z);
+        }
+        inline Vector3d operator*(double scalar) const {
+            return Vector3d(x * scalar, y * scalar, z * scalar);
+        }
+        inline Vector3d operator/(double scalar) const {
+            if (scalar == 0) {
+                throw std::invalid_argument("Vector3d::operator/(double) ZeroDivisionError: divisor cannot be 0");
+            }
+            return Vector3d(x / scalar, y / scalar, z / scalar);
+        }
+        inline Vector3d& operator+=(const Vector3d& other) {
+            x += other.x;
+            y += other.y;
+            z += other.z;
+            return *this;
+        }
+        inline Vector3d& operator-=(const Vector3d& other) {
+            x -= other.x;
+            y -= other.y;
+            z -= other.z;
+            return *this;
+        }
+        inline Vector3d& operator*=(double scalar) {
+            x *= scalar;
+            y *= scalar;
+            z *= scalar;
+            return *this;
+        }
+        inline double dot_mul(const Vector3d& other) const {
+            return x * other.x + y * other.y + z * other.z;
+        }
+        inline Vector3d cross_mul(const Vector3d& other) const {
+            return Vector3d(
+                y * other.z - z * other.y,
+                z * other.x - x * other.z,
+                x * other.y - y * other.x
+            );
+        }
+        inline double magnitude() const {
+            return std::sqrt(x * x + y * y + z * z);
+        }
         Vector3d unit_vector() const;
 
         bool is_zero_vector(double precision = 1e-6) const;
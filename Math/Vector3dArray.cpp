@@ -0,0 +1,316 @@
+#include "Vector3dArray.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Simd.hpp"
+
+namespace NS_math {
+
+namespace { // Anonymous namespace for private functions
+
+struct Planes {
+    const double* x;
+    const double* y;
+    const double* z;
+};
+
+struct MutablePlanes {
+    double* x;
+    double* y;
+    double* z;
+};
+
+void dotScalar(Planes a, Planes b, double* result, size_t begin, size_t n) noexcept {
+    for (size_t i = begin; i < n; ++i) {
+        result[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+    }
+}
+
+void dotConstScalar(Planes a, double vx, double vy, double vz, double* result, size_t begin, size_t n) noexcept {
+    for (size_t i = begin; i < n; ++i) {
+        result[i] = a.x[i] * vx + a.y[i] * vy + a.z[i] * vz;
+    }
+}
+
+// element by element, so out may be a or b
+void crossScalar(Planes a, Planes b, MutablePlanes out, size_t begin, size_t n) noexcept {
+    for (size_t i = begin; i < n; ++i) {
+        const double x = a.y[i] * b.z[i] - a.z[i] * b.y[i];
+        const double y = a.z[i] * b.x[i] - a.x[i] * b.z[i];
+        const double z = a.x[i] * b.y[i] - a.y[i] * b.x[i];
+        out.x[i] = x;
+        out.y[i] = y;
+        out.z[i] = z;
+    }
+}
+
+void normalizeScalar(MutablePlanes v, size_t begin, size_t n) noexcept {
+    for (size_t i = begin; i < n; ++i) {
+        const double length_squared = v.x[i] * v.x[i] + v.y[i] * v.y[i] + v.z[i] * v.z[i];
+        if (length_squared > 0) {
+            const double inv = 1.0 / std::sqrt(length_squared);
+            v.x[i] *= inv;
+            v.y[i] *= inv;
+            v.z[i] *= inv;
+        }
+    }
+}
+
+#if NS_MATH_HAS_AVX2_KERNELS
+NS_MATH_TARGET_AVX2
+inline __m256d dotAvx2(__m256d ax, __m256d ay, __m256d az, __m256d bx, __m256d by, __m256d bz) noexcept {
+    return _mm256_fmadd_pd(ax, bx, _mm256_fmadd_pd(ay, by, _mm256_mul_pd(az, bz)));
+}
+
+NS_MATH_TARGET_AVX2
+void dotAvx2(Planes a, Planes b, double* result, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(result + i, dotAvx2(
+            _mm256_load_pd(a.x + i), _mm256_load_pd(a.y + i), _mm256_load_pd(a.z + i),
+            _mm256_load_pd(b.x + i), _mm256_load_pd(b.y + i), _mm256_load_pd(b.z + i)
+        ));
+    }
+    dotScalar(a, b, result, i, n);
+}
+
+NS_MATH_TARGET_AVX2
+void dotConstAvx2(Planes a, double vx, double vy, double vz, double* result, size_t n) noexcept {
+    const __m256d bx = _mm256_set1_pd(vx);
+    const __m256d by = _mm256_set1_pd(vy);
+    const __m256d bz = _mm256_set1_pd(vz);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(result + i, dotAvx2(
+            _mm256_load_pd(a.x + i), _mm256_load_pd(a.y + i), _mm256_load_pd(a.z + i), bx, by, bz
+        ));
+    }
+    dotConstScalar(a, vx, vy, vz, result, i, n);
+}
+
+NS_MATH_TARGET_AVX2
+void crossAvx2(Planes a, Planes b, MutablePlanes out, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d ax = _mm256_load_pd(a.x + i);
+        const __m256d ay = _mm256_load_pd(a.y + i);
+        const __m256d az = _mm256_load_pd(a.z + i);
+        const __m256d bx = _mm256_load_pd(b.x + i);
+        const __m256d by = _mm256_load_pd(b.y + i);
+        const __m256d bz = _mm256_load_pd(b.z + i);
+        _mm256_store_pd(out.x + i, _mm256_fmsub_pd(ay, bz, _mm256_mul_pd(az, by)));
+        _mm256_store_pd(out.y + i, _mm256_fmsub_pd(az, bx, _mm256_mul_pd(ax, bz)));
+        _mm256_store_pd(out.z + i, _mm256_fmsub_pd(ax, by, _mm256_mul_pd(ay, bx)));
+    }
+    crossScalar(a, b, out, i, n);
+}
+
+NS_MATH_TARGET_AVX2
+void lengthsSquaredAvx2(Planes a, double* result, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d x = _mm256_load_pd(a.x + i);
+        const __m256d y = _mm256_load_pd(a.y + i);
+        const __m256d z = _mm256_load_pd(a.z + i);
+        _mm256_storeu_pd(result + i, dotAvx2(x, y, z, x, y, z));
+    }
+    dotScalar(a, a, result, i, n);
+}
+
+NS_MATH_TARGET_AVX2
+void normalizeAvx2(MutablePlanes v, size_t n) noexcept {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d x = _mm256_load_pd(v.x + i);
+        const __m256d y = _mm256_load_pd(v.y + i);
+        const __m256d z = _mm256_load_pd(v.z + i);
+        const __m256d length_squared = dotAvx2(x, y, z, x, y, z);
+        // zero vectors get a factor of 1 (and stay zero) instead of inf
+        const __m256d is_zero = _mm256_cmp_pd(length_squared, zero, _CMP_EQ_OQ);
+        const __m256d inv = _mm256_blendv_pd(_mm256_div_pd(one, _mm256_sqrt_pd(length_squared)), one, is_zero);
+        _mm256_store_pd(v.x + i, _mm256_mul_pd(x, inv));
+        _mm256_store_pd(v.y + i, _mm256_mul_pd(y, inv));
+        _mm256_store_pd(v.z + i, _mm256_mul_pd(z, inv));
+    }
+    normalizeScalar(v, i, n);
+}
+#endif
+
+// add/sub/scale are plain loops over the planes, the compiler vectorizes them already
+
+} // Anonymous namespace end
+
+
+Vector3dArray::Vector3dArray(const std::vector<Vector3d>& vectors)
+    : xs(vectors.size()), ys(vectors.size()), zs(vectors.size())
+{
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        xs[i] = vectors[i].x;
+        ys[i] = vectors[i].y;
+        zs[i] = vectors[i].z;
+    }
+}
+
+void Vector3dArray::pushBack(const Vector3d& vector) {
+    xs.push_back(vector.x);
+    ys.push_back(vector.y);
+    zs.push_back(vector.z);
+}
+
+void Vector3dArray::fill(const Vector3d& value) {
+    std::fill(xs.begin(), xs.end(), value.x);
+    std::fill(ys.begin(), ys.end(), value.y);
+    std::fill(zs.begin(), zs.end(), value.z);
+}
+
+Vector3d Vector3dArray::get(size_t index) const {
+    if (index >= size()) {
+        logAndThrow<std::out_of_range>("get(size_t index) const", "index(" + std::to_string(index) + ") out of range");
+    }
+    return Vector3d(xs[index], ys[index], zs[index]);
+}
+void Vector3dArray::set(size_t index, const Vector3d& value) {
+    if (index >= size()) {
+        logAndThrow<std::out_of_range>("set(size_t index, const Vector3d& value)", "index(" + std::to_string(index) + ") out of range");
+    }
+    xs[index] = value.x;
+    ys[index] = value.y;
+    zs[index] = value.z;
+}
+
+Vector3dArray& Vector3dArray::operator+=(const Vector3dArray& other) {
+    helperThrowIfSizeNotMatch("operator+=(const Vector3dArray& other)", other);
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        xs[i] += other.xs[i];
+        ys[i] += other.ys[i];
+        zs[i] += other.zs[i];
+    }
+    return *this;
+}
+Vector3dArray& Vector3dArray::operator-=(const Vector3dArray& other) {
+    helperThrowIfSizeNotMatch("operator-=(const Vector3dArray& other)", other);
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        xs[i] -= other.xs[i];
+        ys[i] -= other.ys[i];
+        zs[i] -= other.zs[i];
+    }
+    return *this;
+}
+Vector3dArray& Vector3dArray::addScaled(const Vector3dArray& other, double scalar) {
+    helperThrowIfSizeNotMatch("addScaled(const Vector3dArray& other, double scalar)", other);
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        xs[i] += other.xs[i] * scalar;
+        ys[i] += other.ys[i] * scalar;
+        zs[i] += other.zs[i] * scalar;
+    }
+    return *this;
+}
+Vector3dArray& Vector3dArray::operator+=(const Vector3d& offset) noexcept {
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        xs[i] += offset.x;
+        ys[i] += offset.y;
+        zs[i] += offset.z;
+    }
+    return *this;
+}
+Vector3dArray& Vector3dArray::operator*=(double scalar) noexcept {
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        xs[i] *= scalar;
+        ys[i] *= scalar;
+        zs[i] *= scalar;
+    }
+    return *this;
+}
+
+void Vector3dArray::dot(const Vector3dArray& other, std::vector<double>& result) const {
+    helperThrowIfSizeNotMatch("dot(const Vector3dArray& other, std::vector<double>& result) const", other);
+    result.resize(size());
+    const Planes a {xs.data(), ys.data(), zs.data()};
+    const Planes b {other.xs.data(), other.ys.data(), other.zs.data()};
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        dotAvx2(a, b, result.data(), size());
+        return;
+    }
+#endif
+    dotScalar(a, b, result.data(), 0, size());
+}
+void Vector3dArray::dot(const Vector3d& vector, std::vector<double>& result) const {
+    result.resize(size());
+    const Planes a {xs.data(), ys.data(), zs.data()};
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        dotConstAvx2(a, vector.x, vector.y, vector.z, result.data(), size());
+        return;
+    }
+#endif
+    dotConstScalar(a, vector.x, vector.y, vector.z, result.data(), 0, size());
+}
+void Vector3dArray::cross(const Vector3dArray& other, Vector3dArray& result) const {
+    helperThrowIfSizeNotMatch("cross(const Vector3dArray& other, Vector3dArray& result) const", other);
+    result.resize(size());
+    const Planes a {xs.data(), ys.data(), zs.data()};
+    const Planes b {other.xs.data(), other.ys.data(), other.zs.data()};
+    const MutablePlanes out {result.xs.data(), result.ys.data(), result.zs.data()};
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        crossAvx2(a, b, out, size());
+        return;
+    }
+#endif
+    crossScalar(a, b, out, 0, size());
+}
+
+void Vector3dArray::lengthsSquared(std::vector<double>& result) const {
+    result.resize(size());
+    const Planes a {xs.data(), ys.data(), zs.data()};
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        lengthsSquaredAvx2(a, result.data(), size());
+        return;
+    }
+#endif
+    dotScalar(a, a, result.data(), 0, size());
+}
+void Vector3dArray::lengths(std::vector<double>& result) const {
+    lengthsSquared(result);
+    for (double& x : result) {
+        x = std::sqrt(x);
+    }
+}
+Vector3dArray& Vector3dArray::normalize() noexcept {
+    const MutablePlanes v {xs.data(), ys.data(), zs.data()};
+#if NS_MATH_HAS_AVX2_KERNELS
+    if (simd::hasAvx2()) {
+        normalizeAvx2(v, size());
+        return *this;
+    }
+#endif
+    normalizeScalar(v, 0, size());
+    return *this;
+}
+
+std::vector<Vector3d> Vector3dArray::toVector() const {
+    std::vector<Vector3d> result;
+    result.reserve(size());
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        result.emplace_back(xs[i], ys[i], zs[i]);
+    }
+    return result;
+}
+
+// private
+
+void Vector3dArray::helperThrowIfSizeNotMatch(const std::string& func_name, const Vector3dArray& other) const {
+    if (size() != other.size()) {
+        logAndThrow<std::invalid_argument>(
+            func_name,
+            "size does not match (" + std::to_string(size()) + " vs " + std::to_string(other.size()) + ")"
+        );
+    }
+}
+
+} // namespace NS_math
@@ -0,0 +1,87 @@
+#ifndef MATH_VECTOR_3D_ARRAY_HPP
+#define MATH_VECTOR_3D_ARRAY_HPP
+
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include "AlignedAllocator.hpp"
+#include "Vector3d.hpp"
+#include "../Logger/Logger.hpp"
+
+namespace NS_math {
+
+/*
+array of Vector3d stored as three planes (SoA): all x, then all y, then all z
+so dot/cross/normalize/length run 4 vectors per AVX2 register (if the CPU has it)
+the results go into caller owned buffers, reuse them instead of creating one per frame
+*/
+class Vector3dArray {
+    public:
+        using PlaneT = std::vector<double, AlignedAllocator<double, 64>>;
+
+    private:
+        PlaneT xs;
+        PlaneT ys;
+        PlaneT zs;
+
+    public:
+        Vector3dArray() = default;
+        explicit Vector3dArray(size_t n) : xs(n, 0.0), ys(n, 0.0), zs(n, 0.0) {}
+        explicit Vector3dArray(const std::vector<Vector3d>& vectors);
+
+        size_t size() const noexcept { return xs.size(); }
+        bool empty() const noexcept { return xs.empty(); }
+        void resize(size_t n) { xs.resize(n, 0.0); ys.resize(n, 0.0); zs.resize(n, 0.0); }
+        void reserve(size_t n) { xs.reserve(n); ys.reserve(n); zs.reserve(n); }
+        void clear() noexcept { xs.clear(); ys.clear(); zs.clear(); }
+        void pushBack(const Vector3d& vector);
+        void fill(const Vector3d& value);
+
+        double* getXPtr() noexcept { return xs.data(); }
+        double* getYPtr() noexcept { return ys.data(); }
+        double* getZPtr() noexcept { return zs.data(); }
+        const double* cgetXPtr() const noexcept { return xs.data(); }
+        const double* cgetYPtr() const noexcept { return ys.data(); }
+        const double* cgetZPtr() const noexcept { return zs.data(); }
+
+        Vector3d get(size_t index) const;
+        void set(size_t index, const Vector3d& value);
+        Vector3d operator[](size_t index) const noexcept { return Vector3d(xs[index], ys[index], zs[index]); }
+
+        // element-wise, sizes must match
+        Vector3dArray& operator+=(const Vector3dArray& other);
+        Vector3dArray& operator-=(const Vector3dArray& other);
+        // this += other * scalar, e.g. positions += velocities * dt
+        Vector3dArray& addScaled(const Vector3dArray& other, double scalar);
+        // the same vector for every element
+        Vector3dArray& operator+=(const Vector3d& offset) noexcept;
+        Vector3dArray& operator*=(double scalar) noexcept;
+
+        // result[i] = this[i] . other[i] (result is resized)
+        void dot(const Vector3dArray& other, std::vector<double>& result) const;
+        // result[i] = this[i] . vector, e.g. normals . light direction
+        void dot(const Vector3d& vector, std::vector<double>& result) const;
+        // result[i] = this[i] x other[i] (result is resized, may be this or other)
+        void cross(const Vector3dArray& other, Vector3dArray& result) const;
+
+        void lengthsSquared(std::vector<double>& result) const;
+        void lengths(std::vector<double>& result) const;
+        // every vector to length 1, zero vectors stay zero (Vector3d::unit_vector throws for them)
+        Vector3dArray& normalize() noexcept;
+
+        std::vector<Vector3d> toVector() const;
+
+    private:
+        void helperThrowIfSizeNotMatch(const std::string& func_name, const Vector3dArray& other) const;
+
+        template <typename ExceptionType>
+        [[noreturn]] void logAndThrow(const std::string& where, const std::string& what) const {
+            Logger::logAndThrow<ExceptionType>("Vector3dArray::" + where, what);
+        }
+};
+
+} // namespace NS_math
+
+#endif // MATH_VECTOR_3D_ARRAY_HPP
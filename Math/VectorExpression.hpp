@@ -0,0 +1,171 @@
+#ifndef MATH_VECTOR_EXPRESSION_HPP
+#define MATH_VECTOR_EXPRESSION_HPP
+
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "ZeroDivisionException.hpp"
+#include "../Logger/Logger.hpp"
+
+namespace NS_math {
+
+template <size_t Dimension>
+class Vector;
+
+/*
+expression templates for Vector<Dimension>
+  a + b * s - c only builds a tree of small nodes, nothing is computed until the
+  tree is assigned to (or constructs) a Vector, then one loop evaluates every element
+  -> no temporary vectors, one pass over the data
+caution: nodes refer to the vectors they read, do not keep an expression in `auto`
+  past the end of the statement, convert it to a Vector instead
+the read-only members of Vector can be called on a node too, e.g. (a - b).magnitude(),
+they evaluate it into a Vector first (Vector itself hides them with its own)
+*/
+template <typename Derived, size_t Dimension>
+class VectorExpression {
+    public:
+        static constexpr size_t dimension = Dimension;
+
+        const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
+
+        Vector<Dimension> evaluate() const { return Vector<Dimension>(*this); }
+
+        double x() const { return evaluate().x(); }
+        double y() const { return evaluate().y(); }
+        double z() const { return evaluate().z(); }
+        double w() const { return evaluate().w(); }
+        double operator[](const size_t& index) const { return evaluate()[index]; }
+        std::array<double, Dimension> getData() const { return evaluate().getData(); }
+
+        double magnitude() const { return evaluate().magnitude(); }
+        double dotMul(const Vector<Dimension>& other) const { return evaluate().dotMul(other); }
+        double scalarCrossMul(const Vector<Dimension>& other) const { return evaluate().scalarCrossMul(other); }
+        Vector<Dimension> crossMul(const Vector<Dimension>& other) const { return evaluate().crossMul(other); }
+
+        bool isZeroVector(double precision = 1e-6) const { return evaluate().isZeroVector(precision); }
+        bool isEqual(const Vector<Dimension>& other, double precision = 1e-6) const {
+            return evaluate().isEqual(other, precision);
+        }
+        bool isParallel(const Vector<Dimension>& other, double precision = 1e-6) const {
+            return evaluate().isParallel(other, precision);
+        }
+        bool isPerpendicular(const Vector<Dimension>& other, double precision = 1e-6) const {
+            return evaluate().isPerpendicular(other, precision);
+        }
+};
+
+// Vector leaves are held by reference, nodes are a few bytes and are held by value
+// (a node is a temporary of the full expression, a reference to it would dangle
+//  once it is returned from an operator)
+template <typename Expression>
+struct VectorOperand { using type = const Expression; };
+template <size_t Dimension>
+struct VectorOperand<Vector<Dimension>> { using type = const Vector<Dimension>&; };
+
+
+struct VectorAddOp {
+    static double apply(double lhs, double rhs) noexcept { return lhs + rhs; }
+};
+struct VectorSubOp {
+    static double apply(double lhs, double rhs) noexcept { return lhs - rhs; }
+};
+struct VectorMulOp {
+    static double apply(double lhs, double rhs) noexcept { return lhs * rhs; }
+};
+struct VectorDivOp {
+    static double apply(double lhs, double rhs) noexcept { return lhs / rhs; }
+};
+
+// lhs[i] op rhs[i]
+template <typename Lhs, typename Rhs, typename Op, size_t Dimension>
+class VectorBinaryExpression : public VectorExpression<VectorBinaryExpression<Lhs, Rhs, Op, Dimension>, Dimension> {
+    private:
+        typename VectorOperand<Lhs>::type lhs;
+        typename VectorOperand<Rhs>::type rhs;
+    public:
+        VectorBinaryExpression(const Lhs& arg_lhs, const Rhs& arg_rhs) noexcept
+            : lhs(arg_lhs), rhs(arg_rhs) {}
+
+        double eval(size_t index) const noexcept { return Op::apply(lhs.eval(index), rhs.eval(index)); }
+};
+
+// operand[i] op scalar
+template <typename Operand, typename Op, size_t Dimension>
+class VectorScalarExpression : public VectorExpression<VectorScalarExpression<Operand, Op, Dimension>, Dimension> {
+    private:
+        typename VectorOperand<Operand>::type operand;
+        double scalar;
+    public:
+        VectorScalarExpression(const Operand& arg_operand, double arg_scalar) noexcept
+            : operand(arg_operand), scalar(arg_scalar) {}
+
+        double eval(size_t index) const noexcept { return Op::apply(operand.eval(index), scalar); }
+};
+
+// -operand[i]
+template <typename Operand, size_t Dimension>
+class VectorNegatedExpression : public VectorExpression<VectorNegatedExpression<Operand, Dimension>, Dimension> {
+    private:
+        typename VectorOperand<Operand>::type operand;
+    public:
+        explicit VectorNegatedExpression(const Operand& arg_operand) noexcept
+            : operand(arg_operand) {}
+
+        double eval(size_t index) const noexcept { return -operand.eval(index); }
+};
+
+
+template <typename Lhs, typename Rhs, size_t Dimension>
+VectorBinaryExpression<Lhs, Rhs, VectorAddOp, Dimension> operator+(
+    const VectorExpression<Lhs, Dimension>& lhs, const VectorExpression<Rhs, Dimension>& rhs
+) noexcept {
+    return {lhs.derived(), rhs.derived()};
+}
+
+template <typename Lhs, typename Rhs, size_t Dimension>
+VectorBinaryExpression<Lhs, Rhs, VectorSubOp, Dimension> operator-(
+    const VectorExpression<Lhs, Dimension>& lhs, const VectorExpression<Rhs, Dimension>& rhs
+) noexcept {
+    return {lhs.derived(), rhs.derived()};
+}
+
+template <typename Operand, size_t Dimension>
+VectorScalarExpression<Operand, VectorMulOp, Dimension> operator*(
+    const VectorExpression<Operand, Dimension>& operand, double scalar
+) noexcept {
+    return {operand.derived(), scalar};
+}
+
+template <typename Operand, size_t Dimension>
+VectorScalarExpression<Operand, VectorMulOp, Dimension> operator*(
+    double scalar, const VectorExpression<Operand, Dimension>& operand
+) noexcept {
+    return {operand.derived(), scalar};
+}
+
+template <typename Operand, size_t Dimension>
+VectorScalarExpression<Operand, VectorDivOp, Dimension> operator/(
+    const VectorExpression<Operand, Dimension>& operand, double scalar
+) {
+    if (scalar == 0) {
+        Logger::log_and_throw<ZeroDivisionException>(
+            "class Vector<" + std::to_string(Dimension) + ">::operator/(double scalar) const",
+            "dividing by scalar, scalar cannot be zero"
+        );
+    }
+    return {operand.derived(), scalar};
+}
+
+template <typename Operand, size_t Dimension>
+VectorNegatedExpression<Operand, Dimension> operator-(
+    const VectorExpression<Operand, Dimension>& operand
+) noexcept {
+    return VectorNegatedExpression<Operand, Dimension>(operand.derived());
+}
+
+} // namespace NS_math
+
+#endif // MATH_VECTOR_EXPRESSION_HPP
@@ -9,6 +9,8 @@
 #include <fstream>
 #include <sstream>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
 
 
 #include <SDL3/SDL.h>
@@ -16,6 +18,8 @@
 
 #include "../Utils/StringUtils.hpp"
 #include "../Logger/Logger.hpp"
+#include "../Logger/Metrics.hpp"
+#include "../Logger/Trace.hpp"
 
 
 
@@ -70,14 +74,50 @@ void Game::init(
         renderer = r;
     }
     os = &os_;
+    // a machine that is too slow misses every frame, one warning a second is enough
+    Logger::setLogLimit("Game::run()", Logger::WARNING_LOW, LogLimit{1, 3, 1});
     init_lev(new_lev_id);
 }
+void Game::set_hud_font(TTF_Font* font) {
+    throw_if_init_not_done("set_hud_font(TTF_Font* font)");
+    hud_text = nullptr; // before the atlas it points to
+    hud_atlas = nullptr;
+    if (font == nullptr) {
+        return;
+    }
+    try {
+        hud_atlas = std::make_unique<Display::GlyphAtlas>(renderer, font);
+        hud_text = std::make_unique<Display::TextBatch>(hud_atlas.get());
+    } catch (std::exception& e) {
+        hud_atlas = nullptr;
+        log_and_throw<Logger::SeeAbove>("set_hud_font(TTF_Font* font)", e.what());
+    }
+    const float line_height = hud_atlas->getLineHeight();
+    for (size_t i = 0; i < HUD_NUM_OF_LINES; ++i) {
+        hud_text->addSlot(
+            SDL_FPoint{HUD_MARGIN, HUD_MARGIN + line_height * static_cast<float>(i)}, 
+            SDL_Color{255, 255, 255, 255}, 
+            HUD_LINE_CAPACITY
+        );
+    }
+    // big enough for full lines of the widest glyph
+    float max_advance = 0;
+    for (char c = Display::GlyphAtlas::first_char; c <= Display::GlyphAtlas::last_char; ++c) {
+        max_advance = std::max(max_advance, hud_atlas->getGlyph(c).advance);
+    }
+    const int window_w = static_cast<int>(std::ceil(2 * HUD_MARGIN + max_advance * HUD_LINE_CAPACITY));
+    const int window_h = static_cast<int>(std::ceil(2 * HUD_MARGIN + line_height * HUD_NUM_OF_LINES));
+    if (!SDL_SetWindowSize(window, window_w, window_h)) {
+        log("set_hud_font(TTF_Font* font)", std::string("SDL_SetWindowSize failed: ") + SDL_GetError(), Logger::WARNING_LOW);
+    }
+}
 void Game::init_lev(std::string new_lev_id) {
     if (new_lev_id != "") {
         level = Level::find_level(new_lev_id).get_copy();
     }
     this->num_of_step = 0;
     this->time_used_in_s = 0;
+    this->play_stopwatch.reset();
     this->frame_num = 0;
     this->status = STOP;
     this->stop_reason = GameStopReason::PREPARING;
@@ -106,18 +146,23 @@ GameStopReason Game::get_stop_reason() {
 void Game::run() {
     log("run()", "function started", Logger::INFO);
     display();
-    std::array<int, 3> start_time = {0, 0, 0};
+    render_frame();
     SDL_Event event;
 
-    std::chrono::high_resolution_clock::time_point tmp_start, tmp_end;
+    Utils::Time::Stopwatch frame_stopwatch;
     unsigned int tmp_duration; // in microseconds
+    static MetricCounter& frames_counter = Metrics::counter("game_frames_total", "frames run by Game::run");
+    static MetricCounter& frames_over_budget_counter = Metrics::counter(
+        "game_frames_over_budget_total", "frames that took MICROS_PER_FRAME or longer");
+    static MetricHistogram& frame_duration_histogram = Metrics::histogram(
+        "game_frame_duration_us", "time of a frame before its delay, in microseconds",
+        {1000, 2000, 4000, 8000, 16000, 33000, 66000});
     start_moving();
     while (true) {
-        tmp_start = std::chrono::high_resolution_clock::now();
-        if (this->status != RUNNING) {
-            start_time = Utils::Time::get_current_hour_min_sec();
-        }
+        TRACE_SCOPE("Game::run frame");
+        frame_stopwatch.start();
         if (SDL_PollEvent(&event)) {
+            TRACE_SCOPE("Game::run events");
             if (event.type == SDL_EVENT_QUIT) {
                 return;
             } else if (event.type == SDL_EVENT_KEY_DOWN) {
@@ -150,31 +195,33 @@ void Game::run() {
         
         
         if (status == RUNNING) {
+            TRACE_SCOPE("Game::run update");
             update(player_direction);
-            time_used_in_s = 
-                Utils::Time::time_minus_get_seconds(
-                    Utils::Time::get_current_hour_min_sec(), start_time
-                )
-            ;
+            time_used_in_s = static_cast<unsigned int>(play_stopwatch.elapsed_s());
             ++frame_num;
         }
+        render_frame();
         
-        tmp_end = std::chrono::high_resolution_clock::now();
-        tmp_duration = static_cast<unsigned int>((std::chrono::duration_cast<std::chrono::microseconds>(tmp_end - tmp_start)).count());
+        tmp_duration = static_cast<unsigned int>(frame_stopwatch.elapsed_us());
         
-        log("", std::to_string(frame_num % snake_period_in_frame_per_square == 0) + " " + std::to_string(tmp_duration) + "µs", Logger::DEBUG);
+        logf("Game::run()", Logger::DEBUG, "{} {}µs", frame_num % snake_period_in_frame_per_square == 0, tmp_duration);
+        frames_counter.add();
+        frame_duration_histogram.observe(tmp_duration);
 
         
         if (tmp_duration < MICROS_PER_FRAME) {
+            TRACE_SCOPE("Game::run delay");
             SDL_Delay((MICROS_PER_FRAME - tmp_duration) / 1000);
         } else {
-            log("run()", "tmp_duration >= MICROS_PER_FRAME", Logger::LogLevel::WARNING_LOW);
+            frames_over_budget_counter.add();
+            log("run()", 
+                "frame took " + Utils::Time::format_duration(std::chrono::microseconds(tmp_duration)) 
+                    + ", MICROS_PER_FRAME: " + std::to_string(MICROS_PER_FRAME) + "us", 
+                Logger::LogLevel::WARNING_LOW);
         }
+        Metrics::dumpIfDue();
         
         
-        if (status == STOP) {
-            start_time = Utils::Time::get_current_hour_min_sec();
-        }
         // if (num_of_step == 10) {
         //     Logger::log_and_throw("", "stop");
         // } 
@@ -268,6 +315,8 @@ void Game::move_snake(bool force) {
             game_board_objects->update(snake_direction);
         }
         ++num_of_step;
+        static MetricCounter& ticks_counter = Metrics::counter("snake_ticks_total", "steps the snake moved");
+        ticks_counter.add();
     } catch (std::runtime_error e) {
         log_and_throw<Logger::SeeAbove>("move_snake(bool force)", e.what());
     }
@@ -278,6 +327,7 @@ void Game::move_snake(bool force) {
 
 // private
 void Game::display(int n) const {
+    TRACE_SCOPE("Game::display");
     throw_if_init_not_done("display(int n)");
     
     Matrix<char> display_str_matrix(board_size.y, board_size.x*3, ' ');
@@ -321,8 +371,8 @@ void Game::display(int n) const {
             }
         }
     }
-    (*os) << display_str_matrix.join_into_string("\n", "")
-       << "\n\nlevel: " << level.get_id() 
+    (*os) << display_str_matrix.join_into_string("\n", "");
+    (*os) << "\n\nlevel: " << level.get_id() 
        << "\nsnake_length: " << std::to_string(game_board_objects->get_snake_length())
        << "\nstep_no.: " << std::to_string(this->num_of_step)
        << "\ntime(s): " << std::to_string(this->time_used_in_s)
@@ -330,6 +380,42 @@ void Game::display(int n) const {
     ;
 
 }
+void Game::display_hud() const {
+    TRACE_SCOPE("Game::display_hud");
+    // only the lines whose text changed are laid out again
+    // each line is built in one reused buffer, so a frame allocates no strings here
+    thread_local string_utils_ns::StringWriter line;
+    line.clear();
+    line << "level: " << level.get_id();
+    hud_text->setText(0, line.view());
+    line.clear();
+    line << "snake_length: " << game_board_objects->get_snake_length();
+    hud_text->setText(1, line.view());
+    line.clear();
+    line << "step_no.: " << this->num_of_step;
+    hud_text->setText(2, line.view());
+    line.clear();
+    line << "time(s): " << this->time_used_in_s;
+    hud_text->setText(3, line.view());
+    line.clear();
+    line << "frame_num: " << this->frame_num;
+    hud_text->setText(4, line.view());
+    try {
+        hud_text->draw();
+    } catch (std::exception& e) {
+        log_and_throw<Logger::SeeAbove>("display_hud()", e.what());
+    }
+}
+
+void Game::render_frame() const {
+    TRACE_SCOPE("Game::render_frame");
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    if (hud_text) {
+        display_hud();
+    }
+    SDL_RenderPresent(renderer);
+}
 
 void Game::record(const std::string& message, bool add_timestamp) {
     std::string msg = string_utils_ns::add_indent(message, 4);
@@ -415,12 +501,14 @@ void Game::stop_game(GameStopReason reason) {
     // log("stop_game(GameStopReason reason)", "reason:" + game_stop_reason_to_string(reason), Logger::INFO);
     status = STOP;
     stop_reason = reason;
+    play_stopwatch.pause();
 }
 
 void Game::start_moving() {
     // throw_if_init_not_done("start_run");
     status = RUNNING;
     stop_reason = NOT_STOPPING;
+    play_stopwatch.resume();
 }
 
 void Game::throw_if_init_not_done(const std::string& method_name, const std::string other_info) const {
@@ -434,34 +522,44 @@ void Game::throw_if_init_not_done(const std::string& method_name, const std::str
 }
 
 std::string Game::add_prefix_and_indent_for_log(const std::string& message, bool step_and_snake_pos_prefix) const {
+    return make_log_prefix(step_and_snake_pos_prefix).decorate(message);
+}
+
+GameLogPrefix Game::make_log_prefix(bool step_and_snake_pos_prefix) const {
+    GameLogPrefix prefix {};
+    prefix.step_and_snake_pos_prefix = step_and_snake_pos_prefix;
+    prefix.status = status;
+    prefix.num_of_step = num_of_step;
+    prefix.frame_num = frame_num;
+    prefix.has_snake = (game_board_objects != nullptr && game_board_objects->init_done);
+    if (prefix.has_snake) {
+        const Pos2D& head_pos = game_board_objects->get_snake().head->pos;
+        prefix.snake_head_x = head_pos.x;
+        prefix.snake_head_y = head_pos.y;
+        prefix.snake_length = game_board_objects->get_snake_length();
+    }
+    return prefix;
+}
+
+std::string GameLogPrefix::decorate(const std::string& message) const {
     std::string prefix = "[";
     if (step_and_snake_pos_prefix) {
-        // prefix += 
-        //     "StepNo.:" 
-        //     + std::to_string(num_of_step) 
-        //     + " SnakeHeadPos:" 
-        //     + (
-        //         (game_board_objects == nullptr || !game_board_objects->init_done)? 
-        //          "(game_board_objects have not initialized)" 
-        //         : (game_board_objects->get_snake()->head->pos.to_string(false))
-        //     )
-        // ;
         prefix += 
             "Status:"
-            + game_status_to_string(status)
+            + Game::game_status_to_string(status)
             + " StepNo.:" 
             + std::to_string(num_of_step) 
             + " frame_num:" 
             + std::to_string(frame_num)
             + " SnakeHeadPos:"
         ;
-        if (game_board_objects == nullptr || !game_board_objects->init_done) {
+        if (!has_snake) {
             prefix += "/* game_board_objects have not initialized */";
         } else {
             prefix += 
-                (game_board_objects->get_snake().head->pos.to_string(false)) 
+                "(" + std::to_string(snake_head_x) + ", " + std::to_string(snake_head_y) + ")"
                 + " snake_length:" 
-                + std::to_string(game_board_objects->get_snake_length());
+                + std::to_string(snake_length);
         }
         
     }
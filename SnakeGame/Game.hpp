@@ -15,7 +15,9 @@
 #include <SDL3_ttf/SDL_ttf.h>
 
 #include "../Utils/StringUtils.hpp"
+#include "../Utils/utils.hpp"
 #include "../Math/Math.hpp"
+#include "../App/GlyphAtlas.hpp"
 #include "Size2D.hpp"
 #include "Level.hpp"
 #include "GameBoardObjects.hpp"
@@ -36,6 +38,21 @@ enum GameRunStatus {
     REFRESHING
 };
 
+// what Game puts before a log message, captured by value so that Game::logf can defer it
+struct GameLogPrefix {
+    bool step_and_snake_pos_prefix;
+    GameStatus status;
+    size_t num_of_step;
+    unsigned int frame_num;
+    bool has_snake; // game_board_objects initialized
+    int snake_head_x;
+    int snake_head_y;
+    size_t snake_length;
+
+    // "[Status:... ]\n" + message indented by 2
+    std::string decorate(const std::string& message) const;
+};
+
 class Game {
     private:
         bool init_done = false;
@@ -50,10 +67,18 @@ class Game {
         size_t num_of_step = 0;
         Vector2D snake_direction = Vector2D::get_zero_vector();
         std::unique_ptr<GameBoardObjects> game_board_objects = nullptr;
-        unsigned int time_used_in_s = 0;
+        unsigned int time_used_in_s = 0; // shown in the HUD, from play_stopwatch
+        Utils::Time::Stopwatch play_stopwatch; // runs only while status is RUNNING
 
         unsigned int snake_velocity_in_square_per_ks = 6000; // have to be < frame_rate*1000
 
+        // SDL HUD (level, snake_length, step_no., time, frame_num), printed to os if there is no font
+        std::unique_ptr<Display::GlyphAtlas> hud_atlas = nullptr;
+        std::unique_ptr<Display::TextBatch> hud_text = nullptr; // one slot per line
+        static constexpr size_t HUD_NUM_OF_LINES = 5;
+        static constexpr size_t HUD_LINE_CAPACITY = 32; // in characters
+        static constexpr float HUD_MARGIN = 8.0f; // in pixels, around the HUD lines
+
         unsigned int frame_num = 0;
         const uint8_t FRAME_RATE = 60;
         const NS_math::Fraction MICROS_PER_FRAME_FRACTION {(int)1000000, static_cast<int>(FRAME_RATE)}; // 1000000 microseconds in a second divided by frame rate
@@ -68,11 +93,14 @@ class Game {
         void move_snake(bool force = false);
         void run();
         void display(int n = 0) const;
+        void display_hud() const;
+        void render_frame() const; // clear the window, draw the HUD (if a font is set) and present it
         void record(const std::string& message , bool add_timestamp = true);
         void cliClearScreen() const;
 
         void throw_if_init_not_done(const std::string& method_name = "", const std::string other_info = "") const;
         std::string add_prefix_and_indent_for_log(const std::string& message, bool step_and_snake_pos_prefix) const;
+        GameLogPrefix make_log_prefix(bool step_and_snake_pos_prefix) const;
         
         
     public:
@@ -97,6 +125,10 @@ class Game {
         Game(Game&&) = default; // enable move constructor
 
         void init(SDL_Window* w, SDL_Renderer* r, std::ostream& os_, std::string new_lev_id = "");
+        // draw the HUD with font through a glyph atlas instead of printing it, nullptr to go back to printing
+        // the window is resized to fit the HUD, the HUD is still printed to os as well
+        // caution: must be called after init (it needs the renderer), font can be closed afterwards (main.cpp opens it)
+        void set_hud_font(TTF_Font* font);
         void init_lev(std::string new_lev_id = "");
         void start();
         void restart(std::string new_lev_id = "");
@@ -120,6 +152,12 @@ class Game {
             std::string msg = add_prefix_and_indent_for_log(message, step_and_snake_pos_prefix);
             Logger::log("Game::" + where, msg, lev);
         }
+        // log with the message built on the logger thread (see Logger::logf)
+        // where: the whole call site as a string literal, e.g. "Game::run()"
+        template <typename... Args>
+        void logf(const char* where, Logger::LogLevel lev, const char* fmt, const Args&... args) const {
+            Logger::logfDecorated(where, lev, make_log_prefix(true), fmt, args...);
+        }
         template <typename ExceptionType>
         [[noreturn]] void log_and_throw(const std::string& where, const std::string& message, bool step_and_snake_pos_prefix = true) const {
             
@@ -10,6 +10,8 @@
 
 #include "../Utils/utils.hpp"
 #include "../Logger/Logger.hpp"
+#include "../Logger/Metrics.hpp"
+#include "../Logger/Trace.hpp"
 #include "Vector2D.hpp"
 #include "Pos2D.hpp"
 #include "Size2D.hpp"
@@ -19,6 +21,16 @@
 #include "Snake.hpp"
 
 #include "Game.hpp"
+
+namespace { // Anonymous namespace for private functions
+
+MetricGauge& snakeLengthGauge() {
+    static MetricGauge& gauge = Metrics::gauge("snake_length", "segments of the snake");
+    return gauge;
+}
+
+} // Anonymous namespace end
+
 // --public:
 
 GameBoardObjects::GameBoardObjects(Game* arg_related_game)
@@ -26,7 +38,8 @@ GameBoardObjects::GameBoardObjects(Game* arg_related_game)
       snake(nullptr), 
       apples(), 
       walls(), 
-      empty_poses() {
+      empty_poses(),
+      empty_poses_fingerprint() {
 }
 
 
@@ -99,13 +112,15 @@ void GameBoardObjects::init() {
             + std::to_string(walls.size()) + " walls.", 
         Logger::INFO);
 
+    snakeLengthGauge().set(static_cast<double>(snake_length));
     init_done = true;
 }
 
 void GameBoardObjects::update(Vector2D next_snake_direction) {
-    log(
-        "update(Vector2D next_snake_direction)", 
-        + ", next_snake_direction:" + next_snake_direction.to_string(), Logger::INFO);
+    TRACE_SCOPE("GameBoardObjects::update");
+    related_game->logf(
+        "Game::GameBoardObjects::update(Vector2D next_snake_direction)", Logger::INFO,
+        "next_snake_direction:Vector2D({}, {})", next_snake_direction.x, next_snake_direction.y);
     throw_if_init_not_done("update");
     
     if (snake->snake_segments.size() > 1 && next_snake_direction.is_opposite_direction_with(snake->get_direction(), false)) {
@@ -116,6 +131,8 @@ void GameBoardObjects::update(Vector2D next_snake_direction) {
     // check collision with apples
     for (Apple &apple : apples) {
         if (snake->head->pos == apple.pos) {
+            static MetricCounter& apples_eaten_counter = Metrics::counter("apples_eaten_total", "apples the snake ate");
+            apples_eaten_counter.add();
             snake_grow();
             if (!empty_poses.empty()) {
                 apple_randomize_pos(apple, true);
@@ -144,19 +161,22 @@ void GameBoardObjects::update(Vector2D next_snake_direction) {
 }
 
 void GameBoardObjects::force_update(const Vector2D& next_snake_direction) {
+    TRACE_SCOPE("GameBoardObjects::force_update");
     log("force_update(const Vector2D& next_snake_direction)", 
         "next_snake_direction: " + next_snake_direction.to_string(), 
         Logger::INFO);
     update(next_snake_direction);
     Matrix<int> tmp_board = related_game->board2d;
     std::vector<Pos2D> tmp_empty_poses = empty_poses;
+    const Utils::Vector::MultisetFingerprint<Pos2D> tmp_empty_poses_fingerprint = empty_poses_fingerprint;
     update_board();
     update_empty_poses();
     if (tmp_board != related_game->board2d) {
         log("force_update", "update does not update board correctly\n-board from manual update: " + tmp_board.to_string() + "\nboard from objs" + related_game->board2d.to_string(), Logger::WARNING_HIGH);
         log("force_update", "board updated", Logger::INFO);
     }
-    if (!Utils::Vector::have_same_elements(tmp_empty_poses, empty_poses)) {
+    // O(1): std::hash<Pos2D> has no collisions, so equal fingerprints are trusted (see MultisetFingerprint)
+    if (tmp_empty_poses_fingerprint != empty_poses_fingerprint) {
         log("force_update", "update does not update empty_poses correctly\n-empty_poses from manual update: " + Pos2D::vector_to_string(tmp_empty_poses) + "\n-empty_poses from board        : " + Pos2D::vector_to_string(empty_poses), Logger::WARNING_HIGH);
         log("force_update", "empty_poses updated", Logger::INFO);
     }
@@ -213,6 +233,7 @@ void GameBoardObjects::throw_if_init_not_done(const std::string& method_name, co
  *   MyException if tmp_board is not nullptr and its size does not match related_board.
  */
 void GameBoardObjects::update_board(Matrix<int>* tmp_board) {
+    TRACE_SCOPE("GameBoardObjects::update_board");
     log("update_board(Matrix<int>* tmp_board)", 
         "updating with tmp_board:" 
             + ((tmp_board == nullptr)? "null" : "\n" + string_utils_ns::add_indent(tmp_board->to_string(), 2)), 
@@ -251,9 +272,10 @@ void GameBoardObjects::update_board(Matrix<int>* tmp_board) {
 
 // snake
 void GameBoardObjects::snake_move(const Vector2D& next_snake_direction) {
-    log("snake_move(const Vector2D& next_snake_direction)", 
-        "next_snake_direction:"+next_snake_direction.to_string(), 
-        Logger::INFO);
+    TRACE_SCOPE("GameBoardObjects::snake_move");
+    related_game->logf(
+        "Game::GameBoardObjects::snake_move(const Vector2D& next_snake_direction)", Logger::INFO,
+        "next_snake_direction:Vector2D({}, {})", next_snake_direction.x, next_snake_direction.y);
     throw_if_init_not_done("snake_move(const Vector2D& next_snake_direction");
     // save old_head temporarily
     SnakeSeg* old_head = snake->head;
@@ -276,7 +298,7 @@ void GameBoardObjects::snake_move(const Vector2D& next_snake_direction) {
             Logger::INFO
         );
     } else {
-        (*it) = snake->previous_tail->pos;
+        empty_poses_replace(it, snake->previous_tail->pos);
     }
 
     // Update board
@@ -290,7 +312,8 @@ void GameBoardObjects::snake_move(const Vector2D& next_snake_direction) {
 }
 
 void GameBoardObjects::snake_grow() {
-    log("snake_grow()", "function start", Logger::INFO);
+    TRACE_SCOPE("GameBoardObjects::snake_grow");
+    related_game->logf("Game::GameBoardObjects::snake_grow()", Logger::INFO, "function start");
     throw_if_init_not_done("snake_grow");
     // Update snake positions
     snake->snake_grow();
@@ -302,13 +325,17 @@ void GameBoardObjects::snake_grow() {
     related_game->board2d[new_tail.pos.y][new_tail.pos.x] = SnakeSeg::body_representing_num;
     // update length
     snake_length++;
+    snakeLengthGauge().set(static_cast<double>(snake_length));
 }
 
 // apple
 
 // private
 void GameBoardObjects::apple_randomize_pos(Apple &apple, bool eaten_by_snake) {
-    log("apple_randomize_pos", "apple_original_pos:"+apple.pos.to_string()+" eaten_by_snake:"+std::to_string(eaten_by_snake), Logger::INFO);
+    TRACE_SCOPE("GameBoardObjects::apple_randomize_pos");
+    related_game->logf(
+        "Game::GameBoardObjects::apple_randomize_pos", Logger::INFO,
+        "apple_original_pos:Pos2D({}, {}) eaten_by_snake:{}", apple.pos.x, apple.pos.y, eaten_by_snake);
     Pos2D tmp = apple.pos;
     // update_apple_pos
     apple.pos = empty_poses[rand() % empty_poses.size()];
@@ -326,7 +353,7 @@ void GameBoardObjects::apple_randomize_pos(Apple &apple, bool eaten_by_snake) {
         related_game->board2d[tmp.y][tmp.x] = SnakeSeg::head_representing_num;
     } else {
         // update_empty_poses();
-        empty_poses.emplace_back(tmp);
+        empty_poses_add(tmp);
         // update board
         related_game->board2d[tmp.y][tmp.x] = 0;
     }
@@ -342,6 +369,7 @@ void GameBoardObjects::apple_randomize_pos(Apple &apple, bool eaten_by_snake) {
 
 // private
 void  GameBoardObjects::update_empty_poses(Pos2D* top_left_of_range, Size2D* size_of_range) {
+    TRACE_SCOPE("GameBoardObjects::update_empty_poses");
     
     Pos2D default_top_left(0, 0);
     Size2D default_size(related_game->board_size.x, related_game->board_size.y);
@@ -351,6 +379,7 @@ void  GameBoardObjects::update_empty_poses(Pos2D* top_left_of_range, Size2D* siz
         top_left_of_range = &default_top_left;
         size_of_range = &default_size;
         empty_poses.clear();
+        empty_poses_fingerprint.clear();
     } else if (top_left_of_range == nullptr || size_of_range == nullptr) {
         log_and_throw<std::invalid_argument>("update_empty_poses(Pos2D* top_left_of_range, Size2D* size_of_range)", "top_left_of_range and size_of_range should be null tgt or not null tgt");
     } else {
@@ -374,7 +403,7 @@ void  GameBoardObjects::update_empty_poses(Pos2D* top_left_of_range, Size2D* siz
         for (int c = top_left_of_range->x; c < top_left_of_range->x+size_of_range->x; ++c) {
             bool found = empty_poses_find(Pos2D(c, r)) != empty_poses.end();
             if (related_game->board2d[r][c] == 0 && !found) {
-                empty_poses.emplace_back(Pos2D(c, r));
+                empty_poses_add(Pos2D(c, r));
             } else if (related_game->board2d[r][c] != 0 && found) {
                 poses_to_remove.emplace_back(Pos2D(c, r));
             }
@@ -384,6 +413,21 @@ void  GameBoardObjects::update_empty_poses(Pos2D* top_left_of_range, Size2D* siz
     related_game->log("update_empty_poses(Pos2D* top_left_of_range, Size2D* size_of_range)", "updated", Logger::INFO);
 }
 
+// private
+// empty_poses is only changed through empty_poses_add/replace/remove (and cleared in update_empty_poses),
+// which keep empty_poses_fingerprint in step
+void GameBoardObjects::empty_poses_add(const Pos2D& pos_to_add) {
+    empty_poses.emplace_back(pos_to_add);
+    empty_poses_fingerprint.add(pos_to_add);
+}
+
+// private
+void GameBoardObjects::empty_poses_replace(std::vector<Pos2D>::iterator it, const Pos2D& new_pos) {
+    empty_poses_fingerprint.remove(*it);
+    *it = new_pos;
+    empty_poses_fingerprint.add(new_pos);
+}
+
 // private
 std::vector<Pos2D>::iterator GameBoardObjects::empty_poses_find(Pos2D pos) {
     return std::find(empty_poses.begin(), empty_poses.end(), pos);
@@ -391,13 +435,14 @@ std::vector<Pos2D>::iterator GameBoardObjects::empty_poses_find(Pos2D pos) {
 
 // private
 std::vector<Pos2D>::iterator GameBoardObjects::empty_poses_remove(const Pos2D &pos_to_remove) {
-    related_game->log(
-        "empty_poses_remove(const Pos2D &pos_to_remove)", 
-        "pos_to_remove: "+pos_to_remove.to_string(), 
-        Logger::INFO);
+    TRACE_SCOPE("GameBoardObjects::empty_poses_remove");
+    related_game->logf(
+        "Game::empty_poses_remove(const Pos2D &pos_to_remove)", Logger::INFO,
+        "pos_to_remove: Pos2D({}, {})", pos_to_remove.x, pos_to_remove.y);
     auto it = empty_poses.begin();
     for (; it != empty_poses.end(); ++it) {
         if (*it == pos_to_remove) {
+            empty_poses_fingerprint.remove(*it);
             return empty_poses.erase(it);
         }
     }
@@ -406,6 +451,7 @@ std::vector<Pos2D>::iterator GameBoardObjects::empty_poses_remove(const Pos2D &p
 
 // private
 std::vector<Pos2D> GameBoardObjects::empty_poses_remove(std::vector<Pos2D> poses_to_remove) {
+    TRACE_SCOPE("GameBoardObjects::empty_poses_remove");
     log("empty_poses_remove(std::vector<Pos2D> poses_to_remove)", 
         "poses_to_remove: "+Pos2D::vector_to_string(poses_to_remove), 
         Logger::INFO
@@ -416,6 +462,7 @@ std::vector<Pos2D> GameBoardObjects::empty_poses_remove(std::vector<Pos2D> poses
         erased = false;
         for (auto jt = poses_to_remove.begin(); jt != poses_to_remove.end(); ++jt) {
             if (*it == *jt) {
+                empty_poses_fingerprint.remove(*it);
                 it = empty_poses.erase(it);
                 poses_to_remove.erase(jt);  // after this line, jt is invalidated
                 // since we are going to break the inner loop
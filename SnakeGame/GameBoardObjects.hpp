@@ -28,6 +28,8 @@ class GameBoardObjects {
     std::vector<Apple> apples;
     std::vector<Wall> walls;
     std::vector<Pos2D> empty_poses;
+    // kept in step with every change of empty_poses, tells most mismatches apart in O(1)
+    Utils::Vector::MultisetFingerprint<Pos2D> empty_poses_fingerprint;
     //std::vector<GameBoardObject_Empty> empties;
 
     size_t snake_length = 1;
@@ -45,6 +47,8 @@ class GameBoardObjects {
     
     // empty_poses
     void update_empty_poses(Pos2D* top_left_of_range = nullptr, Size2D* size_of_range = nullptr);
+    void empty_poses_add(const Pos2D& pos_to_add);
+    void empty_poses_replace(std::vector<Pos2D>::iterator it, const Pos2D& new_pos);
     std::vector<Pos2D>::iterator empty_poses_find(Pos2D pos);
     std::vector<Pos2D>::iterator empty_poses_remove(const Pos2D &pos_to_remove);
     std::vector<Pos2D> empty_poses_remove(std::vector<Pos2D> poses_to_remove);
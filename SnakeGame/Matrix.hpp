@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <exception>
+#include <string_view>
+
+#include "../Utils/StringUtils.hpp"
 
 
 
@@ -94,22 +97,21 @@ class Matrix {
         inline const std::vector<T>& operator[](size_t row) const noexcept {
             return data[row];
         }
-        inline std::string join_into_string(std::string line_sep = "\n", std::string elem_sep = ", ") const {
-            std::string return_str = "";
-            for (int r = 0; r < num_of_row; ++r) {
-                for (int c = 0; c < num_of_col; ++c) {
-                    if (std::is_same<T, char>::value) {
-                        return_str += std::string(1, data[r][c]);
-                    } else {
-                        return_str += std::to_string(data[r][c]);
+        inline std::string join_into_string(std::string_view line_sep = "\n", std::string_view elem_sep = ", ") const {
+            string_utils_ns::StringWriter writer;
+            join_into(writer, line_sep, elem_sep);
+            return writer.str();
+        }
+        inline void join_into(string_utils_ns::StringWriter& out, std::string_view line_sep = "\n", std::string_view elem_sep = ", ") const {
+            for (size_t r = 0; r < num_of_row; ++r) {
+                for (size_t c = 0; c < num_of_col; ++c) {
+                    out << static_cast<T>(data[r][c]); // char as itself, numbers as std::to_string
+                    if (c != num_of_col-1) {
+                        out << elem_sep;
                     }
-                    return_str += ((c == num_of_col-1)? "" : elem_sep);
-                }
-                if (r < num_of_row) {
-                    return_str += line_sep;
                 }
+                out << line_sep;
             }
-            return return_str;
         }
         inline std::string to_string(std::string prefix = "") const {
             std::string return_val = "Matrix(\n";
@@ -141,7 +143,7 @@ class Matrix {
         }
 
         inline auto size() const noexcept { //return type: std::vector<std::vector<T>>::size_type
-            return num_of_row
+            return num_of_row;
         }
 
         inline bool operator==(const Matrix<T>& other) const {
@@ -39,20 +39,28 @@ Pos2D& Pos2D::operator=(const Vector2D& vect) noexcept {
 
 
 std::string Pos2D::to_string(bool with_prefix) const {
-    return (((with_prefix)? ("Pos2D(") : ("(")) + std::to_string(x) + ", " + std::to_string(y) + ")");
+    string_utils_ns::StringWriter writer;
+    write_to(writer, with_prefix);
+    return writer.str();
+}
 
+void Pos2D::write_to(string_utils_ns::StringWriter& out, bool with_prefix) const {
+    out << ((with_prefix)? "Pos2D(" : "(") << x << ", " << y << ')';
 }
 
 
 std::string Pos2D::vector_to_string(const std::vector<Pos2D>& vect, bool with_prefix) {
-    std::string return_str = ((with_prefix)? ("vector<Pos2D>[") : ("[")); 
+    string_utils_ns::StringWriter writer;
+    writer << ((with_prefix)? "vector<Pos2D>[" : "[");
     if (vect.empty()) {
-        return return_str+"-empty-]";
+        writer << "-empty-]";
+        return writer.str();
     }
     for (size_t i = 0; i < vect.size(); ++i) {
-        return_str += vect[i].to_string(false) + ((i == vect.size()-1)? "]" : ", ");
+        vect[i].write_to(writer, false);
+        writer << ((i == vect.size()-1)? "]" : ", ");
     }
-    return return_str;
+    return writer.str();
 }
 
 
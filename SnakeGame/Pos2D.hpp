@@ -2,7 +2,9 @@
 #define POS2D_HPP
 
 #include "Vector2D.hpp"
+#include "../Utils/StringUtils.hpp"
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -24,6 +26,7 @@ class Pos2D: public Vector2D {
 
         // other methods
         std::string to_string(bool with_prefix = true) const;
+        void write_to(string_utils_ns::StringWriter& out, bool with_prefix = true) const;
         static std::string vector_to_string(const std::vector<Pos2D>& vect, bool with_prefix = true);
         const std::pair<int, int> get_as_pair() const;
 
@@ -71,7 +74,13 @@ namespace std {
     template <>
     struct hash<Pos2D> {
         std::size_t operator()(const Pos2D& p) const noexcept {
-            return std::hash<int>()(p.x) ^ (std::hash<int>()(p.y) << 1);
+            // x ^ (y << 1) made e.g. (2, 0) and (0, 1) collide, which slowed down hash containers of board poses
+            // both coordinates packed, then scrambled by bijective steps: no two poses collide with a 64-bit size_t
+            // (MultisetFingerprint<Pos2D> relies on that)
+            uint64_t h = (static_cast<uint64_t>(static_cast<uint32_t>(p.x)) << 32) | static_cast<uint32_t>(p.y);
+            h *= 0x9e3779b97f4a7c15ULL;
+            h ^= h >> 32;
+            return static_cast<std::size_t>(h);
         }
     };
 }
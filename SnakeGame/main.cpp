@@ -3,11 +3,15 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_timer.h>
+#include <SDL3_ttf/SDL_ttf.h>
 
 #include "../Logger/Logger.hpp"
+#include "../Logger/FlightRecorder.hpp"
+#include "../Logger/Trace.hpp"
 #include "../Utils/utils.hpp"
 #include "../Math/Fraction.hpp"
 #include "Vector2D.hpp"
@@ -35,9 +39,41 @@ int frame_num = 0;
 SDL_Window* window;
 SDL_Renderer* renderer;
 
+const float HUD_FONT_SIZE = 16.0f;
+// tried in order after $SNAKE_HUD_FONT, the first one that opens is used
+const std::vector<std::string> HUD_FONT_PATHS = {
+    "assets/fonts/hud.ttf",
+    "C:/Windows/Fonts/consola.ttf",
+    "/System/Library/Fonts/Menlo.ttc",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf",
+    "/usr/share/fonts/TTF/DejaVuSansMono.ttf",
+    "/usr/share/fonts/dejavu-sans-mono-fonts/DejaVuSansMono.ttf"
+};
+
+// nullptr if SDL_ttf or every font failed, the HUD is then only printed as text
+TTF_Font* open_hud_font() {
+    if (!TTF_Init()) {
+        Logger::log("open_hud_font()", std::string("TTF_Init failed: ") + SDL_GetError(), Logger::WARNING_LOW);
+        return nullptr;
+    }
+    std::vector<std::string> paths;
+    if (const char* env_path = std::getenv("SNAKE_HUD_FONT")) {
+        paths.push_back(env_path);
+    }
+    paths.insert(paths.end(), HUD_FONT_PATHS.begin(), HUD_FONT_PATHS.end());
+    for (const std::string& path : paths) {
+        if (TTF_Font* font = TTF_OpenFont(path.c_str(), HUD_FONT_SIZE)) {
+            Logger::log("open_hud_font()", "using " + path, Logger::INFO);
+            return font;
+        }
+    }
+    Logger::log("open_hud_font()", "no HUD font found (set SNAKE_HUD_FONT), the HUD is only printed as text", Logger::WARNING_LOW);
+    return nullptr;
+}
+
 int main_func() {
     
-    SDL_CreateWindowAndRenderer("Snake", 100, 100, NULL, &window, &renderer);
+    SDL_CreateWindowAndRenderer("Snake", 100, 100, NULL, &window, &renderer); // set_hud_font resizes it to fit the HUD
     
     srand(1);
     levels::init_testing_levels();
@@ -50,7 +86,16 @@ int main_func() {
     const Level& lev = Level::find_level(lev_id);
     Game game(lev);
     game.init(window, renderer, std::cout);
+    if (TTF_Font* hud_font = open_hud_font()) {
+        try {
+            game.set_hud_font(hud_font);
+        } catch (std::exception& e) {
+            Logger::log("main_func()", std::string("HUD font not usable, the HUD is only printed as text\n") + e.what(), Logger::WARNING_LOW);
+        }
+        TTF_CloseFont(hud_font); // the atlas is rasterized in set_hud_font
+    }
     game.start();
+    TTF_Quit();
     
     // Logger::log_and_throw("", "");
     // Utils::clear_terminal();
@@ -99,10 +144,21 @@ int main_func() {
     return 0;
 }
 int main() {
+    FlightRecorder::installCrashHandlers();
+#ifdef SNAKE_ENABLE_TRACING
+    Trace::setThreadName("main");
+    Trace::start();
+#endif
     try {
         main_func();
     } catch (std::exception& e) {
         Logger::logAndThrow<Logger::SeeAbove>("main", e.what());
     }
+#ifdef SNAKE_ENABLE_TRACING
+    Trace::stop();
+    if (!Trace::writeChromeJson("logs/trace.json")) {
+        Logger::log("main", "could not write logs/trace.json", Logger::WARNING_LOW);
+    }
+#endif
 }
 
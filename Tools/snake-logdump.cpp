@@ -0,0 +1,91 @@
+// snake-logdump: prints .binlog files (Logger::LogFormat::Binary) as the text log would have them
+// usage: snake-logdump <file.binlog>...
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../Logger/BinaryLogFormat.hpp"
+#include "../Logger/Logger.hpp"
+
+namespace { // Anonymous namespace for private functions
+
+std::tm toLocalTime(int64_t unix_time_ns) {
+    const std::time_t seconds = static_cast<std::time_t>(unix_time_ns / 1000000000);
+    std::tm local_time;
+#ifdef _MSC_VER
+    localtime_s(&local_time, &seconds);
+#else
+    localtime_r(&seconds, &local_time);
+#endif
+    return local_time;
+}
+
+// returns false if the file is not a binary log or ends in the middle of a record
+bool dumpFile(const std::string& path, std::ostream& out) {
+    std::ifstream file(path, std::ios_base::binary);
+    if (!file.is_open()) {
+        std::cerr << "snake-logdump: cannot open " << path << std::endl;
+        return false;
+    }
+    std::string magic(binary_log_ns::MAGIC.size(), '\0');
+    if (!file.read(magic.data(), static_cast<std::streamsize>(magic.size())) || magic != binary_log_ns::MAGIC) {
+        std::cerr << "snake-logdump: " << path << " is not a binary log" << std::endl;
+        return false;
+    }
+
+    std::unordered_map<uint32_t, std::string> sites;
+    unsigned char header_bytes[binary_log_ns::HEADER_SIZE];
+    std::string payload;
+    while (file.read(reinterpret_cast<char*>(header_bytes), binary_log_ns::HEADER_SIZE)) {
+        const binary_log_ns::RecordHeader header = binary_log_ns::decodeHeader(header_bytes);
+        payload.resize(header.payload_size);
+        if (!file.read(payload.data(), static_cast<std::streamsize>(payload.size()))) {
+            std::cerr << "snake-logdump: " << path << " is truncated" << std::endl;
+            return false;
+        }
+        switch (header.kind) {
+            case binary_log_ns::RecordKind::SiteDefinition:
+                sites[header.site_id] = payload;
+                break;
+            case binary_log_ns::RecordKind::Entry: {
+                auto site = sites.find(header.site_id);
+                const std::string where = (site != sites.end())
+                    ? site->second
+                    : "<unknown site " + std::to_string(header.site_id) + ">";
+                out << Logger::formatTextEntry(
+                    toLocalTime(header.unix_time_ns),
+                    where,
+                    payload,
+                    static_cast<Logger::LogLevel>(header.level),
+                    (header.flags & binary_log_ns::FLAG_HAS_TIMESTAMP) != 0
+                ) << "\n";
+                break;
+            }
+            default:
+                std::cerr << "snake-logdump: " << path << ": unknown record kind "
+                    << static_cast<int>(header.kind) << ", skipped" << std::endl;
+                break;
+        }
+    }
+    return file.eof() && file.gcount() == 0;
+}
+
+} // Anonymous namespace end
+
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: snake-logdump <file.binlog>..." << std::endl;
+        return 2;
+    }
+    bool is_ok = true;
+    for (int i = 1; i < argc; ++i) {
+        is_ok = dumpFile(argv[i], std::cout) && is_ok;
+    }
+    return is_ok ? 0 : 1;
+}
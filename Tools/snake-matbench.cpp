@@ -0,0 +1,135 @@
+// snake-matbench: times matrix_kernels::mulFixed (behind Matrix::mul and SquareMatrix::operator*)
+// against the bounds-checked triple loop Matrix::mul had before
+// usage: snake-matbench [seconds per size, default 0.2]
+// build it optimized (e.g. -DCMAKE_BUILD_TYPE=Release), the numbers mean nothing at -O0
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../Math/MatrixKernels.hpp"
+#include "../Utils/utils.hpp"
+
+namespace { // Anonymous namespace for private functions
+
+template <size_t RowN, size_t ColN>
+using Matrix = std::array<std::array<double, ColN>, RowN>; // the data of NS_math::Matrix
+
+constexpr size_t NUM_OF_OPERANDS = 16; // products cycle through these so nothing is hoisted out of the loop
+
+// the loop Matrix::mul had: i-j-k, b and the result through a bounds-checked row access
+template <size_t M, size_t K, size_t N>
+Matrix<M, N> referenceMul(const Matrix<M, K>& a, const Matrix<K, N>& b) {
+    Matrix<M, N> result;
+    double tmp;
+    for (size_t rr = 0; rr < M; ++rr) {
+        for (size_t rc = 0; rc < N; ++rc) {
+            tmp = 0;
+            for (size_t i = 0; i < K; ++i) {
+                tmp += a[rr][i] * b.at(i)[rc];
+            }
+            result.at(rr)[rc] = tmp;
+        }
+    }
+    return result;
+}
+
+template <size_t M, size_t K, size_t N>
+Matrix<M, N> kernelMul(const Matrix<M, K>& a, const Matrix<K, N>& b) {
+    Matrix<M, N> result;
+    NS_math::matrix_kernels::mulFixed<M, K, N>(a, b, result);
+    return result;
+}
+
+template <size_t N>
+std::array<Matrix<N, N>, NUM_OF_OPERANDS> randomOperands(std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::array<Matrix<N, N>, NUM_OF_OPERANDS> operands;
+    for (Matrix<N, N>& mat : operands) {
+        for (std::array<double, N>& row : mat) {
+            for (double& elem : row) {
+                elem = dist(rng);
+            }
+        }
+    }
+    return operands;
+}
+
+// ns per product, mul(a, b) is called until seconds have passed
+template <size_t N, typename MulFn>
+double helperTimePerMul(const std::array<Matrix<N, N>, NUM_OF_OPERANDS>& operands, double seconds, MulFn mul, double& checksum) {
+    size_t num_of_muls = 0;
+    size_t batch = 64;
+    Utils::Time::Stopwatch stopwatch(true);
+    while (stopwatch.elapsed_s() < seconds) {
+        for (size_t i = 0; i < batch; ++i) {
+            const Matrix<N, N> product = mul(
+                operands[i % NUM_OF_OPERANDS], operands[(i * 7 + 3) % NUM_OF_OPERANDS]
+            );
+            checksum += product[i % N][(i / N) % N];
+        }
+        num_of_muls += batch;
+        batch = std::min<size_t>(batch * 2, 1 << 20);
+    }
+    return stopwatch.elapsed_s() * 1e9 / static_cast<double>(num_of_muls);
+}
+
+template <size_t N>
+void benchSize(std::mt19937_64& rng, double seconds) {
+    const std::array<Matrix<N, N>, NUM_OF_OPERANDS> operands = randomOperands<N>(rng);
+
+    double max_diff = 0;
+    for (size_t i = 0; i < NUM_OF_OPERANDS; ++i) {
+        const Matrix<N, N>& a = operands[i];
+        const Matrix<N, N>& b = operands[(i + 1) % NUM_OF_OPERANDS];
+        const Matrix<N, N> expected = referenceMul(a, b);
+        const Matrix<N, N> actual = kernelMul(a, b);
+        for (size_t r = 0; r < N; ++r) {
+            for (size_t c = 0; c < N; ++c) {
+                max_diff = std::max(max_diff, std::abs(expected[r][c] - actual[r][c]));
+            }
+        }
+    }
+
+    double checksum = 0;
+    const double reference_ns = helperTimePerMul<N>(operands, seconds,
+        [](const Matrix<N, N>& a, const Matrix<N, N>& b) { return referenceMul(a, b); }, checksum);
+    const double kernel_ns = helperTimePerMul<N>(operands, seconds,
+        [](const Matrix<N, N>& a, const Matrix<N, N>& b) { return kernelMul(a, b); }, checksum);
+
+    std::cout << std::setw(5) << (std::to_string(N) + "x" + std::to_string(N))
+        << std::fixed << std::setprecision(1)
+        << std::setw(14) << reference_ns
+        << std::setw(14) << kernel_ns
+        << std::setw(10) << std::setprecision(2) << reference_ns / kernel_ns << "x"
+        << std::setw(12) << std::scientific << std::setprecision(1) << max_diff
+        << std::defaultfloat
+        << (checksum == 12345.678 ? " " : "") // keeps the products alive
+        << std::endl;
+}
+
+} // Anonymous namespace end
+
+
+int main(int argc, char* argv[]) {
+    const double seconds = (argc > 1) ? std::atof(argv[1]) : 0.2;
+    if (!(seconds > 0)) {
+        std::cerr << "usage: snake-matbench [seconds per size, > 0]" << std::endl;
+        return 1;
+    }
+    std::mt19937_64 rng(1);
+    std::cout << " size  reference ns     mulFixed ns   speedup    max diff" << std::endl;
+    benchSize<2>(rng, seconds);
+    benchSize<3>(rng, seconds);
+    benchSize<4>(rng, seconds);
+    benchSize<8>(rng, seconds);
+    benchSize<16>(rng, seconds);
+    benchSize<32>(rng, seconds);
+    return 0;
+}
@@ -1,9 +1,25 @@
 #include "StringUtils.hpp"
 #include <stdint.h>
 #include <stddef.h>
+#include <cstring>
 
 namespace string_utils_ns {
 
+void StringWriter::reserve(size_t new_capacity) {
+    if (new_capacity <= capacity) {
+        return;
+    }
+    size_t grown_capacity = capacity * 2;
+    while (grown_capacity < new_capacity) {
+        grown_capacity *= 2;
+    }
+    std::unique_ptr<char[]> new_buffer(new char[grown_capacity]);
+    std::memcpy(new_buffer.get(), data_ptr, length);
+    heap_buffer = std::move(new_buffer);
+    data_ptr = heap_buffer.get();
+    capacity = grown_capacity;
+}
+
 int convertPtrToStringX64(const void* ptr, char* return_str) {
     uintptr_t ptr_val = (uintptr_t)ptr;
     return_str[0] = '0';
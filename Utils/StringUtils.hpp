@@ -1,14 +1,87 @@
 #ifndef STRING_UTILS_HPP
 #define STRING_UTILS_HPP
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
 
 namespace string_utils_ns {
+    /*
+    append buffer for building text without temporaries
+      - the first INLINE_CAPACITY chars live in the object, then one heap buffer that doubles
+        (clear() keeps it, so a reused writer stops allocating)
+      - numbers are written with std::to_chars, floating point as std::to_string does ("%f")
+      - setIndent(n): every line started after that (and the current one if it is still empty)
+        begins with n indent chars, as add_indent would give
+    not copyable, view() is valid until the next append
+    */
+    class StringWriter {
+    public:
+        static constexpr size_t INLINE_CAPACITY = 512;
+
+        StringWriter() noexcept = default;
+        StringWriter(const StringWriter&) = delete;
+        StringWriter& operator=(const StringWriter&) = delete;
+
+        StringWriter& append(std::string_view text);
+        StringWriter& append(char c);
+        StringWriter& append(size_t count, char c);
+        template <typename NumberT, std::enable_if_t<std::is_arithmetic_v<NumberT>, int> = 0>
+        StringWriter& appendNumber(NumberT value);
+
+        StringWriter& operator<<(std::string_view text) { return append(text); }
+        StringWriter& operator<<(const char* text) { return append(std::string_view(text)); }
+        StringWriter& operator<<(const std::string& text) { return append(std::string_view(text)); }
+        StringWriter& operator<<(char c) { return append(c); }
+        template <typename NumberT, std::enable_if_t<std::is_arithmetic_v<NumberT> && !std::is_same_v<NumberT, char>, int> = 0>
+        StringWriter& operator<<(NumberT value) { return appendNumber(value); }
+
+        // indent lines from here on, 0 to stop
+        void setIndent(size_t new_indent_num, char new_indent_char = ' ');
+
+        std::string_view view() const noexcept { return std::string_view(data_ptr, length); }
+        std::string str() const { return std::string(data_ptr, length); }
+        size_t size() const noexcept { return length; }
+        bool empty() const noexcept { return length == 0; }
+        void clear() noexcept;
+        void reserve(size_t new_capacity);
+
+    private:
+        char inline_buffer[INLINE_CAPACITY];
+        std::unique_ptr<char[]> heap_buffer;
+        char* data_ptr = inline_buffer;
+        size_t length = 0;
+        size_t capacity = INLINE_CAPACITY;
+
+        size_t indent_num = 0;
+        char indent_char = ' ';
+
+        // room for `extra` more chars after length
+        void helperReserveExtra(size_t extra) {
+            if (extra > capacity - length) {
+                reserve(length + extra);
+            }
+        }
+        void helperAppendRaw(const char* text, size_t count);
+        void helperAppendIndent();
+        bool helperIsLineStart() const noexcept { return length == 0 || data_ptr[length - 1] == '\n'; }
+    };
+
+    // add_indent(txt, ...) written into out
+    void add_indent(
+        StringWriter& out,
+        std::string_view txt,
+        size_t indent_num,
+        bool add_in_first_line_too = true,
+        char indent_char = ' '
+    );
+
     std::string add_indent(
         std::string_view txt, 
         const size_t& indent_num, 
@@ -25,6 +98,7 @@ namespace string_utils_ns {
     template <typename ExceptionType>
     std::string common_exceptions_to_string();
 
+    // elements by their write_to(StringWriter&, bool with_prefix) if they have one, else to_string(false)
     template <typename T>
     std::string to_string(const std::vector<T>& vect, bool with_prefix = true);
     
@@ -33,8 +107,11 @@ namespace string_utils_ns {
 
     int convertPtrToStringX64(const void* ptr, char* return_str);
 
-    template <typename IteratorT, typename ConverterT = std::function<std::string(decltype(*std::declval<IteratorT>()))>>
-    std::string iterableToStr(IteratorT begin, IteratorT end, ConverterT converter = [](const auto& item) { return std::to_string(item); });
+    template <typename IteratorT, typename ConverterT>
+    std::string iterableToStr(IteratorT begin, IteratorT end, ConverterT converter);
+    // numbers, written as std::to_string would
+    template <typename IteratorT>
+    std::string iterableToStr(IteratorT begin, IteratorT end);
 
 };
 
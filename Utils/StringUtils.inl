@@ -1,6 +1,9 @@
 #ifndef STRING_UTILS_INL
 #define STRING_UTILS_INL
 
+#include <charconv>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <type_traits>
@@ -8,25 +11,149 @@
 #include <functional>
 
 #include "StringUtils.hpp"
+#include "utils.hpp"
 
 namespace string_utils_ns {
+    // # StringWriter
+
+    inline void StringWriter::helperAppendRaw(const char* text, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        helperReserveExtra(count);
+        std::memcpy(data_ptr + length, text, count);
+        length += count;
+    }
+
+    inline void StringWriter::helperAppendIndent() {
+        helperReserveExtra(indent_num);
+        std::memset(data_ptr + length, indent_char, indent_num);
+        length += indent_num;
+    }
+
+    inline StringWriter& StringWriter::append(std::string_view text) {
+        if (indent_num == 0) {
+            helperAppendRaw(text.data(), text.size());
+            return *this;
+        }
+        const char* rest = text.data();
+        size_t rest_size = text.size();
+        while (rest_size > 0) {
+            const char* newline = static_cast<const char*>(std::memchr(rest, '\n', rest_size));
+            if (newline == nullptr) {
+                helperAppendRaw(rest, rest_size);
+                break;
+            }
+            const size_t line_size = static_cast<size_t>(newline - rest) + 1;
+            helperAppendRaw(rest, line_size);
+            helperAppendIndent();
+            rest += line_size;
+            rest_size -= line_size;
+        }
+        return *this;
+    }
+
+    inline StringWriter& StringWriter::append(char c) {
+        helperReserveExtra(1);
+        data_ptr[length++] = c;
+        if (c == '\n' && indent_num > 0) {
+            helperAppendIndent();
+        }
+        return *this;
+    }
+
+    inline StringWriter& StringWriter::append(size_t count, char c) {
+        if (c == '\n' && indent_num > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                append(c);
+            }
+            return *this;
+        }
+        helperReserveExtra(count);
+        std::memset(data_ptr + length, c, count);
+        length += count;
+        return *this;
+    }
+
+    template <typename NumberT, std::enable_if_t<std::is_arithmetic_v<NumberT>, int>>
+    inline StringWriter& StringWriter::appendNumber(NumberT value) {
+        if constexpr (std::is_same_v<NumberT, bool>) {
+            return append(value ? '1' : '0');
+        } else if constexpr (std::is_integral_v<NumberT>) {
+            char buffer[24];
+            const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            helperAppendRaw(buffer, static_cast<size_t>(result.ptr - buffer));
+            return *this;
+        } else {
+            // "%f" of the largest double is 316 chars
+            char buffer[400];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            const std::to_chars_result result = std::to_chars(
+                buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+            helperAppendRaw(buffer, static_cast<size_t>(result.ptr - buffer));
+#else
+            const int num_of_chars = std::snprintf(buffer, sizeof(buffer), "%f", static_cast<double>(value));
+            helperAppendRaw(buffer, (num_of_chars > 0) ? static_cast<size_t>(num_of_chars) : 0);
+#endif
+            return *this;
+        }
+    }
+
+    inline void StringWriter::setIndent(size_t new_indent_num, char new_indent_char) {
+        indent_num = new_indent_num;
+        indent_char = new_indent_char;
+        if (indent_num > 0 && helperIsLineStart()) {
+            helperAppendIndent();
+        }
+    }
+
+    inline void StringWriter::clear() noexcept {
+        length = 0;
+        indent_num = 0;
+    }
+
+    inline void add_indent(
+        StringWriter& out,
+        std::string_view txt,
+        size_t indent_num,
+        bool add_in_first_line_too,
+        char indent_char
+    ) {
+        if (add_in_first_line_too) {
+            out.append(indent_num, indent_char);
+        }
+        size_t line_begin = 0;
+        for (size_t newline = txt.find('\n'); newline != std::string_view::npos; newline = txt.find('\n', line_begin)) {
+            out.append(txt.substr(line_begin, newline + 1 - line_begin));
+            out.append(indent_num, indent_char);
+            line_begin = newline + 1;
+        }
+        out.append(txt.substr(line_begin));
+    }
+
     inline std::string add_indent(
         std::string_view txt, 
         const size_t& indent_num, 
         bool add_in_first_line_too,
         char indent_char
     ) {
-        std::string indent_string (indent_num, indent_char);
-        std::string result = 
-            add_in_first_line_too 
-            ? indent_string 
-            : "";
-        for (char c : txt) {
-            result += c;
-            if (c == '\n') {
-                result += indent_string;
-            }
+        size_t num_of_lines = 1;
+        for (const char* it = txt.data(), *end = txt.data() + txt.size();
+            (it = static_cast<const char*>(std::memchr(it, '\n', static_cast<size_t>(end - it)))) != nullptr; ++it) {
+            ++num_of_lines;
+        }
+        std::string result;
+        result.reserve(txt.size() + num_of_lines * indent_num);
+        if (add_in_first_line_too) {
+            result.append(indent_num, indent_char);
         }
+        size_t line_begin = 0;
+        for (size_t newline = txt.find('\n'); newline != std::string_view::npos; newline = txt.find('\n', line_begin)) {
+            result.append(txt, line_begin, newline + 1 - line_begin);
+            result.append(indent_num, indent_char);
+            line_begin = newline + 1;
+        }
+        result.append(txt, line_begin, std::string_view::npos);
         return result;
     }
 
@@ -88,20 +215,37 @@ namespace string_utils_ns {
         }
     }
 
+    template <typename T, typename = void>
+    struct HasWriteTo : std::false_type {};
+    template <typename T>
+    struct HasWriteTo<T, std::void_t<decltype(std::declval<const T&>().write_to(std::declval<StringWriter&>(), false))>>
+        : std::true_type {};
+
     template <typename T>
     inline std::string to_string(const std::vector<T>& vect, bool with_prefix) {
-        std::string return_str = ((with_prefix)? ("vector<"+get_class_name<T>()+">[") : ("[")); 
+        StringWriter writer;
+        if (with_prefix) {
+            writer << "vector<" << Utils::get_class_name<T>() << ">[";
+        } else {
+            writer << '[';
+        }
         if (vect.empty()) {
-            return return_str+"-empty-]";
+            writer << "-empty-]";
+            return writer.str();
         }
         try {
             for (size_t i = 0; i < vect.size(); ++i) {
-                return_str += vect[i].to_string(false) + ((i == vect.size()-1)? "]" : ", ");
+                if constexpr (HasWriteTo<T>::value) {
+                    vect[i].write_to(writer, false);
+                } else {
+                    writer << vect[i].to_string(false);
+                }
+                writer << ((i == vect.size()-1)? "]" : ", ");
             }
         } catch (const std::exception& e) {
-            throw std::runtime_error(msg);
+            throw std::runtime_error(std::string("string_utils_ns::to_string(const std::vector<T>&): ") + e.what());
         }
-        return return_str;
+        return writer.str();
     }
     
     template <typename PtrT>
@@ -114,16 +258,31 @@ namespace string_utils_ns {
     template <typename IteratorT, typename ConverterT>
     std::string iterableToStr(IteratorT begin, IteratorT end, ConverterT converter) {
         if (begin == end) return "[ ]\n";
-        std::ostringstream oss;
-        oss << "[ ";
+        StringWriter writer;
+        writer << "[ ";
+        for (IteratorT it = begin; it != end; ++it) {
+            writer << converter(*it);
+            if (std::next(it) != end) {
+                writer << ", ";
+            }
+        }
+        writer << " ]\n";
+        return writer.str();
+    }
+
+    template <typename IteratorT>
+    std::string iterableToStr(IteratorT begin, IteratorT end) {
+        if (begin == end) return "[ ]\n";
+        StringWriter writer;
+        writer << "[ ";
         for (IteratorT it = begin; it != end; ++it) {
-            oss << converter(*it);
+            writer.appendNumber(*it);
             if (std::next(it) != end) {
-                oss << ", ";
+                writer << ", ";
             }
         }
-        oss << " ]\n";
-        return oss.str();
+        writer << " ]\n";
+        return writer.str();
     }
 }
     
@@ -1,7 +1,9 @@
 #include "utils.hpp"
 
+#include <cstdio>
 #include <ctime>
 #include <chrono>
+#include <stdexcept>
 #include <tuple>
 // #include "Logger.hpp"
 
@@ -51,27 +53,29 @@ std::tm Utils::Time::get_current_time() {
     return local_time;
 }
 
-std::array<int, 3> Utils::Time::get_current_hour_min_sec() {
-    std::time_t now = std::time(nullptr);
-    std::tm local_time;
-    #ifdef _MSC_VER
-        localtime_s(&local_time, &now);
-    #else
-        local_time = *std::localtime(&now);
-    #endif
-    return {
-        local_time.tm_hour, 
-        local_time.tm_min, 
-        local_time.tm_sec
-    };
-}
-
-unsigned int Utils::Time::time_minus_get_seconds(std::array<int, 3> subtrahend, std::array<int, 3> minuend) {
-    int hour_diff = subtrahend[0] - minuend[0];
-    int min_diff = subtrahend[1] - minuend[1];
-    int sec_diff = subtrahend[2] - minuend[2];
-    
-    return hour_diff * 3600 + min_diff * 60 + sec_diff;
+std::string Utils::Time::format_duration(Clock::duration d) {
+    const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    const char* sign = (ns < 0) ? "-" : "";
+    const uint64_t abs_ns = (ns < 0) ? 0 - static_cast<uint64_t>(ns) : static_cast<uint64_t>(ns);
+    char buffer[48];
+    if (abs_ns < 1000ULL) {
+        std::snprintf(buffer, sizeof(buffer), "%s%lluns", sign, static_cast<unsigned long long>(abs_ns));
+    } else if (abs_ns < 1000000ULL) {
+        std::snprintf(buffer, sizeof(buffer), "%s%.1fus", sign, static_cast<double>(abs_ns) / 1e3);
+    } else if (abs_ns < 1000000000ULL) {
+        std::snprintf(buffer, sizeof(buffer), "%s%.1fms", sign, static_cast<double>(abs_ns) / 1e6);
+    } else if (abs_ns < 60000000000ULL) {
+        std::snprintf(buffer, sizeof(buffer), "%s%.2fs", sign, static_cast<double>(abs_ns) / 1e9);
+    } else if (abs_ns < 3600000000000ULL) {
+        const unsigned long long tenths_s = abs_ns / 100000000ULL; // cut, not rounded up to "60.0s"
+        std::snprintf(buffer, sizeof(buffer), "%s%llum %02llu.%llus",
+            sign, tenths_s / 600, (tenths_s / 10) % 60, tenths_s % 10);
+    } else {
+        const unsigned long long total_s = abs_ns / 1000000000ULL;
+        std::snprintf(buffer, sizeof(buffer), "%s%lluh %02llum %02llus",
+            sign, total_s / 3600, (total_s / 60) % 60, total_s % 60);
+    }
+    return buffer;
 }
 
 
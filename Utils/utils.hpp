@@ -1,11 +1,17 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include <thread>
 #include <chrono>
+#include <ctime>
 #include <typeinfo>
 #include <tuple>
 #include <array>
@@ -24,37 +30,259 @@ namespace Utils {
         bool is_int_in_range(const size_t num, const size_t upper_lim, const size_t lower_lim);
     }
     namespace Vector {
+        namespace helpers {
+            template <typename T, typename = void>
+            struct is_hashable : std::false_type {};
+            template <typename T>
+            struct is_hashable<T, std::void_t<decltype(std::hash<T>()(std::declval<const T&>()))>> : std::true_type {};
+
+            template <typename T, typename = void>
+            struct is_less_comparable : std::false_type {};
+            template <typename T>
+            struct is_less_comparable<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>> : std::true_type {};
+
+            // splitmix64 finalizer, spreads weak hashes (e.g. std::hash<int> is the identity) over all bits
+            inline uint64_t mix(uint64_t x) noexcept {
+                x += 0x9e3779b97f4a7c15ULL;
+                x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+                return x ^ (x >> 31);
+            }
+
+            // keys of MultisetFingerprint, fixed for the process so that its fingerprints stay comparable,
+            // but not known in advance, so no input can be crafted to cancel out
+            inline const std::array<uint64_t, 2>& fingerprint_keys() noexcept {
+                static const std::array<uint64_t, 2> keys = []() noexcept {
+                    static const char address_entropy = 0;
+                    const uint64_t seed = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+                        ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&address_entropy));
+                    return std::array<uint64_t, 2>{mix(seed), mix(seed ^ 0x5851f42d4c957f2dULL)};
+                }();
+                return keys;
+            }
+        }
+
+        // O(n): counts the elements of vect_1 and takes vect_2 off them, needs std::hash<T>
         template <typename T>
-        static bool have_same_elements(const std::vector<T>& vect_1, const std::vector<T>& vect_2, bool hashable = false) {
+        static bool have_same_elements_by_hash(const std::vector<T>& vect_1, const std::vector<T>& vect_2) {
             if (vect_1.size() != vect_2.size()) {
                 return false;
             }
-            std::vector<T> vect_2_copy(vect_2);
-            for (const T& vect_1_elem : vect_1) {
-                auto it = std::find(vect_2_copy.begin(), vect_2_copy.end(), vect_1_elem);
-                if (it == vect_2_copy.end()) {
+            std::unordered_map<T, size_t> counts;
+            counts.reserve(vect_1.size());
+            for (const T& elem : vect_1) {
+                ++counts[elem];
+            }
+            for (const T& elem : vect_2) {
+                auto found = counts.find(elem);
+                if (found == counts.end() || found->second == 0) {
                     return false;
-                } else {
-                    vect_2_copy.erase(it);
                 }
+                --found->second;
             }
             return true;
         }
 
+        // O(n log n): sorts copies of both, comp must be a strict weak ordering
+        // (not Pos2D::operator<, which compares x and y separately)
+        template <typename T, typename CompareT = std::less<T>>
+        static bool have_same_elements_by_sort(const std::vector<T>& vect_1, const std::vector<T>& vect_2, CompareT comp = CompareT()) {
+            if (vect_1.size() != vect_2.size()) {
+                return false;
+            }
+            std::vector<T> sorted_1(vect_1);
+            std::vector<T> sorted_2(vect_2);
+            std::sort(sorted_1.begin(), sorted_1.end(), comp);
+            std::sort(sorted_2.begin(), sorted_2.end(), comp);
+            return sorted_1 == sorted_2;
+        }
+
+        // same elements, same number of times each, in any order
+        // by hash if T has std::hash, else by sort if it has operator<, else O(n^2) find + erase
+        template <typename T>
+        static bool have_same_elements(const std::vector<T>& vect_1, const std::vector<T>& vect_2) {
+            if (vect_1.size() != vect_2.size()) {
+                return false;
+            }
+            if constexpr (helpers::is_hashable<T>::value) {
+                return have_same_elements_by_hash(vect_1, vect_2);
+            } else if constexpr (helpers::is_less_comparable<T>::value) {
+                return have_same_elements_by_sort(vect_1, vect_2);
+            } else {
+                std::vector<T> vect_2_copy(vect_2);
+                for (const T& vect_1_elem : vect_1) {
+                    auto it = std::find(vect_2_copy.begin(), vect_2_copy.end(), vect_1_elem);
+                    if (it == vect_2_copy.end()) {
+                        return false;
+                    } else {
+                        vect_2_copy.erase(it);
+                    }
+                }
+                return true;
+            }
+        }
+
+        /*
+        order independent fingerprint of a multiset, kept up to date with add/remove in O(1)
+          - two multisets with the same elements always have equal fingerprints, so a mismatch is certain
+          - each element adds two 64-bit mixes of its hash under keys picked once per process,
+            so when std::hash<T> is injective over the values in use (e.g. Pos2D with a 64-bit size_t),
+            different multisets only match if both 64-bit sums cancel at once, a match can be trusted
+          - if std::hash<T> collides, elements with the same hash are indistinguishable,
+            confirm a match with have_same_elements then
+          - needs std::hash<T>
+        */
+        template <typename T>
+        class MultisetFingerprint {
+        public:
+            MultisetFingerprint() = default;
+            explicit MultisetFingerprint(const std::vector<T>& elems) {
+                for (const T& elem : elems) {
+                    add(elem);
+                }
+            }
+
+            void add(const T& elem) noexcept {
+                const uint64_t h = static_cast<uint64_t>(std::hash<T>()(elem));
+                sum_1 += helpers::mix(h ^ helpers::fingerprint_keys()[0]);
+                sum_2 += helpers::mix(helpers::mix(h) ^ helpers::fingerprint_keys()[1]);
+                ++count;
+            }
+            void remove(const T& elem) noexcept {
+                const uint64_t h = static_cast<uint64_t>(std::hash<T>()(elem));
+                sum_1 -= helpers::mix(h ^ helpers::fingerprint_keys()[0]);
+                sum_2 -= helpers::mix(helpers::mix(h) ^ helpers::fingerprint_keys()[1]);
+                --count;
+            }
+            void clear() noexcept {
+                sum_1 = 0;
+                sum_2 = 0;
+                count = 0;
+            }
+            size_t size() const noexcept {
+                return count;
+            }
+
+            bool operator==(const MultisetFingerprint& other) const noexcept {
+                return sum_1 == other.sum_1 && sum_2 == other.sum_2 && count == other.count;
+            }
+            bool operator!=(const MultisetFingerprint& other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            uint64_t sum_1 = 0; // unsigned, wraps around
+            uint64_t sum_2 = 0;
+            size_t count = 0;
+        };
+
     }
     namespace Time {
+        // monotonic: never jumps with the wall clock, for elapsed times and timeouts
+        using Clock = std::chrono::steady_clock;
+
+        inline Clock::time_point now() noexcept {
+            return Clock::now();
+        }
+        inline int64_t now_ns() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        }
+        inline double to_seconds(Clock::duration d) noexcept {
+            return std::chrono::duration<double>(d).count();
+        }
+        inline int64_t to_micros(Clock::duration d) noexcept {
+            return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        }
+
+        // e.g. "850ns", "12.3us", "16.7ms", "4.25s", "3m 07.5s", "1h 02m 03s"
+        std::string format_duration(Clock::duration d);
+
+        // time counted only while running, pause and resume keep what was counted so far
+        class Stopwatch {
+        public:
+            explicit Stopwatch(bool start_running = false) noexcept {
+                if (start_running) {
+                    start();
+                }
+            }
+
+            // from zero, running
+            void start() noexcept {
+                accumulated = Clock::duration::zero();
+                started_at = Clock::now();
+                running = true;
+            }
+            // does nothing if already paused
+            void pause() noexcept {
+                if (running) {
+                    accumulated += Clock::now() - started_at;
+                    running = false;
+                }
+            }
+            // does nothing if already running
+            void resume() noexcept {
+                if (!running) {
+                    started_at = Clock::now();
+                    running = true;
+                }
+            }
+            // zero, paused
+            void reset() noexcept {
+                accumulated = Clock::duration::zero();
+                running = false;
+            }
+
+            bool is_running() const noexcept {
+                return running;
+            }
+            Clock::duration elapsed() const noexcept {
+                return (running) ? accumulated + (Clock::now() - started_at) : accumulated;
+            }
+            double elapsed_s() const noexcept {
+                return to_seconds(elapsed());
+            }
+            int64_t elapsed_us() const noexcept {
+                return to_micros(elapsed());
+            }
+
+        private:
+            Clock::duration accumulated = Clock::duration::zero();
+            Clock::time_point started_at {};
+            bool running = false;
+        };
+
+        // calls on_end(duration) when the scope ends, e.g.
+        //   Utils::Time::ScopedTimer timer([](Utils::Time::Clock::duration d) { histogram.observe(...); });
+        template <typename OnEndT>
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(OnEndT arg_on_end) noexcept(std::is_nothrow_move_constructible_v<OnEndT>)
+                : on_end(std::move(arg_on_end)), started_at(Clock::now()) {}
+            ~ScopedTimer() {
+                on_end(Clock::now() - started_at);
+            }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            Clock::duration elapsed() const noexcept {
+                return Clock::now() - started_at;
+            }
+
+        private:
+            OnEndT on_end;
+            Clock::time_point started_at;
+        };
+
         void delay_for_time_in_ms(const size_t& t_in_ms);
+        // wall clock, local time zone: for showing the time of day, not for measuring
         std::tm get_current_time();
-        std::array<int, 3> get_current_hour_min_sec();
-        unsigned int time_minus_get_seconds(std::array<int, 3> start, std::array<int, 3> end);
 
         template<typename Callable, typename... Args>
         long long duration_used_in_function(Callable func, Args&&... args) {
-            auto start_time = std::chrono::high_resolution_clock::now();
+            const Clock::time_point start_time = Clock::now();
             func(std::forward<Args>(args)...);
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-            return duration.count();
+            return to_micros(Clock::now() - start_time);
         }
     }
     void clear_terminal();